@@ -4,6 +4,10 @@
 
 #include <cassert>
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <ranges>
 #include <stdexcept>
 #include <vector>
 #include <concepts>
@@ -26,17 +30,24 @@ namespace wcr {
         }
     };
 
+    /**
+     * @brief Pool of free ids stored as ordered, non adjacent intervals.
+     * Generate, release and extract are O(log n) on the number of intervals.
+     */
     template<std::integral T=std::size_t>
     class IdPool {
     public:
+
+        using RangesType = std::map<T, T>;  // first -> last
     
         IdPool() = default;
 
         IdPool(std::vector<IdRange<T>> const & in_ranges) :
-            free_ranges_(in_ranges) {}
-
-        IdPool(std::vector<IdRange<T>> && in_ranges) :
-            free_ranges_(std::move(in_ranges)) {}
+            free_ranges_() {
+            for (auto const & r : in_ranges) {
+                AddRangeToPool(r.first, r.last);
+            }
+        }
 
         IdPool(const IdPool&) = default;
         IdPool(IdPool&&) noexcept = default;
@@ -50,72 +61,118 @@ namespace wcr {
                     "Ges Id Pool is empty, no more DTId's can be generated!"
                     );
             }
-        
-            auto& front = free_ranges_.front();
-            auto result = front.first++;
-            if (front.first > front.last) {
+
+            auto front = free_ranges_.begin();
+            T result = front->first;
+
+            if (front->first == front->second) {
                 // Range exhausted
-                free_ranges_.erase(free_ranges_.begin());
+                free_ranges_.erase(front);
+            }
+            else {
+                auto node = free_ranges_.extract(front);
+                node.key()++;
+                free_ranges_.insert(free_ranges_.begin(), std::move(node));
             }
+
             return result;
         }
 
-        void ExtractFromPool(T id)
-            {
-                std::vector<IdRange<T>> splitted{};
-                // splitted.reserve(free_ranges_.max_size());
+        /**
+         * @brief Remove id from the free ids, if it is free.
+         */
+        void ExtractFromPool(T id) {
+            auto it = FindRange(id);
 
-                bool extracted{false};
-    
-                for (auto const & r : free_ranges_) {
-                    if (r.InRange(id)) {
-                        extracted = true;
-                
-                        IdRange<T> before = {r.first, id-1};
-                        IdRange<T> after = {id+1, r.last};
-                        if (before.IsValid()) {
-                            splitted.push_back(r);
-                        }
-                        if (after.IsValid()) {
-                            splitted.push_back(r);
-                        }
-                    }
-                    else {
-                        splitted.push_back(r);
-                    }
-                }
+            if (it == free_ranges_.end()) {
+                return;
+            }
 
-                if (extracted) {
-                    free_ranges_ = std::move(splitted);
-                }
+            T first = it->first;
+            T last = it->second;
+
+            free_ranges_.erase(it);
+
+            if (first < id) {
+                free_ranges_.emplace(first, id - 1);
+            }
+            if (id < last) {
+                free_ranges_.emplace(id + 1, last);
             }
+        }
 
         /**
-         * @biref Makes id avaiable.
+         * @brief Makes id avaiable.
          */
         void AddToPool(T id) {
+            AddRangeToPool(id, id);
+        }
+
+        /**
+         * @brief Makes [in_first, in_last] ids avaiable.
+         */
+        void AddRangeToPool(T in_first, T in_last) {
+            assert(in_first <= in_last);
+
+            // First range that could overlap or be adjacent to [in_first, in_last].
+            auto it = free_ranges_.upper_bound(in_first);
+            if (it != free_ranges_.begin()) {
+                auto prev = std::prev(it);
+                if (prev->second >= in_first ||
+                    prev->second + 1 == in_first) {
+                    it = prev;
+                }
+            }
+
+            while (it != free_ranges_.end() &&
+                   (it->first <= in_last || it->first == in_last + 1)) {
+                in_first = std::min(in_first, it->first);
+                in_last = std::max(in_last, it->second);
+                it = free_ranges_.erase(it);
+            }
 
-            free_ranges_.push_back({id, id});
-
-            std::sort(free_ranges_.begin(), free_ranges_.end(),
-                      [](const IdRange<T>& a, const IdRange<T>& b) {
-                          return a.first < b.first;
-                      });
-
-            std::vector<IdRange<T>> merged;
-            for (auto const & r : free_ranges_) {
-                if (merged.empty()) {
-                    merged.push_back(r);
-                } else {
-                    auto& last = merged.back();
-                    if (r.first <= last.last + 1) {
-                        last.last = std::max(last.last, r.last);
-                    } else {
-                        merged.push_back(r);
-                    }
+            free_ranges_.emplace_hint(it, in_first, in_last);
+        }
+
+        /**
+         * @brief Makes all in_ids avaiable.
+         * Consecutive ids are coalesced, each run is added with a single AddRangeToPool.
+         */
+        template<std::ranges::input_range R>
+            requires std::convertible_to<std::ranges::range_value_t<R>, T>
+        void ReleaseMany(R && in_ids) {
+            std::vector<T> ids(std::ranges::begin(in_ids), std::ranges::end(in_ids));
+
+            if (ids.empty()) return;
+
+            std::sort(ids.begin(), ids.end());
+
+            T first = ids[0];
+            T last = ids[0];
+
+            for (std::size_t i=1; i < ids.size(); i++) {
+                if (ids[i] <= last + 1) {
+                    last = std::max(last, ids[i]);
+                }
+                else {
+                    AddRangeToPool(first, last);
+                    first = last = ids[i];
                 }
             }
-            free_ranges_ = std::move(merged);
+
+            AddRangeToPool(first, last);
+        }
+
+        WNODISCARD bool IsFree(T id) const {
+            return FindRange(id) != free_ranges_.end();
+        }
+
+        WNODISCARD bool Empty() const noexcept {
+            return free_ranges_.empty();
+        }
+
+        WNODISCARD std::size_t RangeCount() const noexcept {
+            return free_ranges_.size();
         }
 
         void Clear() {
@@ -123,8 +180,30 @@ namespace wcr {
         }
    
     private:
+
+        auto FindRange(T id) const {
+            auto it = free_ranges_.upper_bound(id);
+
+            if (it == free_ranges_.begin()) {
+                return free_ranges_.end();
+            }
+
+            --it;
+            return it->second >= id ? it : free_ranges_.end();
+        }
+
+        auto FindRange(T id) {
+            auto it = free_ranges_.upper_bound(id);
+
+            if (it == free_ranges_.begin()) {
+                return free_ranges_.end();
+            }
+
+            --it;
+            return it->second >= id ? it : free_ranges_.end();
+        }
     
-        std::vector<IdRange<T>> free_ranges_ { IdRange<T>{} };
+        RangesType free_ranges_ { {IdRange<T>{}.first, IdRange<T>{}.last} };
     
     };
 
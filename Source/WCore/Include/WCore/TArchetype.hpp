@@ -0,0 +1,372 @@
+#pragma once
+
+#include "WCore/WCore.hpp"
+#include "WCore/WConcepts.hpp"
+#include "WCore/TStridedView.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Type erased column of an archetype.
+ * Row i of every column belongs to the same object.
+ */
+template<typename B=void>
+class IArchetypeColumn {
+public:
+    virtual ~IArchetypeColumn()=default;
+
+    virtual std::unique_ptr<IArchetypeColumn> Clone() const=0;
+
+    /**
+     * @brief Column of the same type without elements.
+     */
+    virtual std::unique_ptr<IArchetypeColumn> CloneEmpty() const=0;
+
+    virtual void PushDefault()=0;
+
+    /**
+     * @brief Move the element at in_row of in_other to the back of this column.
+     * in_other must be a column of the same type.
+     */
+    virtual void PushFrom(IArchetypeColumn & in_other, std::size_t in_row)=0;
+
+    /**
+     * @brief Remove in_row, the last element is moved into its place.
+     */
+    virtual void SwapRemove(std::size_t in_row)=0;
+
+    virtual void Clear()=0;
+    virtual void Reserve(std::size_t in_value)=0;
+    virtual std::size_t Count() const=0;
+
+    virtual B * BGet(std::size_t in_row)=0;
+    virtual const B * BGet(std::size_t in_row) const=0;
+
+    /**
+     * @brief All the rows, walking them doesn't need virtual calls.
+     */
+    virtual TStridedView<B> BView()=0;
+};
+
+/**
+ * @brief Contiguous column of T values.
+ */
+template<typename T, CConvertibleTo<T> B=void>
+class TArchetypeColumn : public IArchetypeColumn<B> {
+public:
+
+    using Super = IArchetypeColumn<B>;
+
+public:
+
+    constexpr TArchetypeColumn() noexcept = default;
+    ~TArchetypeColumn() override = default;
+    TArchetypeColumn(const TArchetypeColumn &) = default;
+    TArchetypeColumn(TArchetypeColumn &&) noexcept = default;
+    TArchetypeColumn & operator=(const TArchetypeColumn &) = default;
+    TArchetypeColumn & operator=(TArchetypeColumn &&) noexcept = default;
+
+    std::unique_ptr<Super> Clone() const override {
+        return std::make_unique<TArchetypeColumn>(*this);
+    }
+
+    std::unique_ptr<Super> CloneEmpty() const override {
+        return std::make_unique<TArchetypeColumn>();
+    }
+
+    void PushDefault() override {
+        values_.emplace_back();
+    }
+
+    void PushFrom(Super & in_other, std::size_t in_row) override {
+        values_.push_back(
+            std::move(static_cast<TArchetypeColumn&>(in_other).values_[in_row])
+            );
+    }
+
+    void SwapRemove(std::size_t in_row) override {
+        if (in_row != values_.size() - 1) {
+            values_[in_row] = std::move(values_.back());
+        }
+        values_.pop_back();
+    }
+
+    void Clear() override {
+        values_.clear();
+    }
+
+    void Reserve(std::size_t in_value) override {
+        values_.reserve(in_value);
+    }
+
+    std::size_t Count() const override {
+        return values_.size();
+    }
+
+    B * BGet(std::size_t in_row) override {
+        return static_cast<B*>(&values_[in_row]);
+    }
+
+    const B * BGet(std::size_t in_row) const override {
+        return static_cast<const B*>(&values_[in_row]);
+    }
+
+    TStridedView<B> BView() override {
+        return TStridedView<B>(
+            static_cast<B*>(values_.data()), sizeof(T), values_.size()
+            );
+    }
+
+    HOT T & Get(std::size_t in_row) {
+        return values_[in_row];
+    }
+
+    HOT const T & Get(std::size_t in_row) const {
+        return values_[in_row];
+    }
+
+    T * Data() noexcept {
+        return values_.data();
+    }
+
+    const T * Data() const noexcept {
+        return values_.data();
+    }
+
+    auto begin() noexcept { return values_.begin(); }
+    auto end() noexcept { return values_.end(); }
+    auto begin() const noexcept { return values_.cbegin(); }
+    auto end() const noexcept { return values_.cend(); }
+
+private:
+
+    std::vector<T> values_{};
+
+};
+
+/**
+ * @brief Table of objects that share the same set of column keys (signature).
+ * Columns are sorted by key, rows are packed, removing a row moves the last one into it.
+ * Add/Remove edges cache the archetype reached when a key is added or removed,
+ * edges are indexes into the owner archetype container.
+ */
+template<typename K, typename B=void, std::integral IdBase=std::uint64_t>
+class TArchetype {
+public:
+
+    using ColumnType = IArchetypeColumn<B>;
+
+    template<typename T>
+    using TColumnType = TArchetypeColumn<T, B>;
+
+    static constexpr std::size_t NONE{ std::numeric_limits<std::size_t>::max() };
+
+public:
+
+    TArchetype() = default;
+
+    ~TArchetype() = default;
+
+    TArchetype(const TArchetype & other) :
+        signature_(other.signature_),
+        columns_(),
+        ids_(other.ids_),
+        add_edges_(other.add_edges_),
+        remove_edges_(other.remove_edges_) {
+        CopyColumnsFrom(other);
+    }
+
+    TArchetype(TArchetype && other) noexcept = default;
+
+    TArchetype & operator=(const TArchetype & other) {
+        if (this != &other) {
+            signature_ = other.signature_;
+            ids_ = other.ids_;
+            add_edges_ = other.add_edges_;
+            remove_edges_ = other.remove_edges_;
+            CopyColumnsFrom(other);
+        }
+
+        return *this;
+    }
+
+    TArchetype & operator=(TArchetype && other) noexcept = default;
+
+public:
+
+    /**
+     * @brief Add a column for in_key keeping the signature sorted.
+     * Only valid while the archetype has no rows.
+     */
+    void AddColumn(const K & in_key, std::unique_ptr<ColumnType> && in_column) {
+        assert(ids_.empty());
+        assert(ColumnIndex(in_key) == NONE);
+
+        auto it = std::lower_bound(signature_.begin(), signature_.end(), in_key, std::less<K>{});
+        auto pos = std::distance(signature_.begin(), it);
+
+        signature_.insert(it, in_key);
+        columns_.insert(columns_.begin() + pos, std::move(in_column));
+    }
+
+    WNODISCARD const std::vector<K> & Signature() const noexcept {
+        return signature_;
+    }
+
+    WNODISCARD std::size_t ColumnCount() const noexcept {
+        return columns_.size();
+    }
+
+    WNODISCARD std::size_t ColumnIndex(const K & in_key) const noexcept {
+        auto it = std::lower_bound(signature_.begin(), signature_.end(), in_key, std::less<K>{});
+
+        if (it == signature_.end() || *it != in_key) {
+            return NONE;
+        }
+
+        return std::distance(signature_.begin(), it);
+    }
+
+    WNODISCARD bool Contains(const K & in_key) const noexcept {
+        return ColumnIndex(in_key) != NONE;
+    }
+
+    ColumnType & Column(std::size_t in_column) const {
+        return *columns_[in_column];
+    }
+
+    template<typename T>
+    TColumnType<T> & Column(std::size_t in_column) const {
+        return static_cast<TColumnType<T>&>(*columns_[in_column]);
+    }
+
+    WNODISCARD std::size_t Count() const noexcept {
+        return ids_.size();
+    }
+
+    WNODISCARD const IdBase & IdAt(std::size_t in_row) const {
+        return ids_[in_row];
+    }
+
+    WNODISCARD const std::vector<IdBase> & Ids() const noexcept {
+        return ids_;
+    }
+
+    /**
+     * @brief Append a row with default values for in_id, returns the row.
+     */
+    std::size_t PushRow(const IdBase & in_id) {
+        ids_.push_back(in_id);
+        for (auto & c : columns_) {
+            c->PushDefault();
+        }
+
+        return ids_.size() - 1;
+    }
+
+    /**
+     * @brief Move in_row into in_dst, shared columns are moved,
+     * columns only present in in_dst are default constructed.
+     * The source row is left in place, call SwapRemove after.
+     * Returns the row in in_dst.
+     */
+    std::size_t MoveRowTo(std::size_t in_row, TArchetype & in_dst) {
+        std::size_t s=0;
+        for (std::size_t d=0; d < in_dst.signature_.size(); d++) {
+            while (s < signature_.size() && std::less<K>{}(signature_[s], in_dst.signature_[d])) {
+                s++;
+            }
+
+            if (s < signature_.size() && signature_[s] == in_dst.signature_[d]) {
+                in_dst.columns_[d]->PushFrom(*columns_[s], in_row);
+            }
+            else {
+                in_dst.columns_[d]->PushDefault();
+            }
+        }
+
+        in_dst.ids_.push_back(ids_[in_row]);
+
+        return in_dst.ids_.size() - 1;
+    }
+
+    /**
+     * @brief Remove in_row from all the columns.
+     * Returns true if other row was moved into in_row, out_moved_id is its id.
+     */
+    bool SwapRemove(std::size_t in_row, IdBase & out_moved_id) {
+        for (auto & c : columns_) {
+            c->SwapRemove(in_row);
+        }
+
+        bool moved = in_row != ids_.size() - 1;
+        if (moved) {
+            ids_[in_row] = ids_.back();
+            out_moved_id = ids_[in_row];
+        }
+
+        ids_.pop_back();
+
+        return moved;
+    }
+
+    void Clear() {
+        for (auto & c : columns_) {
+            c->Clear();
+        }
+        ids_.clear();
+    }
+
+    void Reserve(std::size_t in_value) {
+        for (auto & c : columns_) {
+            c->Reserve(in_value);
+        }
+        ids_.reserve(in_value);
+    }
+
+    WNODISCARD std::size_t AddEdge(const K & in_key) const {
+        auto it = add_edges_.find(in_key);
+        return it != add_edges_.end() ? it->second : NONE;
+    }
+
+    WNODISCARD std::size_t RemoveEdge(const K & in_key) const {
+        auto it = remove_edges_.find(in_key);
+        return it != remove_edges_.end() ? it->second : NONE;
+    }
+
+    void SetAddEdge(const K & in_key, std::size_t in_archetype) {
+        add_edges_[in_key] = in_archetype;
+    }
+
+    void SetRemoveEdge(const K & in_key, std::size_t in_archetype) {
+        remove_edges_[in_key] = in_archetype;
+    }
+
+private:
+
+    void CopyColumnsFrom(const TArchetype & other) {
+        columns_.clear();
+        columns_.reserve(other.columns_.size());
+        for (auto & c : other.columns_) {
+            columns_.push_back(c->Clone());
+        }
+    }
+
+    std::vector<K> signature_{};
+
+    std::vector<std::unique_ptr<ColumnType>> columns_{};
+
+    std::vector<IdBase> ids_{};
+
+    std::unordered_map<K, std::size_t> add_edges_{};
+
+    std::unordered_map<K, std::size_t> remove_edges_{};
+
+};
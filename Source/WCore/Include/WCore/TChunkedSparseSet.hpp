@@ -0,0 +1,370 @@
+#pragma once
+
+#include "WCore/WConcepts.hpp"
+#include "WCore/WCore.hpp"
+#include "WCore/TIterator.hpp"
+#include "WCore/TSparseIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+/**
+ * @brief Sparse set with values stored in fixed-size chunks.
+ * Values are dense inside each chunk and chunks are never reallocated,
+ * so growing the set does not move existing values.
+ * Removing a value moves the last value into the removed slot (same as TSparseSet).
+ * Same interface as TSparseSet, DenseData only points to the first chunk.
+ */
+template<typename T,
+         std::size_t ChunkBytes=16384,
+         typename IndexPolicy=TSparseHashIndex>
+class TChunkedSparseSet {
+
+public:
+
+    static constexpr std::size_t CHUNK_SIZE{ std::max<std::size_t>(1, ChunkBytes / sizeof(T)) };
+
+    using IndexPosType = IndexPolicy;
+    using IndexDenseType = std::vector<std::size_t>;
+
+    template<typename ValueFn, typename IncrFn>
+    using ConstIndexIterator = TIterator<size_t,
+                                         typename IndexDenseType::const_iterator,
+                                         const size_t &,
+                                         ValueFn,
+                                         IncrFn>;
+
+    template<typename V, typename ChunkPtr>
+    class TChunkIterator {
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<V>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        constexpr TChunkIterator() noexcept = default;
+
+        constexpr TChunkIterator(ChunkPtr in_chunks, std::size_t in_pos) noexcept :
+            chunks_(in_chunks), pos_(in_pos) {}
+
+        reference operator*() const noexcept {
+            return *TChunkedSparseSet::Slot(chunks_[pos_ / CHUNK_SIZE], pos_ % CHUNK_SIZE);
+        }
+
+        pointer operator->() const noexcept {
+            return &operator*();
+        }
+
+        TChunkIterator & operator++() noexcept {
+            pos_++;
+            return *this;
+        }
+
+        TChunkIterator operator++(int) noexcept {
+            TChunkIterator r = *this;
+            pos_++;
+            return r;
+        }
+
+        bool operator==(const TChunkIterator & other) const noexcept {
+            return pos_ == other.pos_;
+        }
+
+        bool operator!=(const TChunkIterator & other) const noexcept {
+            return pos_ != other.pos_;
+        }
+
+    private:
+
+        ChunkPtr chunks_{nullptr};
+        std::size_t pos_{0};
+    };
+
+private:
+
+    struct alignas(T) SlotStorage {
+        std::byte data[sizeof(T)];
+    };
+
+    using ChunkType = std::unique_ptr<SlotStorage[]>;
+
+public:
+
+    using Iterator = TChunkIterator<T, const ChunkType *>;
+    using ConstIterator = TChunkIterator<const T, const ChunkType *>;
+
+public:
+
+    TChunkedSparseSet() noexcept = default;
+
+    virtual ~TChunkedSparseSet() {
+        DestroyValues();
+    }
+
+    TChunkedSparseSet(const TChunkedSparseSet & other) :
+        index_pos_map_(other.index_pos_map_),
+        index_dense_(other.index_dense_),
+        chunks_(),
+        count_(0) {
+        CopyValuesFrom(other);
+    }
+
+    TChunkedSparseSet(TChunkedSparseSet && other) noexcept :
+        index_pos_map_(std::move(other.index_pos_map_)),
+        index_dense_(std::move(other.index_dense_)),
+        chunks_(std::move(other.chunks_)),
+        count_(std::exchange(other.count_, 0))
+        {}
+
+    TChunkedSparseSet & operator=(const TChunkedSparseSet & other) {
+        if (this != &other) {
+            DestroyValues();
+            index_pos_map_ = other.index_pos_map_;
+            index_dense_ = other.index_dense_;
+            CopyValuesFrom(other);
+        }
+
+        return *this;
+    }
+
+    TChunkedSparseSet & operator=(TChunkedSparseSet && other) noexcept {
+        if (this != &other) {
+            DestroyValues();
+            index_pos_map_ = std::move(other.index_pos_map_);
+            index_dense_ = std::move(other.index_dense_);
+            chunks_ = std::move(other.chunks_);
+            count_ = std::exchange(other.count_, 0);
+        }
+
+        return *this;
+    }
+
+    template<std::convertible_to<T> D>
+    void Insert(const std::size_t & in_index, D && in_value) {
+        size_t pos = index_pos_map_.Find(in_index);
+        if (pos != IndexPolicy::TOMBSTONE) {
+            *At(pos) = std::forward<D>(in_value);
+        }
+        else {
+            pos = count_;
+            EnsureChunk(pos / CHUNK_SIZE);
+            new (Slot(chunks_[pos / CHUNK_SIZE], pos % CHUNK_SIZE)) T(std::forward<D>(in_value));
+            count_++;
+
+            index_pos_map_.Set(in_index, pos);
+
+            index_dense_.push_back(in_index);
+        }
+    }
+
+    T & Get(size_t in_index) {
+        return *At(index_pos_map_.At(in_index));
+    }
+
+    const T & Get(size_t in_index) const {
+        return *At(index_pos_map_.At(in_index));
+    }
+
+    std::size_t DensePosition(std::size_t in_pos) const {
+        return index_dense_[in_pos];
+    }
+
+    T * DenseData() noexcept {
+        return chunks_.empty() ? nullptr : Slot(chunks_[0], 0);
+    }
+
+    T const * DenseData() const noexcept {
+        return chunks_.empty() ? nullptr : Slot(chunks_[0], 0);
+    }
+
+    constexpr size_t Count() const noexcept {
+        return count_;
+    }
+
+    /**
+     * @brief Chunks with values, allocated but empty chunks are not counted.
+     */
+    std::size_t DenseChunkCount() const noexcept {
+        return (count_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    }
+
+    std::span<T> DenseChunk(std::size_t in_chunk) noexcept {
+        assert(in_chunk < DenseChunkCount());
+        return {Slot(chunks_[in_chunk], 0),
+                std::min(CHUNK_SIZE, count_ - in_chunk * CHUNK_SIZE)};
+    }
+
+    /**
+     * @brief Dense position of the first value in in_chunk.
+     */
+    std::size_t DenseChunkOffset(std::size_t in_chunk) const noexcept {
+        return in_chunk * CHUNK_SIZE;
+    }
+
+    const std::size_t * IndexData() const noexcept {
+        return index_dense_.data();
+    }
+
+    void Remove(size_t in_index) {
+        size_t pos = index_pos_map_.At(in_index);
+        size_t last_pos = count_ - 1;
+        size_t last_index = index_dense_.back();
+
+        if (pos != last_pos) {
+            *At(pos) = std::move(*At(last_pos));
+        }
+        At(last_pos)->~T();
+        count_--;
+
+        index_dense_[pos] = last_index;
+
+        index_pos_map_.Set(last_index, pos);
+
+        index_pos_map_.Erase(in_index);
+
+        index_dense_.pop_back();
+    }
+
+    void Clear() noexcept {
+        DestroyValues();
+        index_pos_map_.Clear();
+        index_dense_.clear();
+    }
+
+    /**
+     * @brief Allocate the chunks for in_size values, optional.
+     */
+    void Reserve(size_t in_size) {
+        if (in_size == 0) return;
+
+        EnsureChunk((in_size - 1) / CHUNK_SIZE);
+        index_dense_.reserve(in_size);
+    }
+
+    WNODISCARD bool Contains(size_t in_index) const {
+        return index_pos_map_.Contains(in_index);
+    }
+
+    WNODISCARD std::size_t ChunkCount() const noexcept {
+        return chunks_.size();
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(chunks_.data(), 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(chunks_.data(), count_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(chunks_.data(), 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(chunks_.data(), count_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    template<CCallable<void, std::size_t, T&> TFn>
+    void ForEach(TFn && in_predicate) {
+        ForEachChunk([this, &in_predicate](T * _values, std::size_t _first, std::size_t _count) {
+            for (std::size_t i=0; i < _count; i++) {
+                in_predicate(index_dense_[_first + i], _values[i]);
+            }
+        });
+    }
+
+    /**
+     * @brief Run in_fn(values, first dense position, count) for each used chunk.
+     */
+    template<CCallable<void, T*, std::size_t, std::size_t> TFn>
+    void ForEachChunk(TFn && in_fn) {
+        for (std::size_t first=0; first < count_; first += CHUNK_SIZE) {
+            in_fn(Slot(chunks_[first / CHUNK_SIZE], 0),
+                  first,
+                  std::min(CHUNK_SIZE, count_ - first));
+        }
+    }
+
+    auto IterIndexes() const {
+        return ConstIndexIterator(
+            index_dense_.cbegin(),
+            index_dense_.cend(),
+            [] (auto & _it, const std::int32_t & _i) -> const size_t & {
+                return *_it;
+            },
+            [](auto & _it, const std::int32_t & _i) -> typename IndexDenseType::const_iterator {
+                _it++;
+                return _it;
+            }
+            );
+    }
+
+    std::size_t IndexAt(std::size_t in_pos) const {
+        return index_dense_[in_pos];
+    }
+
+private:
+
+    static T * Slot(const ChunkType & in_chunk, std::size_t in_slot) noexcept {
+        return std::launder(reinterpret_cast<T*>(in_chunk[in_slot].data));
+    }
+
+    T * At(std::size_t in_pos) noexcept {
+        return Slot(chunks_[in_pos / CHUNK_SIZE], in_pos % CHUNK_SIZE);
+    }
+
+    const T * At(std::size_t in_pos) const noexcept {
+        return Slot(chunks_[in_pos / CHUNK_SIZE], in_pos % CHUNK_SIZE);
+    }
+
+    void EnsureChunk(std::size_t in_chunk) {
+        while (chunks_.size() <= in_chunk) {
+            chunks_.push_back(std::make_unique_for_overwrite<SlotStorage[]>(CHUNK_SIZE));
+        }
+    }
+
+    void DestroyValues() noexcept {
+        for (std::size_t i=0; i < count_; i++) {
+            At(i)->~T();
+        }
+        count_ = 0;
+    }
+
+    void CopyValuesFrom(const TChunkedSparseSet & other) {
+        if (!other.chunks_.empty()) {
+            EnsureChunk(other.chunks_.size() - 1);
+        }
+
+        for (std::size_t i=0; i < other.count_; i++) {
+            new (At(i)) T(*other.At(i));
+            count_++;
+        }
+    }
+
+    IndexPolicy index_pos_map_{};
+    IndexDenseType index_dense_{};
+
+    // Chunks are only added, never reallocated or released until destruction.
+    std::vector<ChunkType> chunks_{};
+
+    std::size_t count_{0};
+
+};
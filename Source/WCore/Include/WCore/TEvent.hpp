@@ -1,24 +1,31 @@
 #pragma once
 
-// #include "WCore/TFunction.hpp"
+#include "WCore/TFunction.hpp"
+#include "WCore/TMpscQueue.hpp"
 #include "WCore/WCore.hpp"
 #include "WCore/TSparseSet.hpp"
 #include "WCore/IdPool.hpp"
 
 #include <cstdint>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <functional>
 
-template<typename T>
+/**
+ * @brief Subscribers list, TFn is the stored subscriber type.
+ * See TInplaceEvent for subscribers stored without allocations.
+ */
+template<typename T, typename TFn=std::function<T>>
 struct TEvent;
 
-template<typename RetType, typename ... Args>
-struct TEvent<RetType(Args...)> {
+template<typename RetType, typename ... Args, typename TFn>
+struct TEvent<RetType(Args...), TFn> {
 
 public:
 
-    using FnType = std::function<RetType(Args...)>;
+    using FnType = TFn;
 
 public:
 
@@ -72,3 +79,99 @@ private:
     wcr::IdPool<wcr::wid::WEventId::IdType> id_pool_{};
 
 };
+
+/**
+ * @brief TEvent with subscribers stored inline in the subscribers set, no allocation
+ * per subscriber. Subscribers must fit in a TInplaceFunction and be copyable.
+ */
+template<typename T>
+using TInplaceEvent = TEvent<T, TInplaceFunction<T>>;
+
+template<typename T, typename TFn=std::function<T>>
+struct TEventChannel;
+
+/**
+ * @brief Deferred TEvent. Any thread Post events into a TMpscQueue,
+ * the owner thread Dispatch them to the subscribers in post order.
+ * Subscribe, Unsubscribe and Dispatch are owner thread only.
+ */
+template<typename ... Args, typename TFn>
+struct TEventChannel<void(Args...), TFn> {
+
+public:
+
+    using EventType = TEvent<void(Args...), TFn>;
+
+    using FnType = typename EventType::FnType;
+
+    using PayloadType = std::tuple<std::decay_t<Args>...>;
+
+public:
+
+    explicit TEventChannel(std::size_t in_capacity=1024) :
+        queue_(in_capacity) {}
+
+    TEventChannel(const TEventChannel &) = delete;
+
+    TEventChannel(TEventChannel &&) = delete;
+
+    TEventChannel & operator=(const TEventChannel &) = delete;
+
+    TEventChannel & operator=(TEventChannel &&) = delete;
+
+    ~TEventChannel() = default;
+
+    /**
+     * @brief Any thread, copies the arguments in the queue.
+     * @return false when the queue is full, the event is dropped.
+     */
+    template<typename ... FArgs>
+    WNODISCARD bool Post(FArgs && ... args) {
+        return queue_.Emplace(std::forward<FArgs>(args)...);
+    }
+
+    /**
+     * @brief Emit the queued events, events posted while dispatching are included.
+     * @return Number of dispatched events.
+     */
+    std::size_t Dispatch() {
+        std::size_t count = 0;
+        PayloadType payload;
+
+        while (queue_.Pop(payload)) {
+            std::apply(
+                [this](auto & ... _args) {
+                    event_.Emit(_args...);
+                },
+                payload
+                );
+
+            count++;
+        }
+
+        return count;
+    }
+
+    wcr::wid::WEventId Subscribe(FnType && in_fn) {
+        return event_.Subscribe(std::move(in_fn));
+    }
+
+    void Unsubscribe(const wcr::wid::WEventId & in_id) {
+        event_.Unsubscribe(in_id);
+    }
+
+    void Clear() {
+        event_.Clear();
+    }
+
+    WNODISCARD std::size_t Pending() const noexcept {
+        return queue_.Count();
+    }
+
+private:
+
+    TMpscQueue<PayloadType> queue_;
+
+    EventType event_{};
+
+};
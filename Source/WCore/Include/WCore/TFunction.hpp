@@ -3,11 +3,14 @@
 #include "WCore/WConcepts.hpp"
 #include "WLog.hpp"
 
+#include <cstddef>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <concepts>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 template<typename T>
 struct TFnPtr;
@@ -54,3 +57,141 @@ private:
     Ret(*fn_)(Args...);
 
 };
+
+template<typename T, std::size_t Size=48>
+struct TInplaceFunction;
+
+/**
+ * @brief std::function like callable stored inline, never allocates.
+ * Callables bigger than Size bytes don't compile, wrap them in a std::function if needed.
+ */
+template<typename Ret, typename ...Args, std::size_t Size>
+struct TInplaceFunction<Ret(Args...), Size> {
+
+private:
+
+    struct Ops {
+        Ret(*invoke)(void *, Args && ...);
+        void(*copy)(void *, const void *);
+        void(*move)(void *, void *) noexcept;
+        void(*destroy)(void *) noexcept;
+    };
+
+    template<typename F>
+    static constexpr Ops ops_for_{
+        [](void * _fn, Args && ... _args) -> Ret {
+            return std::invoke(*static_cast<F *>(_fn), std::forward<Args>(_args)...);
+        },
+        [](void * _dst, const void * _src) {
+            ::new (_dst) F(*static_cast<const F *>(_src));
+        },
+        [](void * _dst, void * _src) noexcept {
+            ::new (_dst) F(std::move(*static_cast<F *>(_src)));
+            static_cast<F *>(_src)->~F();
+        },
+        [](void * _fn) noexcept {
+            static_cast<F *>(_fn)->~F();
+        }
+    };
+
+public:
+
+    constexpr TInplaceFunction() noexcept = default;
+
+    constexpr TInplaceFunction(std::nullptr_t) noexcept {}
+
+    template<typename F>
+    requires (!std::same_as<std::remove_cvref_t<F>, TInplaceFunction> &&
+              std::is_invocable_r_v<Ret, std::decay_t<F> &, Args...>)
+    TInplaceFunction(F && in_fn) {
+        using FnType = std::decay_t<F>;
+
+        static_assert(sizeof(FnType) <= Size,
+                      "Callable doesn't fit in TInplaceFunction storage.");
+        static_assert(alignof(FnType) <= alignof(std::max_align_t),
+                      "Callable alignment not supported by TInplaceFunction.");
+        static_assert(std::is_nothrow_move_constructible_v<FnType>,
+                      "TInplaceFunction callables must be nothrow move constructible.");
+
+        if constexpr (std::is_pointer_v<FnType> || std::is_member_pointer_v<FnType>) {
+            if (!in_fn) return;
+        }
+
+        ::new (static_cast<void *>(storage_)) FnType(std::forward<F>(in_fn));
+        ops_ = &ops_for_<FnType>;
+    }
+
+    ~TInplaceFunction() {
+        Reset();
+    }
+
+    TInplaceFunction(const TInplaceFunction & other) {
+        if (other.ops_) {
+            other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    TInplaceFunction(TInplaceFunction && other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = std::exchange(other.ops_, nullptr);
+        }
+    }
+
+    TInplaceFunction & operator=(const TInplaceFunction & other) {
+        if (this != &other) {
+            TInplaceFunction copy(other);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    TInplaceFunction & operator=(TInplaceFunction && other) noexcept {
+        if (this != &other) {
+            Reset();
+
+            if (other.ops_) {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = std::exchange(other.ops_, nullptr);
+            }
+        }
+
+        return *this;
+    }
+
+    Ret operator()(Args ... args) const {
+        if (!ops_) {
+            throw std::bad_function_call();
+        }
+
+        return ops_->invoke(const_cast<std::byte *>(storage_), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return IsValid();
+    }
+
+    bool IsValid() const noexcept {
+        return ops_ != nullptr;
+    }
+
+    bool IsEmpty() const noexcept {
+        return !IsValid();
+    }
+
+    void Reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+
+    alignas(std::max_align_t) std::byte storage_[Size];
+
+    const Ops * ops_{nullptr};
+
+};
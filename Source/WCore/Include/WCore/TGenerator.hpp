@@ -1,3 +1,402 @@
 #pragma once
 
-// Write Here a Courutine Generator.
+#include "WCore/WCoreMacros.hpp"
+#include "WCore/WThreadLib.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Lazy sequence of T produced by a coroutine with co_yield.
+ * The coroutine runs only while iterating, one value at a time.
+ * Yielded values live until the coroutine resumes, iterators give references to them.
+ */
+template<typename T>
+class TGenerator {
+public:
+
+    using ValueType = std::remove_cvref_t<T>;
+
+    using ReferenceType = std::conditional_t<std::is_reference_v<T>, T, const T &>;
+
+    using PointerType = std::add_pointer_t<ReferenceType>;
+
+    struct promise_type {
+
+        TGenerator get_return_object() noexcept {
+            return TGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        std::suspend_always final_suspend() const noexcept { return {}; }
+
+        std::suspend_always yield_value(std::remove_reference_t<ReferenceType> & in_value) noexcept {
+            value = std::addressof(in_value);
+            return {};
+        }
+
+        std::suspend_always yield_value(std::remove_reference_t<ReferenceType> && in_value) noexcept {
+            value = std::addressof(in_value);
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() {
+            exception = std::current_exception();
+        }
+
+        // Disallow co_await in generators.
+        template<typename U>
+        void await_transform(U &&) = delete;
+
+        void Rethrow() {
+            if (exception) {
+                std::rethrow_exception(std::exchange(exception, nullptr));
+            }
+        }
+
+        PointerType value{nullptr};
+        std::exception_ptr exception{nullptr};
+    };
+
+    using HandleType = std::coroutine_handle<promise_type>;
+
+    class Iterator {
+    public:
+
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = ValueType;
+        using reference = ReferenceType;
+        using pointer = PointerType;
+
+        Iterator() noexcept = default;
+
+        explicit Iterator(HandleType in_handle) noexcept : handle_(in_handle) {}
+
+        reference operator*() const noexcept {
+            return static_cast<reference>(*handle_.promise().value);
+        }
+
+        pointer operator->() const noexcept {
+            return handle_.promise().value;
+        }
+
+        Iterator & operator++() {
+            handle_.resume();
+            if (handle_.done()) {
+                handle_.promise().Rethrow();
+            }
+
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        friend bool operator==(const Iterator & in_it, std::default_sentinel_t) noexcept {
+            return !in_it.handle_ || in_it.handle_.done();
+        }
+
+    private:
+
+        HandleType handle_{nullptr};
+    };
+
+public:
+
+    TGenerator() noexcept = default;
+
+    TGenerator(const TGenerator &) = delete;
+
+    TGenerator(TGenerator && other) noexcept :
+        handle_(std::exchange(other.handle_, nullptr)) {}
+
+    TGenerator & operator=(const TGenerator &) = delete;
+
+    TGenerator & operator=(TGenerator && other) noexcept {
+        if (this != &other) {
+            Destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~TGenerator() {
+        Destroy();
+    }
+
+    /**
+     * @brief Starts the coroutine, a generator can be iterated once.
+     */
+    Iterator begin() {
+        if (handle_) {
+            handle_.resume();
+            if (handle_.done()) {
+                handle_.promise().Rethrow();
+            }
+        }
+
+        return Iterator(handle_);
+    }
+
+    std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+    }
+
+private:
+
+    explicit TGenerator(HandleType in_handle) noexcept : handle_(in_handle) {}
+
+    void Destroy() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    HandleType handle_{nullptr};
+
+};
+
+template<typename T>
+class TTask;
+
+namespace TTaskDetail {
+
+    /**
+     * @brief Common TTask promise part, resumes the awaiting coroutine at the end,
+     * or marks the WJobCounter of WThreadLib::WaitTask.
+     */
+    struct PromiseBase {
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template<typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> in_handle) noexcept {
+                PromiseBase & promise = in_handle.promise();
+
+                if (promise.continuation) {
+                    return promise.continuation;
+                }
+
+                if (promise.counter) {
+                    // The waiting thread can destroy the task after this point.
+                    promise.counter->Done();
+                }
+
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        void Rethrow() {
+            if (exception) {
+                std::rethrow_exception(std::exchange(exception, nullptr));
+            }
+        }
+
+        std::coroutine_handle<> continuation{nullptr};
+        WThreadLib::WJobCounter * counter{nullptr};
+        std::exception_ptr exception{nullptr};
+    };
+
+    template<typename T>
+    struct Promise : PromiseBase {
+
+        TTask<T> get_return_object() noexcept;
+
+        template<typename V>
+        requires std::is_convertible_v<V &&, T>
+        void return_value(V && in_value) {
+            value.emplace(std::forward<V>(in_value));
+        }
+
+        T Result() {
+            Rethrow();
+            return std::move(*value);
+        }
+
+        std::optional<T> value{};
+    };
+
+    template<>
+    struct Promise<void> : PromiseBase {
+
+        TTask<void> get_return_object() noexcept;
+
+        void return_void() const noexcept {}
+
+        void Result() {
+            Rethrow();
+        }
+    };
+
+}
+
+/**
+ * @brief Lazy coroutine returning T. Starts when awaited with co_await from other
+ * coroutine, or with WThreadLib::WaitTask. Use co_await WThreadLib::ScheduleOn(job_system)
+ * inside the task to continue in a WJobSystem job.
+ */
+template<typename T=void>
+class TTask {
+public:
+
+    using promise_type = TTaskDetail::Promise<T>;
+
+    using HandleType = std::coroutine_handle<promise_type>;
+
+    struct Awaiter {
+        bool await_ready() const noexcept {
+            return !handle || handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> in_awaiting) noexcept {
+            handle.promise().continuation = in_awaiting;
+            return handle;
+        }
+
+        T await_resume() {
+            return handle.promise().Result();
+        }
+
+        HandleType handle;
+    };
+
+public:
+
+    TTask() noexcept = default;
+
+    explicit TTask(HandleType in_handle) noexcept : handle_(in_handle) {}
+
+    TTask(const TTask &) = delete;
+
+    TTask(TTask && other) noexcept :
+        handle_(std::exchange(other.handle_, nullptr)) {}
+
+    TTask & operator=(const TTask &) = delete;
+
+    TTask & operator=(TTask && other) noexcept {
+        if (this != &other) {
+            Destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~TTask() {
+        Destroy();
+    }
+
+    Awaiter operator co_await() const & noexcept {
+        return Awaiter{handle_};
+    }
+
+    Awaiter operator co_await() const && noexcept {
+        return Awaiter{handle_};
+    }
+
+    WNODISCARD bool IsValid() const noexcept {
+        return static_cast<bool>(handle_);
+    }
+
+    WNODISCARD bool IsDone() const noexcept {
+        return !handle_ || handle_.done();
+    }
+
+    HandleType Handle() const noexcept {
+        return handle_;
+    }
+
+private:
+
+    void Destroy() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    HandleType handle_{nullptr};
+
+};
+
+template<typename T>
+TTask<T> TTaskDetail::Promise<T>::get_return_object() noexcept {
+    return TTask<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline TTask<void> TTaskDetail::Promise<void>::get_return_object() noexcept {
+    return TTask<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+namespace WThreadLib {
+
+    /**
+     * @brief co_await ScheduleOn(job_system) continues the coroutine in a job_system job.
+     */
+    struct WScheduleAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> in_handle) {
+            job_system.Schedule([in_handle]() { in_handle.resume(); });
+        }
+
+        void await_resume() const noexcept {}
+
+        WJobSystem & job_system;
+    };
+
+    inline WScheduleAwaiter ScheduleOn(WJobSystem & in_job_system) noexcept {
+        return WScheduleAwaiter{in_job_system};
+    }
+
+    /**
+     * @brief Start in_task in the calling thread and run in_job_system jobs until it is done.
+     */
+    template<typename T>
+    T WaitTask(WJobSystem & in_job_system, TTask<T> & in_task) {
+        assert(in_task.IsValid());
+
+        auto handle = in_task.Handle();
+
+        if (!handle.done()) {
+            WJobCounter counter;
+            counter.Add();
+            handle.promise().counter = &counter;
+
+            handle.resume();
+            in_job_system.Wait(counter);
+        }
+
+        return handle.promise().Result();
+    }
+
+    template<typename T>
+    T WaitTask(WJobSystem & in_job_system, TTask<T> && in_task) {
+        return WaitTask(in_job_system, in_task);
+    }
+
+}
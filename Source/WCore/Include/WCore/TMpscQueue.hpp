@@ -0,0 +1,174 @@
+#pragma once
+
+#include "WCore/WCoreMacros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Bounded lock-free multi producer single consumer ring buffer.
+ * Any thread Push, a single consumer thread Pop. Each cell has a sequence number
+ * that tells producers and the consumer when the cell is free or filled.
+ */
+template<typename T>
+class TMpscQueue {
+
+private:
+
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        alignas(T) std::byte value[sizeof(T)];
+
+        T * Value() noexcept {
+            return std::launder(reinterpret_cast<T *>(value));
+        }
+    };
+
+public:
+
+    /**
+     * @brief in_capacity is rounded up to a power of two.
+     */
+    explicit TMpscQueue(std::size_t in_capacity=1024) {
+        capacity_ = 2;
+        while (capacity_ < in_capacity) capacity_ <<= 1;
+        mask_ = capacity_ - 1;
+
+        cells_ = std::make_unique<Cell[]>(capacity_);
+        for (std::size_t i=0; i < capacity_; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    TMpscQueue(const TMpscQueue &) = delete;
+
+    TMpscQueue(TMpscQueue &&) = delete;
+
+    TMpscQueue & operator=(const TMpscQueue &) = delete;
+
+    TMpscQueue & operator=(TMpscQueue &&) = delete;
+
+    ~TMpscQueue() {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+
+        while (cells_[head & mask_].sequence.load(std::memory_order_acquire) == head + 1) {
+            cells_[head & mask_].Value()->~T();
+            head++;
+        }
+    }
+
+    /**
+     * @brief Any thread, constructs a value in place.
+     * A throwing constructor runs on a temporary before a cell is claimed,
+     * a claimed cell must always be published or the consumer stalls on it.
+     * @return false when the queue is full.
+     */
+    template<typename ... FArgs>
+    WNODISCARD bool Emplace(FArgs && ... in_args) {
+        if constexpr (std::is_nothrow_constructible_v<T, FArgs...>) {
+            return EmplaceCell(std::forward<FArgs>(in_args)...);
+        }
+        else {
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                          "TMpscQueue requires a nothrow move constructible T.");
+
+            T value(std::forward<FArgs>(in_args)...);
+            return EmplaceCell(std::move(value));
+        }
+    }
+
+    WNODISCARD bool Push(const T & in_value) {
+        return Emplace(in_value);
+    }
+
+    WNODISCARD bool Push(T && in_value) {
+        return Emplace(std::move(in_value));
+    }
+
+    /**
+     * @brief Consumer thread only, takes the oldest value.
+     */
+    WNODISCARD bool Pop(T & out_value) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        Cell & cell = cells_[head & mask_];
+
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+
+        out_value = std::move(*cell.Value());
+        cell.Value()->~T();
+
+        cell.sequence.store(head + capacity_, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of values.
+     */
+    WNODISCARD std::size_t Count() const noexcept {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    WNODISCARD bool Empty() const noexcept {
+        return Count() == 0;
+    }
+
+    WNODISCARD std::size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+
+    template<typename ... FArgs>
+    requires std::is_nothrow_constructible_v<T, FArgs...>
+    bool EmplaceCell(FArgs && ... in_args) noexcept {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell * cell;
+
+        while (true) {
+            cell = &cells_[pos & mask_];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                // The consumer didn't release the cell of the previous lap.
+                return false;
+            }
+            else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void *>(cell->value)) T(std::forward<FArgs>(in_args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    std::unique_ptr<Cell[]> cells_{};
+
+    std::size_t capacity_{0};
+
+    std::size_t mask_{0};
+
+    alignas(64) std::atomic<std::size_t> tail_{0};
+
+    // Written by the consumer thread only.
+    alignas(64) std::atomic<std::size_t> head_{0};
+
+};
@@ -3,7 +3,10 @@
 #include "WCore/WCore.hpp"
 #include "WCore/IdPool.hpp"
 #include "TSparseSet.hpp"
+#include "TChunkedSparseSet.hpp"
 #include "WCore/WConcepts.hpp"
+#include "WCore/TStridedView.hpp"
+#include "WCore/TGenerator.hpp"
 
 #include <memory>
 #include <concepts>
@@ -31,12 +34,34 @@ public:
     
     virtual size_t Count() const = 0;
     virtual bool Contains(const IdBase & in_id) const = 0;
+    virtual std::size_t Generation(const IdBase & in_id) const = 0;
     virtual void Reserve(size_t in_value) = 0;
     virtual std::vector<IdBase> Indexes() = 0;
 
+    /**
+     * @brief Ids one by one without building a vector like Indexes,
+     * the db must not change while iterating.
+     */
+    virtual TGenerator<IdBase> GenerateIndexes() const = 0;
+
     virtual void BForEach(std::function<void(B*)> in_function)=0;
     virtual void BForEachIdValue(std::function<void(const IdBase &, B *)>)=0;
 
+    /**
+     * @brief Number of dense chunks, iterate them with BChunk and BChunkIds.
+     */
+    virtual std::size_t BChunkCount() const=0;
+
+    /**
+     * @brief Values of in_chunk, walking them doesn't need virtual calls.
+     */
+    virtual TStridedView<B> BChunk(std::size_t in_chunk)=0;
+
+    /**
+     * @brief Ids of in_chunk values, same order and count as BChunk.
+     */
+    virtual const std::size_t * BChunkIds(std::size_t in_chunk) const=0;
+
     virtual void const * BData() const=0;
     
 };
@@ -47,18 +72,24 @@ public:
  * Object in the containe can be accesed by WId.
  * You can specify a create_fn to create objects inside the container.
  * And a destroy_fn called when remove objects in the container.
+ * Each id has a generation that changes when the object at the id is removed,
+ * handles (id + generation) detect stale ids without tracking pointers.
+ * Storage is a TSparseSet (single contiguous buffer) by default,
+ * use a TChunkedSparseSet to keep object addresses stable while the container grows.
  */
 template<typename T,
          typename CreateFn,
          typename DestroyFn,
          CConvertibleTo<T> B=void,
          std::integral IdBase=std::uint64_t,
-         typename Allocator=std::allocator<T>>
+         typename Allocator=std::allocator<T>,
+         typename IndexPolicy=TSparseHashIndex,
+         typename Storage=TSparseSet<T, Allocator, std::allocator<std::size_t>, IndexPolicy>>
 class TObjDb : public IObjectDataBase<B, IdBase> {
 public:
 
     using Super = IObjectDataBase<B, IdBase>;
-    using StorageType = TSparseSet<T, Allocator>;
+    using StorageType = Storage;
 
     template<typename IndexIterator, typename ValueFn, typename IncrFn>
     using ConstWIdIterator = TIterator<IdBase,
@@ -77,7 +108,8 @@ public:
         create_fn_(),
         destroy_fn_(),
         id_pool_(),
-        storage_(in_allocator)
+        storage_(in_allocator),
+        generations_()
         {}
 
     constexpr TObjDb(
@@ -87,7 +119,8 @@ public:
         create_fn_(in_create_fn),
         destroy_fn_(in_destroy_fn),
         id_pool_(),
-        storage_()
+        storage_(),
+        generations_()
         {}
 
     constexpr TObjDb(
@@ -98,11 +131,14 @@ public:
         create_fn_(in_create_fn),
         destroy_fn_(in_destroy_fn),
         id_pool_(),
-        storage_(in_allocator)
+        storage_(in_allocator),
+        generations_()
         {}
 
     virtual ~TObjDb() {
-        Clear();
+        for (auto & o : storage_) {
+            destroy_fn_(o);
+        }
     }
 
     TObjDb(TObjDb const & other) = default;
@@ -137,13 +173,13 @@ public:
     }
 
     void CreateAt(const IdBase & in_id) override {
-        id_pool_.AddToPool(in_id);
+        id_pool_.ExtractFromPool(in_id);
         storage_.Insert(in_id, create_fn_(in_id));
     }
 
     template<CCallable<T, const IdBase &> TCreateFn>
     void CreateAt(const IdBase & in_id, TCreateFn && in_create_fn) {
-        id_pool_.AddToPool(in_id);
+        id_pool_.ExtractFromPool(in_id);
         storage_.Insert(in_id, std::forward<TCreateFn>(in_create_fn)(in_id));
     }
 
@@ -157,12 +193,12 @@ public:
 
     template<typename D> requires std::is_same_v<std::remove_cvref_t<D>, T>
     void InsertAt(const IdBase & in_id, D && in_value) {
-        id_pool_.AddToPool(in_id);
+        id_pool_.ExtractFromPool(in_id);
         storage_.Insert(in_id, std::forward<D>(in_value));
     }
 
     void InsertAt(const IdBase & in_id, B* & in_value) override {
-        id_pool_.AddToPool(in_id);
+        id_pool_.ExtractFromPool(in_id);
         storage_.Insert(in_id, *static_cast<T*>(in_value));
     }
 
@@ -171,12 +207,14 @@ public:
         std::forward<TDestroyFn>(in_destroy_fn)(storage_.Get(in_id));
         id_pool_.AddToPool(in_id);
         storage_.Remove(in_id);
+        NextGeneration(in_id);
     }
 
     void Remove(const IdBase & in_id) override final {
         destroy_fn_(storage_.Get(in_id));
         id_pool_.AddToPool(in_id);
         storage_.Remove(in_id);
+        NextGeneration(in_id);
     }
 
     template<CCallable<void, T&> TFn>
@@ -184,6 +222,10 @@ public:
         for (auto & o : storage_) {
             std::forward<TFn>(in_destroy_fn)(o);
         }
+
+        for (std::size_t i=0; i < storage_.Count(); i++) {
+            NextGeneration(storage_.IndexAt(i));
+        }
         
         id_pool_.Clear();
         storage_.Clear();
@@ -193,6 +235,10 @@ public:
         for (auto & o : storage_) {
             destroy_fn_(o);
         }
+
+        for (std::size_t i=0; i < storage_.Count(); i++) {
+            NextGeneration(storage_.IndexAt(i));
+        }
         
         id_pool_.Clear();
         storage_.Clear();
@@ -242,6 +288,14 @@ public:
         return storage_.Contains(in_id);
     }
 
+    /**
+     * @brief Current generation of in_id, 0 until an object at in_id is removed.
+     */
+    std::size_t Generation(const IdBase & in_id) const override final {
+        std::size_t generation = generations_.Find(in_id);
+        return generation != IndexPolicy::TOMBSTONE ? generation : 0;
+    }
+
     void SetCreateFn(const CreateFn & in_create_fn) {
         create_fn_ = in_create_fn;
     }
@@ -279,19 +333,25 @@ public:
         return result;
     }
 
-    constexpr StorageType::Iterator begin() noexcept {
+    TGenerator<IdBase> GenerateIndexes() const override {
+        for (IdBase d : IterIndexes()) {
+            co_yield d;
+        }
+    }
+
+    constexpr typename StorageType::Iterator begin() noexcept {
         return storage_.begin();
     }
 
-    constexpr StorageType::Iterator end() noexcept {
+    constexpr typename StorageType::Iterator end() noexcept {
         return storage_.end();
     }
 
-    constexpr StorageType::ConstIterator cbegin() const noexcept {
+    constexpr typename StorageType::ConstIterator cbegin() const noexcept {
         return storage_.cbegin();
     }
 
-    constexpr StorageType::ConstIterator cend() const noexcept {
+    constexpr typename StorageType::ConstIterator cend() const noexcept {
         return storage_.cend();
     }
 
@@ -326,31 +386,58 @@ public:
         }
     }
 
+    std::size_t BChunkCount() const override final {
+        return storage_.DenseChunkCount();
+    }
+
+    TStridedView<B> BChunk(std::size_t in_chunk) override final {
+        std::span<T> chunk = storage_.DenseChunk(in_chunk);
+
+        return TStridedView<B>(
+            static_cast<B*>(chunk.data()), sizeof(T), chunk.size()
+            );
+    }
+
+    const std::size_t * BChunkIds(std::size_t in_chunk) const override final {
+        return storage_.IndexData() + storage_.DenseChunkOffset(in_chunk);
+    }
+
     void const * BData() const override {
         return storage_.DenseData();
     }
 
 private:
 
+    void NextGeneration(const IdBase & in_id) {
+        generations_.Set(in_id, Generation(in_id) + 1);
+    }
+
     CreateFn create_fn_{};
     DestroyFn destroy_fn_{}; 
 
     wcr::IdPool<IdBase> id_pool_{};
 
     StorageType storage_{};
+
+    // Generation by id, ids never removed are not present (generation 0)
+    IndexPolicy generations_{};
     
 };
 
 template<typename T,
          CConvertibleTo<T> B=void,
          std::integral IdBase=std::uint64_t,
-         typename Allocator=std::allocator<T>>
+         typename Allocator=std::allocator<T>,
+         typename IndexPolicy=TSparseHashIndex,
+         typename Storage=TSparseSet<T, Allocator, std::allocator<std::size_t>, IndexPolicy>>
 using TObjectDataBase = TObjDb<T,
                                std::function<T(IdBase const &)>,
                                std::function<void(T&)>,
                                B,
                                IdBase,
-                               Allocator>;
+                               Allocator,
+                               IndexPolicy,
+                               Storage>;
 
 
 
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "WCore/WCoreMacros.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <cassert>
+
+/**
+ * @brief Sparse index policy backed by an unordered_map.
+ * Suitable for big or scattered ids (packed compound ids, hashes...).
+ */
+class TSparseHashIndex {
+public:
+
+    static constexpr std::size_t TOMBSTONE{ std::numeric_limits<std::size_t>::max() };
+
+public:
+
+    TSparseHashIndex() noexcept = default;
+    ~TSparseHashIndex() = default;
+    TSparseHashIndex(const TSparseHashIndex &) = default;
+    TSparseHashIndex(TSparseHashIndex &&) noexcept = default;
+    TSparseHashIndex & operator=(const TSparseHashIndex &) = default;
+    TSparseHashIndex & operator=(TSparseHashIndex &&) noexcept = default;
+
+    /**
+     * @brief Dense position of in_index or TOMBSTONE if not present.
+     */
+    WNODISCARD std::size_t Find(std::size_t in_index) const {
+        auto it = index_pos_map_.find(in_index);
+        return it != index_pos_map_.end() ? it->second : TOMBSTONE;
+    }
+
+    /**
+     * @brief Dense position of in_index, in_index must be present.
+     */
+    WNODISCARD std::size_t At(std::size_t in_index) const {
+        return index_pos_map_.at(in_index);
+    }
+
+    WNODISCARD bool Contains(std::size_t in_index) const {
+        return index_pos_map_.contains(in_index);
+    }
+
+    void Set(std::size_t in_index, std::size_t in_pos) {
+        index_pos_map_[in_index] = in_pos;
+    }
+
+    void Erase(std::size_t in_index) {
+        index_pos_map_.erase(in_index);
+    }
+
+    void Clear() noexcept {
+        index_pos_map_.clear();
+    }
+
+private:
+
+    std::unordered_map<std::size_t, std::size_t> index_pos_map_{};
+
+};
+
+/**
+ * @brief Sparse index policy backed by lazily allocated fixed-size pages.
+ * Indexes are resolved with a shift and a mask, empty slots hold TOMBSTONE.
+ * Missing pages point to a shared read-only tombstone page,
+ * so a lookup never has to check for null pages.
+ * Designed for dense small ids, like the ones generated by wcr::IdPool.
+ */
+template<std::size_t PageSize=4096>
+class TSparsePagedIndex {
+public:
+
+    static_assert(std::has_single_bit(PageSize), "PageSize must be a power of two.");
+
+    static constexpr std::size_t TOMBSTONE{ std::numeric_limits<std::size_t>::max() };
+    static constexpr std::size_t PAGE_SHIFT{ static_cast<std::size_t>(std::countr_zero(PageSize)) };
+    static constexpr std::size_t PAGE_MASK{ PageSize - 1 };
+
+    using PageType = std::array<std::size_t, PageSize>;
+
+public:
+
+    TSparsePagedIndex() noexcept = default;
+
+    ~TSparsePagedIndex() = default;
+
+    TSparsePagedIndex(const TSparsePagedIndex & other) :
+        pages_(),
+        lookup_() {
+        CopyPagesFrom(other);
+    }
+
+    TSparsePagedIndex(TSparsePagedIndex && other) noexcept = default;
+
+    TSparsePagedIndex & operator=(const TSparsePagedIndex & other) {
+        if (this != &other) {
+            CopyPagesFrom(other);
+        }
+
+        return *this;
+    }
+
+    TSparsePagedIndex & operator=(TSparsePagedIndex && other) noexcept = default;
+
+    WNODISCARD HOT std::size_t Find(std::size_t in_index) const noexcept {
+        const std::size_t page = in_index >> PAGE_SHIFT;
+        return page < lookup_.size() ?
+            (*lookup_[page])[in_index & PAGE_MASK] :
+            TOMBSTONE;
+    }
+
+    WNODISCARD HOT std::size_t At(std::size_t in_index) const noexcept {
+        assert(Contains(in_index));
+        return (*lookup_[in_index >> PAGE_SHIFT])[in_index & PAGE_MASK];
+    }
+
+    WNODISCARD HOT bool Contains(std::size_t in_index) const noexcept {
+        return Find(in_index) != TOMBSTONE;
+    }
+
+    void Set(std::size_t in_index, std::size_t in_pos) {
+        EnsurePage(in_index >> PAGE_SHIFT)[in_index & PAGE_MASK] = in_pos;
+    }
+
+    void Erase(std::size_t in_index) noexcept {
+        const std::size_t page = in_index >> PAGE_SHIFT;
+        if (page < pages_.size() && pages_[page]) {
+            (*pages_[page])[in_index & PAGE_MASK] = TOMBSTONE;
+        }
+    }
+
+    void Clear() noexcept {
+        pages_.clear();
+        lookup_.clear();
+    }
+
+    WNODISCARD std::size_t PageCount() const noexcept {
+        return pages_.size();
+    }
+
+private:
+
+    static const PageType * TombstonePage() noexcept {
+        static const PageType tombstone_page = [] {
+            PageType p;
+            p.fill(TOMBSTONE);
+            return p;
+        }();
+
+        return &tombstone_page;
+    }
+
+    PageType & EnsurePage(std::size_t in_page) {
+        if (in_page >= pages_.size()) {
+            pages_.resize(in_page + 1);
+            lookup_.resize(in_page + 1, TombstonePage());
+        }
+
+        if (!pages_[in_page]) {
+            pages_[in_page] = std::make_unique<PageType>();
+            pages_[in_page]->fill(TOMBSTONE);
+            lookup_[in_page] = pages_[in_page].get();
+        }
+
+        return *pages_[in_page];
+    }
+
+    void CopyPagesFrom(const TSparsePagedIndex & other) {
+        pages_.clear();
+        lookup_.clear();
+
+        pages_.resize(other.pages_.size());
+        lookup_.resize(other.lookup_.size(), TombstonePage());
+
+        for (std::size_t i=0; i < other.pages_.size(); i++) {
+            if (other.pages_[i]) {
+                pages_[i] = std::make_unique<PageType>(*other.pages_[i]);
+                lookup_[i] = pages_[i].get();
+            }
+        }
+    }
+
+    // Owned pages, nullptr while a page has not been touched.
+    std::vector<std::unique_ptr<PageType>> pages_{};
+
+    // Read path, untouched pages point to TombstonePage().
+    std::vector<const PageType *> lookup_{};
+
+};
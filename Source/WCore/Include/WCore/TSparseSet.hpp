@@ -3,25 +3,28 @@
 #include "WCore/WConcepts.hpp"
 #include "WCore/WCore.hpp"
 #include "WCore/TIterator.hpp"
+#include "WCore/TSparseIndex.hpp"
 
 #include <concepts>
 #include <memory>
-#include <unordered_map>
+#include <span>
 #include <vector>
 #include <cassert>
 
 template<typename T,
          typename ValueAllocator=std::allocator<T>,
-         typename IndexAllocator=std::allocator<std::size_t>>
+         typename IndexAllocator=std::allocator<std::size_t>,
+         typename IndexPolicy=TSparseHashIndex>
 class TSparseSet {
 
 public:
 
-    using IndexPosType = std::unordered_map<size_t, size_t>;
+    using IndexPosType = IndexPolicy;
+    using IndexDenseType = std::vector<std::size_t, IndexAllocator>;
 
     template<typename ValueFn, typename IncrFn>
     using ConstIndexIterator = TIterator<size_t,
-                                         IndexPosType::const_iterator,
+                                         typename IndexDenseType::const_iterator,
                                          const size_t &,
                                          ValueFn,
                                          IncrFn>;
@@ -82,26 +85,26 @@ public:
 
     template<std::convertible_to<T> D>
     void Insert(const std::size_t & in_index, D && in_value) {
-        if (Contains(in_index)) {
-            size_t pos = index_pos_map_[in_index];
+        size_t pos = index_pos_map_.Find(in_index);
+        if (pos != IndexPolicy::TOMBSTONE) {
             value_dense_[pos]=std::forward<D>(in_value);
         }
         else {
-            size_t pos = value_dense_.size();
+            pos = value_dense_.size();
             value_dense_.push_back(std::forward<D>(in_value));
 
-            index_pos_map_[in_index] = pos;
+            index_pos_map_.Set(in_index, pos);
 
             index_dense_.push_back(in_index);
         }
     }
 
     T & Get(size_t in_index) {
-        return value_dense_[index_pos_map_[in_index]];
+        return value_dense_[index_pos_map_.At(in_index)];
     }
 
     const T & Get(size_t in_index) const {
-        return value_dense_[index_pos_map_.at(in_index)];
+        return value_dense_[index_pos_map_.At(in_index)];
     }
 
     std::size_t DensePosition(std::size_t in_pos) const {
@@ -120,32 +123,57 @@ public:
         return value_dense_.size();
     }
 
+    /**
+     * @brief Values are stored in a single chunk, 0 if empty.
+     */
+    std::size_t DenseChunkCount() const noexcept {
+        return value_dense_.empty() ? 0 : 1;
+    }
+
+    std::span<T> DenseChunk(std::size_t in_chunk) noexcept {
+        assert(in_chunk == 0);
+        return {value_dense_.data(), value_dense_.size()};
+    }
+
+    /**
+     * @brief Dense position of the first value in in_chunk.
+     */
+    std::size_t DenseChunkOffset(std::size_t in_chunk) const noexcept {
+        return 0;
+    }
+
+    const std::size_t * IndexData() const noexcept {
+        return index_dense_.data();
+    }
+
     void Remove(size_t in_index) {
-        size_t pos = index_pos_map_[in_index];
+        size_t pos = index_pos_map_.At(in_index);
         size_t last_index = index_dense_.back();
         
         value_dense_[pos] = std::move(value_dense_.back());
+        index_dense_[pos] = last_index;
 
-        index_pos_map_[last_index] = pos;
+        index_pos_map_.Set(last_index, pos);
 
-        index_pos_map_.erase(in_index);
+        index_pos_map_.Erase(in_index);
 
         value_dense_.pop_back();
         index_dense_.pop_back();
     }
 
     void Clear() noexcept {
-        index_pos_map_.clear();
+        index_pos_map_.Clear();
         value_dense_.clear();
         index_dense_.clear();
     }
 
     constexpr void Reserve(size_t in_size) {
         value_dense_.reserve(in_size);
+        index_dense_.reserve(in_size);
     }
 
     WNODISCARD bool Contains(size_t in_index) const {
-        return index_pos_map_.contains(in_index);
+        return index_pos_map_.Contains(in_index);
     }
 
     constexpr Iterator begin() noexcept {
@@ -182,12 +210,12 @@ public:
 
     auto IterIndexes() const {
         return ConstIndexIterator(
-            index_pos_map_.cbegin(),
-            index_pos_map_.cend(),
+            index_dense_.cbegin(),
+            index_dense_.cend(),
             [] (auto & _it, const std::int32_t & _i) -> const size_t & {
-                return (*_it).first;
+                return *_it;
             },
-            [](auto & _it, const std::int32_t & _i) -> IndexPosType::const_iterator {
+            [](auto & _it, const std::int32_t & _i) -> typename IndexDenseType::const_iterator {
                 _it++;
                 return _it;
             }
@@ -200,8 +228,8 @@ public:
 
 private:
 
-    std::unordered_map<std::size_t, std::size_t> index_pos_map_;
-    std::vector<std::size_t, IndexAllocator> index_dense_;
+    IndexPolicy index_pos_map_;
+    IndexDenseType index_dense_;
     std::vector<T, ValueAllocator> value_dense_;
 
 };
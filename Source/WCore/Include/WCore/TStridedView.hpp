@@ -0,0 +1,70 @@
+#pragma once
+
+#include "WCore/WCoreMacros.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Type erased view of a dense array of objects accessed as B.
+ * Element i is at Data() + i * Stride() bytes, Stride() is the size of the stored type.
+ * Lets callers walk a container without knowing the stored type,
+ * and without a virtual call per element.
+ */
+template<typename B>
+class TStridedView {
+public:
+
+    using ByteType = std::conditional_t<std::is_const_v<B>, const std::byte, std::byte>;
+
+public:
+
+    constexpr TStridedView() noexcept = default;
+
+    constexpr TStridedView(B * in_data, std::size_t in_stride, std::size_t in_count) noexcept :
+        data_(in_data),
+        stride_(in_stride),
+        count_(in_count) {}
+
+    WNODISCARD constexpr B * Data() const noexcept {
+        return data_;
+    }
+
+    WNODISCARD constexpr std::size_t Stride() const noexcept {
+        return stride_;
+    }
+
+    WNODISCARD constexpr std::size_t Count() const noexcept {
+        return count_;
+    }
+
+    WNODISCARD constexpr bool Empty() const noexcept {
+        return count_ == 0;
+    }
+
+    HOT B * operator[](std::size_t in_pos) const noexcept {
+        return reinterpret_cast<B *>(
+            reinterpret_cast<ByteType *>(data_) + in_pos * stride_
+            );
+    }
+
+    /**
+     * @brief Run in_fn(B*) for each element.
+     */
+    template<typename TFn>
+    HOT void ForEach(TFn && in_fn) const {
+        ByteType * ptr = reinterpret_cast<ByteType *>(data_);
+        for (std::size_t i=0; i < count_; i++, ptr += stride_) {
+            in_fn(reinterpret_cast<B *>(ptr));
+        }
+    }
+
+private:
+
+    B * data_{nullptr};
+
+    std::size_t stride_{0};
+
+    std::size_t count_{0};
+
+};
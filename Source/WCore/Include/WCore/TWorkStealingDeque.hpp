@@ -0,0 +1,179 @@
+#pragma once
+
+#include "WCore/WCoreMacros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Chase-Lev work stealing deque.
+ * The owner thread Push and Pop from the bottom, any other thread Steal from the top.
+ * The buffer grows when full, replaced buffers are kept until destruction
+ * so a concurrent Steal never reads released memory.
+ */
+template<typename T>
+class TWorkStealingDeque {
+
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "TWorkStealingDeque values must be trivially copyable.");
+
+private:
+
+    struct Buffer {
+
+        explicit Buffer(std::size_t in_capacity) :
+            capacity(in_capacity),
+            mask(in_capacity - 1),
+            data(std::make_unique<std::atomic<T>[]>(in_capacity)) {}
+
+        T Load(std::int64_t in_pos) const noexcept {
+            return data[static_cast<std::size_t>(in_pos) & mask].load(std::memory_order_relaxed);
+        }
+
+        void Store(std::int64_t in_pos, T in_value) noexcept {
+            data[static_cast<std::size_t>(in_pos) & mask].store(in_value, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity;
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> data;
+    };
+
+public:
+
+    /**
+     * @brief in_capacity is rounded up to a power of two.
+     */
+    explicit TWorkStealingDeque(std::size_t in_capacity=256) {
+        std::size_t capacity = 1;
+        while (capacity < in_capacity) capacity <<= 1;
+
+        buffers_.push_back(std::make_unique<Buffer>(capacity));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    TWorkStealingDeque(const TWorkStealingDeque &) = delete;
+
+    TWorkStealingDeque(TWorkStealingDeque &&) = delete;
+
+    TWorkStealingDeque & operator=(const TWorkStealingDeque &) = delete;
+
+    TWorkStealingDeque & operator=(TWorkStealingDeque &&) = delete;
+
+    ~TWorkStealingDeque() = default;
+
+    /**
+     * @brief Owner thread only.
+     */
+    void Push(T in_value) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        Buffer * buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<std::int64_t>(buffer->capacity) - 1) {
+            buffer = Grow(buffer, b, t);
+        }
+
+        buffer->Store(b, in_value);
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Owner thread only, takes the last pushed value.
+     */
+    WNODISCARD bool Pop(T & out_value) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer * buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out_value = buffer->Load(b);
+
+        if (t == b) {
+            // Last value, race against thieves.
+            bool won = top_.compare_exchange_strong(t, t + 1,
+                                                    std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Any thread, takes the oldest value.
+     */
+    WNODISCARD bool Steal(T & out_value) {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return false;
+        }
+
+        Buffer * buffer = buffer_.load(std::memory_order_acquire);
+        T value = buffer->Load(t);
+
+        if (!top_.compare_exchange_strong(t, t + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return false;
+        }
+
+        out_value = value;
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of values, exact only from the owner with no thieves.
+     */
+    WNODISCARD std::size_t Count() const noexcept {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    WNODISCARD bool Empty() const noexcept {
+        return Count() == 0;
+    }
+
+    WNODISCARD std::size_t Capacity() const noexcept {
+        return buffer_.load(std::memory_order_relaxed)->capacity;
+    }
+
+private:
+
+    Buffer * Grow(Buffer * in_buffer, std::int64_t in_bottom, std::int64_t in_top) {
+        buffers_.push_back(std::make_unique<Buffer>(in_buffer->capacity * 2));
+        Buffer * buffer = buffers_.back().get();
+
+        for (std::int64_t i = in_top; i < in_bottom; i++) {
+            buffer->Store(i, in_buffer->Load(i));
+        }
+
+        buffer_.store(buffer, std::memory_order_release);
+        return buffer;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top_{0};
+
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+
+    alignas(64) std::atomic<Buffer *> buffer_{nullptr};
+
+    // Owner thread only.
+    std::vector<std::unique_ptr<Buffer>> buffers_{};
+
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "WCore/WCoreMacros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Growable byte buffer, values are appended with their native layout.
+ * Sizes are written as std::uint64_t.
+ */
+class WBinaryWriter {
+public:
+
+    WBinaryWriter() noexcept = default;
+
+    /**
+     * @brief Append in_size uninitialized bytes, the pointer is valid until the next write.
+     */
+    std::byte * Append(std::size_t in_size) {
+        std::size_t pos = bytes_.size();
+        bytes_.resize(pos + in_size);
+        return bytes_.data() + pos;
+    }
+
+    void Write(const void * in_data, std::size_t in_size) {
+        if (in_size == 0) return;
+        std::memcpy(Append(in_size), in_data, in_size);
+    }
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    void Write(const T & in_value) {
+        Write(&in_value, sizeof(T));
+    }
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    void WriteSpan(std::span<const T> in_values) {
+        Write(static_cast<std::uint64_t>(in_values.size()));
+        Write(in_values.data(), in_values.size_bytes());
+    }
+
+    void WriteString(std::string_view in_value) {
+        WriteSpan(std::span<const char>(in_value.data(), in_value.size()));
+    }
+
+    /**
+     * @brief Overwrite a value written at in_position, used to fill sizes known after writing.
+     */
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    void Patch(std::size_t in_position, const T & in_value) {
+        std::memcpy(bytes_.data() + in_position, &in_value, sizeof(T));
+    }
+
+    void Reserve(std::size_t in_size) {
+        bytes_.reserve(in_size);
+    }
+
+    WNODISCARD std::size_t Size() const noexcept {
+        return bytes_.size();
+    }
+
+    WNODISCARD std::span<const std::byte> Bytes() const noexcept {
+        return bytes_;
+    }
+
+    /**
+     * @brief Write the buffer to in_path, throws std::runtime_error on failure.
+     */
+    void Save(const std::string & in_path) const {
+        std::ofstream file(in_path, std::ios::binary | std::ios::trunc);
+
+        file.write(reinterpret_cast<const char *>(bytes_.data()),
+                   static_cast<std::streamsize>(bytes_.size()));
+
+        if (!file) {
+            throw std::runtime_error(std::format("Can't write {}.", in_path));
+        }
+    }
+
+private:
+
+    std::vector<std::byte> bytes_{};
+
+};
+
+/**
+ * @brief Reads values written by WBinaryWriter from a byte range it doesn't own.
+ * Reading past the end throws std::runtime_error.
+ */
+class WBinaryReader {
+public:
+
+    WBinaryReader() noexcept = default;
+
+    explicit WBinaryReader(std::span<const std::byte> in_bytes) noexcept :
+        bytes_(in_bytes) {}
+
+    /**
+     * @brief Next in_size bytes, they point into the read range.
+     */
+    const std::byte * Take(std::size_t in_size) {
+        if (in_size > bytes_.size() - position_) {
+            throw std::runtime_error(
+                std::format("Binary read of {} bytes at {} is out of range ({} bytes).",
+                            in_size, position_, bytes_.size()));
+        }
+
+        const std::byte * result = bytes_.data() + position_;
+        position_ += in_size;
+
+        return result;
+    }
+
+    void Read(void * out_data, std::size_t in_size) {
+        if (in_size == 0) return;
+        std::memcpy(out_data, Take(in_size), in_size);
+    }
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    T Read() {
+        T result;
+        Read(&result, sizeof(T));
+        return result;
+    }
+
+    /**
+     * @brief Size written by WBinaryWriter::WriteSpan, checked against the remaining bytes.
+     */
+    std::size_t ReadCount(std::size_t in_element_size) {
+        std::uint64_t count = Read<std::uint64_t>();
+
+        if (in_element_size != 0 && count > Remaining() / in_element_size) {
+            throw std::runtime_error(
+                std::format("Binary count {} at {} is out of range.", count, position_));
+        }
+
+        return static_cast<std::size_t>(count);
+    }
+
+    std::string_view ReadString() {
+        std::size_t size = ReadCount(1);
+        return {reinterpret_cast<const char *>(Take(size)), size};
+    }
+
+    /**
+     * @brief Reader over the next in_size bytes, this reader skips them.
+     */
+    WBinaryReader Sub(std::size_t in_size) {
+        return WBinaryReader({Take(in_size), in_size});
+    }
+
+    void Skip(std::size_t in_size) {
+        Take(in_size);
+    }
+
+    WNODISCARD std::size_t Position() const noexcept {
+        return position_;
+    }
+
+    WNODISCARD std::size_t Remaining() const noexcept {
+        return bytes_.size() - position_;
+    }
+
+private:
+
+    std::span<const std::byte> bytes_{};
+
+    std::size_t position_{0};
+
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "WCore/WCoreMacros.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Fast non cryptographic hashing of byte ranges, for content keys and checksums.
+ */
+namespace wcr::hash {
+
+    namespace detail {
+
+        inline constexpr std::uint64_t PRIME64_1{0x9E3779B185EBCA87ULL};
+        inline constexpr std::uint64_t PRIME64_2{0xC2B2AE3D27D4EB4FULL};
+        inline constexpr std::uint64_t PRIME64_3{0x165667B19E3779F9ULL};
+        inline constexpr std::uint64_t PRIME64_4{0x85EBCA77C2B2AE63ULL};
+        inline constexpr std::uint64_t PRIME64_5{0x27D4EB2F165667C5ULL};
+
+        inline std::uint64_t Read64(const std::byte * in_ptr) noexcept {
+            std::uint64_t result;
+            std::memcpy(&result, in_ptr, sizeof(result));
+            return result;
+        }
+
+        inline std::uint32_t Read32(const std::byte * in_ptr) noexcept {
+            std::uint32_t result;
+            std::memcpy(&result, in_ptr, sizeof(result));
+            return result;
+        }
+
+        inline std::uint64_t Round(std::uint64_t in_acc, std::uint64_t in_input) noexcept {
+            in_acc += in_input * PRIME64_2;
+            return std::rotl(in_acc, 31) * PRIME64_1;
+        }
+
+        inline std::uint64_t MergeRound(std::uint64_t in_acc, std::uint64_t in_value) noexcept {
+            in_acc ^= Round(0, in_value);
+            return in_acc * PRIME64_1 + PRIME64_4;
+        }
+
+    }
+
+    /**
+     * @brief XXH64 of in_bytes, the same values as the reference xxHash implementation
+     * (on little endian platforms).
+     */
+    inline std::uint64_t Hash64(std::span<const std::byte> in_bytes, std::uint64_t in_seed=0) noexcept {
+        using namespace detail;
+
+        static_assert(std::endian::native == std::endian::little,
+                      "Hash64 reads little endian words.");
+
+        const std::byte * ptr = in_bytes.data();
+        const std::byte * end = ptr + in_bytes.size();
+
+        std::uint64_t h;
+
+        if (in_bytes.size() >= 32) {
+            std::uint64_t v1 = in_seed + PRIME64_1 + PRIME64_2;
+            std::uint64_t v2 = in_seed + PRIME64_2;
+            std::uint64_t v3 = in_seed;
+            std::uint64_t v4 = in_seed - PRIME64_1;
+
+            // 32 bytes stripes, four independent lanes.
+            const std::byte * limit = end - 32;
+            do {
+                v1 = Round(v1, Read64(ptr));
+                v2 = Round(v2, Read64(ptr + 8));
+                v3 = Round(v3, Read64(ptr + 16));
+                v4 = Round(v4, Read64(ptr + 24));
+                ptr += 32;
+            } while (ptr <= limit);
+
+            h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            h = MergeRound(h, v1);
+            h = MergeRound(h, v2);
+            h = MergeRound(h, v3);
+            h = MergeRound(h, v4);
+        }
+        else {
+            h = in_seed + PRIME64_5;
+        }
+
+        h += static_cast<std::uint64_t>(in_bytes.size());
+
+        while (end - ptr >= 8) {
+            h ^= Round(0, Read64(ptr));
+            h = std::rotl(h, 27) * PRIME64_1 + PRIME64_4;
+            ptr += 8;
+        }
+
+        if (end - ptr >= 4) {
+            h ^= static_cast<std::uint64_t>(Read32(ptr)) * PRIME64_1;
+            h = std::rotl(h, 23) * PRIME64_2 + PRIME64_3;
+            ptr += 4;
+        }
+
+        while (ptr < end) {
+            h ^= static_cast<std::uint64_t>(*ptr) * PRIME64_5;
+            h = std::rotl(h, 11) * PRIME64_1;
+            ptr++;
+        }
+
+        h ^= h >> 33;
+        h *= PRIME64_2;
+        h ^= h >> 29;
+        h *= PRIME64_3;
+        h ^= h >> 32;
+
+        return h;
+    }
+
+    inline std::uint64_t Hash64(std::string_view in_value, std::uint64_t in_seed=0) noexcept {
+        return Hash64(std::as_bytes(std::span<const char>(in_value.data(), in_value.size())), in_seed);
+    }
+
+    /**
+     * @brief Hash of in_values packed one after the other, to combine hashes, versions, flags...
+     * Values without padding bytes only, so equal values always give the same hash.
+     */
+    template<typename ...Args>
+    requires (std::has_unique_object_representations_v<Args> && ...)
+    std::uint64_t HashValues(std::uint64_t in_seed, const Args & ... in_values) noexcept {
+        std::byte bytes[(sizeof(Args) + ... + 0) + 1]{};
+        std::size_t offset = 0;
+
+        ((std::memcpy(bytes + offset, &in_values, sizeof(Args)), offset += sizeof(Args)), ...);
+
+        return Hash64(std::span<const std::byte>(bytes, offset), in_seed);
+    }
+
+}
@@ -257,6 +257,50 @@ namespace wcr::wid {
 
     }
 
+// ---------
+// WEntityId
+// ---------
+
+    /**
+     * @brief WEntityId values pack a slot index (low bits) and a generation (high bits).
+     * The generation changes each time a slot index is recycled,
+     * so an id kept after its entity was removed never aliases a new entity.
+     */
+    struct WEntityId_Meta {
+        static constexpr std::uint8_t INDEX_BITS_SIZE{22};
+        static constexpr std::uint8_t GENERATION_BITS_SIZE{9};
+
+        static_assert(INDEX_BITS_SIZE + GENERATION_BITS_SIZE <= sizeof(WEntityId::IdType) * 8);
+
+        static constexpr WEntityId::IdType INDEX_MASK =
+            static_cast<WEntityId::IdType>(GenBitMask(INDEX_BITS_SIZE));
+
+        static constexpr WEntityId::IdType GENERATION_MASK =
+            static_cast<WEntityId::IdType>(GenBitMask(GENERATION_BITS_SIZE));
+
+        static constexpr WEntityId::IdType MAX_INDEX = INDEX_MASK;
+
+        static constexpr WEntityId Compose(WEntityId::IdType in_index,
+                                           WEntityId::IdType in_generation) noexcept {
+            return WEntityId(
+                (in_index & INDEX_MASK) |
+                ((in_generation & GENERATION_MASK) << INDEX_BITS_SIZE)
+                );
+        }
+
+        static constexpr WEntityId::IdType Index(WEntityId in_id) noexcept {
+            return in_id.GetId() & INDEX_MASK;
+        }
+
+        static constexpr WEntityId::IdType Generation(WEntityId in_id) noexcept {
+            return (in_id.GetId() >> INDEX_BITS_SIZE) & GENERATION_MASK;
+        }
+
+        static constexpr WEntityId::IdType NextGeneration(WEntityId::IdType in_generation) noexcept {
+            return (in_generation + 1) & GENERATION_MASK;
+        }
+    };
+
 // ------------------
 // WEntityComponentId
 // ------------------
@@ -269,7 +313,10 @@ namespace wcr::wid {
 
     struct WEntityComponentId_Meta{
         static constexpr std::uint8_t LEVEL_BITS_SIZE{16};
-        static constexpr std::uint8_t ENTITY_BITS_SIZE{22};
+        // Index and generation bits of WEntityId
+        static constexpr std::uint8_t ENTITY_BITS_SIZE{
+            WEntityId_Meta::INDEX_BITS_SIZE + WEntityId_Meta::GENERATION_BITS_SIZE
+        };
         static constexpr std::uint8_t COMPONENT_BITS_SIZE{8};
         static constexpr std::uint8_t SUBINDEX_BITS_SIZE{5};
 
@@ -599,7 +646,7 @@ namespace wcr::wid {
             id_ |= WLevelSystemId_Meta::BitMaskV<WSystemId> & in_system_id.GetId();
         }
 
-        void ExtractWIds(WAssetId out_asset_id, WSystemId out_system_id) const {
+        void ExtractWIds(WAssetId & out_asset_id, WSystemId & out_system_id) const {
             IdType idcpy = id_;
 
             WAssetId::IdType asset_id=WAssetId(null_id).GetId();
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "WCore/WCoreMacros.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Read only memory mapped file, unmapped on destruction.
+ * Without mmap support (Windows) the file is read into memory.
+ */
+class WMappedFile {
+public:
+
+    WMappedFile() noexcept = default;
+
+    WMappedFile(const WMappedFile &) = delete;
+
+    WMappedFile & operator=(const WMappedFile &) = delete;
+
+    WMappedFile(WMappedFile && other) noexcept {
+        *this = std::move(other);
+    }
+
+    WMappedFile & operator=(WMappedFile && other) noexcept {
+        if (this != &other) {
+            Close();
+
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+            buffer_ = std::move(other.buffer_);
+#endif
+        }
+
+        return *this;
+    }
+
+    ~WMappedFile() {
+        Close();
+    }
+
+    /**
+     * @brief Map in_path, closes the previous file.
+     * @return false if the file can't be opened or is empty.
+     */
+    bool Open(const std::string & in_path) {
+        Close();
+
+#ifdef _WIN32
+        std::ifstream file(in_path, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+
+        buffer_.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(buffer_.data()), buffer_.size());
+
+        if (!file || buffer_.empty()) {
+            buffer_.clear();
+            return false;
+        }
+
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#else
+        int fd = ::open(in_path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void * ptr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping stays valid after closing the descriptor.
+        ::close(fd);
+
+        if (ptr == MAP_FAILED) return false;
+
+        data_ = static_cast<const std::byte *>(ptr);
+        size_ = static_cast<std::size_t>(st.st_size);
+#endif
+
+        return true;
+    }
+
+    void Close() noexcept {
+#ifdef _WIN32
+        buffer_.clear();
+#else
+        if (data_) {
+            ::munmap(const_cast<std::byte *>(data_), size_);
+        }
+#endif
+
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    WNODISCARD bool IsOpen() const noexcept {
+        return data_ != nullptr;
+    }
+
+    WNODISCARD const std::byte * Data() const noexcept {
+        return data_;
+    }
+
+    WNODISCARD std::size_t Size() const noexcept {
+        return size_;
+    }
+
+    WNODISCARD std::span<const std::byte> Bytes() const noexcept {
+        return {data_, size_};
+    }
+
+private:
+
+    const std::byte * data_{nullptr};
+
+    std::size_t size_{0};
+
+#ifdef _WIN32
+    std::vector<std::byte> buffer_{};
+#endif
+
+};
@@ -1,5 +1,503 @@
 #pragma once
 
+#include "WCore/WCoreMacros.hpp"
+#include "WCore/WConcepts.hpp"
+#include "WCore/TWorkStealingDeque.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cassert>
+
 namespace WThreadLib {
-    
+
+    class WJobSystem;
+
+    /**
+     * @brief Number of unfinished jobs, wait on it with WJobSystem::Wait.
+     */
+    class WJobCounter {
+    public:
+
+        WJobCounter() noexcept = default;
+
+        WJobCounter(const WJobCounter &) = delete;
+
+        WJobCounter & operator=(const WJobCounter &) = delete;
+
+        void Add(std::uint32_t in_count=1) noexcept {
+            count_.fetch_add(in_count, std::memory_order_relaxed);
+        }
+
+        void Done() noexcept {
+            count_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        WNODISCARD std::uint32_t Count() const noexcept {
+            return count_.load(std::memory_order_acquire);
+        }
+
+        WNODISCARD bool IsDone() const noexcept {
+            return Count() == 0;
+        }
+
+    private:
+
+        std::atomic<std::uint32_t> count_{0};
+
+    };
+
+    /**
+     * @brief Scheduled job state, shared by the scheduler and the job handles.
+     */
+    struct WJob {
+        std::function<void()> fn{};
+
+        // Unfinished dependencies, plus one while the job is being scheduled.
+        std::atomic<std::uint32_t> pending{1};
+
+        std::atomic<bool> finished{false};
+
+        // Guards finished transition and continuations.
+        std::mutex mutex{};
+
+        std::vector<std::shared_ptr<WJob>> continuations{};
+
+        WJobCounter * counter{nullptr};
+
+        // Keeps the job alive while it is queued.
+        std::shared_ptr<WJob> self{};
+    };
+
+    /**
+     * @brief Handle to a scheduled job, use it to wait or as a dependency.
+     */
+    class WJobHandle {
+    public:
+
+        WJobHandle() noexcept = default;
+
+        explicit WJobHandle(std::shared_ptr<WJob> in_job) noexcept :
+            job_(std::move(in_job)) {}
+
+        WNODISCARD bool IsValid() const noexcept {
+            return job_ != nullptr;
+        }
+
+        /**
+         * @brief True when the job has run. An empty handle is always done.
+         */
+        WNODISCARD bool IsDone() const noexcept {
+            return !job_ || job_->finished.load(std::memory_order_acquire);
+        }
+
+    private:
+
+        friend class WJobSystem;
+
+        std::shared_ptr<WJob> job_{};
+
+    };
+
+    /**
+     * @brief Work stealing thread pool.
+     * Each worker owns a Chase-Lev deque, jobs scheduled from a worker go to its deque
+     * and jobs scheduled from other threads go to a shared injection queue.
+     * Idle workers steal from the other workers, waiting threads run pending jobs
+     * while the waited job or counter is not done.
+     * Jobs must not throw.
+     */
+    class WJobSystem {
+    public:
+
+        static constexpr std::size_t NONE_WORKER = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * @brief Hardware threads minus the calling thread, which helps while waiting.
+         */
+        static std::size_t DefaultWorkerCount() noexcept {
+            std::size_t hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 0;
+        }
+
+    public:
+
+        /**
+         * @brief With zero workers jobs only run inside Wait calls.
+         */
+        explicit WJobSystem(std::size_t in_workers=DefaultWorkerCount()) {
+            deques_.reserve(in_workers);
+            for (std::size_t i=0; i < in_workers; i++) {
+                deques_.push_back(std::make_unique<TWorkStealingDeque<WJob*>>());
+            }
+
+            threads_.reserve(in_workers);
+            for (std::size_t i=0; i < in_workers; i++) {
+                threads_.emplace_back([this, i]() { WorkerMain(i); });
+            }
+        }
+
+        WJobSystem(const WJobSystem &) = delete;
+
+        WJobSystem(WJobSystem &&) = delete;
+
+        WJobSystem & operator=(const WJobSystem &) = delete;
+
+        WJobSystem & operator=(WJobSystem &&) = delete;
+
+        /**
+         * @brief Runs the queued jobs and joins the workers.
+         */
+        ~WJobSystem() {
+            stop_.store(true, std::memory_order_seq_cst);
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            epoch_.notify_all();
+
+            for (auto & t : threads_) {
+                t.join();
+            }
+
+            while (RunPending()) {}
+        }
+
+        WNODISCARD std::size_t WorkerCount() const noexcept {
+            return threads_.size();
+        }
+
+        /**
+         * @brief Index of the calling worker, NONE_WORKER when called from other threads.
+         */
+        WNODISCARD std::size_t WorkerIndex() const noexcept {
+            return tls_system_ == this ? tls_worker_ : NONE_WORKER;
+        }
+
+        /**
+         * @brief Schedule in_fn to run after all in_dependencies are done.
+         * in_counter (optional) is incremented now and decremented after in_fn runs.
+         */
+        template<CCallable<void> TFn>
+        WJobHandle Schedule(TFn && in_fn,
+                            std::span<const WJobHandle> in_dependencies,
+                            WJobCounter * in_counter=nullptr) {
+            auto job = std::make_shared<WJob>();
+            job->fn = std::forward<TFn>(in_fn);
+            job->counter = in_counter;
+            job->self = job;
+
+            if (in_counter) {
+                in_counter->Add();
+            }
+
+            for (auto & dep : in_dependencies) {
+                if (!dep.job_) continue;
+
+                std::lock_guard lock(dep.job_->mutex);
+                if (!dep.job_->finished.load(std::memory_order_relaxed)) {
+                    job->pending.fetch_add(1, std::memory_order_relaxed);
+                    dep.job_->continuations.push_back(job);
+                }
+            }
+
+            WJobHandle handle(job);
+            Release(job.get());
+
+            return handle;
+        }
+
+        template<CCallable<void> TFn>
+        WJobHandle Schedule(TFn && in_fn,
+                            std::initializer_list<WJobHandle> in_dependencies={},
+                            WJobCounter * in_counter=nullptr) {
+            return Schedule(std::forward<TFn>(in_fn),
+                            std::span<const WJobHandle>(in_dependencies.begin(), in_dependencies.size()),
+                            in_counter);
+        }
+
+        template<CCallable<void> TFn>
+        WJobHandle Schedule(TFn && in_fn, WJobCounter & in_counter) {
+            return Schedule(std::forward<TFn>(in_fn), {}, &in_counter);
+        }
+
+        /**
+         * @brief Run pending jobs until in_handle is done.
+         */
+        void Wait(const WJobHandle & in_handle) {
+            WaitUntil([&in_handle]() { return in_handle.IsDone(); });
+        }
+
+        /**
+         * @brief Run pending jobs until in_counter reaches zero.
+         */
+        void Wait(const WJobCounter & in_counter) {
+            WaitUntil([&in_counter]() { return in_counter.IsDone(); });
+        }
+
+        /**
+         * @brief Run one pending job in the calling thread.
+         * @return false if there was no job to run.
+         */
+        bool RunPending() {
+            WJob * job = FindJob(WorkerIndex());
+            if (!job) return false;
+
+            Execute(job);
+            return true;
+        }
+
+        /**
+         * @brief Run in_fn(begin, end) over [in_begin, in_end) split in ranges
+         * of at most in_grain indexes. The calling thread takes part and returns when all ranges are done.
+         */
+        template<CCallable<void, std::size_t, std::size_t> TFn>
+        void ParallelForRange(std::size_t in_begin,
+                              std::size_t in_end,
+                              std::size_t in_grain,
+                              TFn && in_fn) {
+            if (in_end <= in_begin) return;
+
+            in_grain = std::max<std::size_t>(in_grain, 1);
+
+            if (threads_.empty() || in_end - in_begin <= in_grain) {
+                in_fn(in_begin, in_end);
+                return;
+            }
+
+            WJobCounter counter;
+            SplitRange(in_begin, in_end, in_grain, in_fn, counter);
+            Wait(counter);
+        }
+
+        template<CCallable<void, std::size_t, std::size_t> TFn>
+        void ParallelForRange(std::size_t in_begin, std::size_t in_end, TFn && in_fn) {
+            ParallelForRange(in_begin, in_end, DefaultGrain(in_end - in_begin), std::forward<TFn>(in_fn));
+        }
+
+        /**
+         * @brief Run in_fn(i) for each index in [in_begin, in_end), see ParallelForRange.
+         */
+        template<CCallable<void, std::size_t> TFn>
+        void ParallelFor(std::size_t in_begin,
+                         std::size_t in_end,
+                         std::size_t in_grain,
+                         TFn && in_fn) {
+            ParallelForRange(in_begin, in_end, in_grain,
+                             [&in_fn](std::size_t _begin, std::size_t _end) {
+                                 for (std::size_t i=_begin; i < _end; i++) {
+                                     in_fn(i);
+                                 }
+                             });
+        }
+
+        template<CCallable<void, std::size_t> TFn>
+        void ParallelFor(std::size_t in_begin, std::size_t in_end, TFn && in_fn) {
+            ParallelFor(in_begin, in_end, DefaultGrain(in_end - in_begin), std::forward<TFn>(in_fn));
+        }
+
+        /**
+         * @brief Grain giving around 8 ranges per thread.
+         */
+        WNODISCARD std::size_t DefaultGrain(std::size_t in_count) const noexcept {
+            return std::max<std::size_t>(1, in_count / (8 * (threads_.size() + 1)));
+        }
+
+    private:
+
+        // Idle rounds before a worker sleeps.
+        static constexpr std::uint32_t SPIN_ROUNDS = 64;
+
+        template<typename TFn>
+        void SplitRange(std::size_t in_begin,
+                        std::size_t in_end,
+                        std::size_t in_grain,
+                        TFn & in_fn,
+                        WJobCounter & in_counter) {
+            // Push the upper halves so thieves take the biggest ranges.
+            while (in_end - in_begin > in_grain) {
+                std::size_t mid = in_begin + (in_end - in_begin) / 2;
+
+                Schedule([this, mid, in_end, in_grain, &in_fn, &in_counter]() {
+                    SplitRange(mid, in_end, in_grain, in_fn, in_counter);
+                }, {}, &in_counter);
+
+                in_end = mid;
+            }
+
+            in_fn(in_begin, in_end);
+        }
+
+        template<typename TPred>
+        void WaitUntil(TPred && in_done) {
+            while (!in_done()) {
+                if (!RunPending()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void Release(WJob * in_job) {
+            if (in_job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Enqueue(in_job);
+            }
+        }
+
+        void Enqueue(WJob * in_job) {
+            std::size_t worker = WorkerIndex();
+
+            if (worker != NONE_WORKER) {
+                deques_[worker]->Push(in_job);
+            }
+            else {
+                std::lock_guard lock(injection_mutex_);
+                injection_.push_back(in_job);
+                injection_count_.fetch_add(1, std::memory_order_release);
+            }
+
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_seq_cst) > 0) {
+                epoch_.notify_one();
+            }
+        }
+
+        WJob * FindJob(std::size_t in_worker) {
+            WJob * job = nullptr;
+
+            if (in_worker != NONE_WORKER && deques_[in_worker]->Pop(job)) {
+                return job;
+            }
+
+            if (injection_count_.load(std::memory_order_acquire) > 0) {
+                std::lock_guard lock(injection_mutex_);
+                if (!injection_.empty()) {
+                    job = injection_.front();
+                    injection_.pop_front();
+                    injection_count_.fetch_sub(1, std::memory_order_relaxed);
+                    return job;
+                }
+            }
+
+            std::size_t count = deques_.size();
+            if (count == 0) return nullptr;
+
+            std::size_t start = NextRandom() % count;
+            for (std::size_t i=0; i < count; i++) {
+                std::size_t victim = (start + i) % count;
+                if (victim == in_worker) continue;
+
+                if (deques_[victim]->Steal(job)) {
+                    return job;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void Execute(WJob * in_job) {
+            std::shared_ptr<WJob> keep = std::move(in_job->self);
+
+            in_job->fn();
+            in_job->fn = nullptr;
+
+            std::vector<std::shared_ptr<WJob>> next;
+            {
+                std::lock_guard lock(in_job->mutex);
+                in_job->finished.store(true, std::memory_order_release);
+                next.swap(in_job->continuations);
+            }
+
+            if (in_job->counter) {
+                in_job->counter->Done();
+            }
+
+            for (auto & n : next) {
+                Release(n.get());
+            }
+        }
+
+        void WorkerMain(std::size_t in_worker) {
+            tls_system_ = this;
+            tls_worker_ = in_worker;
+
+            std::uint32_t idle = 0;
+            while (true) {
+                std::uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+
+                if (WJob * job = FindJob(in_worker)) {
+                    Execute(job);
+                    idle = 0;
+                    continue;
+                }
+
+                if (stop_.load(std::memory_order_seq_cst)) {
+                    break;
+                }
+
+                if (++idle < SPIN_ROUNDS) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                sleeping_.fetch_add(1, std::memory_order_seq_cst);
+                epoch_.wait(epoch, std::memory_order_seq_cst);
+                sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+                idle = 0;
+            }
+
+            tls_system_ = nullptr;
+            tls_worker_ = NONE_WORKER;
+        }
+
+        static std::uint64_t NextRandom() noexcept {
+            // xorshift64, seeded per thread.
+            static thread_local std::uint64_t state =
+                std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        static inline thread_local WJobSystem * tls_system_{nullptr};
+
+        static inline thread_local std::size_t tls_worker_{NONE_WORKER};
+
+        std::vector<std::unique_ptr<TWorkStealingDeque<WJob*>>> deques_{};
+
+        std::vector<std::thread> threads_{};
+
+        std::mutex injection_mutex_{};
+
+        std::deque<WJob*> injection_{};
+
+        std::atomic<std::size_t> injection_count_{0};
+
+        // Bumped on each enqueue, sleeping workers wait on it.
+        std::atomic<std::uint32_t> epoch_{0};
+
+        std::atomic<std::uint32_t> sleeping_{0};
+
+        std::atomic<bool> stop_{false};
+
+    };
+
+    /**
+     * @brief Job system shared by the engine subsystems,
+     * created on first use with DefaultWorkerCount workers.
+     */
+    inline WJobSystem & DefaultJobSystem() {
+        static WJobSystem job_system{};
+        return job_system;
+    }
+
 }
@@ -18,6 +18,28 @@ struct WEngineCycleStruct {
     double DeltaTime{0.0166};
     double TotalTime{0};
     std::uint32_t fps{60};
+
+    /** @brief Simulation step, pre systems advance this time on each tick. */
+    double FixedDeltaTime{1.0 / 60.0};
+    double SimulationTime{0};
+    /** @brief Simulation ticks run in the current frame. */
+    std::uint32_t SimulationTicks{0};
+    /** @brief Fraction of a step left in the accumulator, used to interpolate render state. */
+    double Alpha{0};
+};
+
+/**
+ * @brief Time spent in each stage of a frame, in milliseconds.
+ * draw is the time the main thread waits to publish the frame,
+ * render is the time the render thread spent in the last drawn frame.
+ */
+struct WFrameTimingsStruct {
+    std::uint32_t simulation_ticks{0};
+    double pre_systems{0};
+    double post_systems{0};
+    double draw{0};
+    double render{0};
+    double frame{0};
 };
 
 // TODO Move window related objets into a WDesktop/WApplication or WRender Module.
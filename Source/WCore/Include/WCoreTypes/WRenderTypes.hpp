@@ -13,6 +13,7 @@
 #include <glm/gtc/constants.hpp>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace wct::render {
 
@@ -327,6 +328,38 @@ namespace wct::render {
                   sizeof(glm::mat4) +
                   sizeof(glm::mat4) == sizeof(LightingUBO), "Size must match a Vulkan layout");
 
-    
+    // Frame Snapshot
+    // --------------
+
+    /**
+     * @brief Render data of one frame, extracted from the level by the post systems.
+     * Read only once published to the render thread.
+     */
+    struct RenderSnapshot {
+        std::uint64_t frame{0};
+
+        bool has_camera{false};
+        CameraUBO camera{};
+
+        std::vector<wcr::wid::WEntityComponentId> model_ids{};
+        std::vector<ModelUBO> models{};
+
+        std::vector<wcr::wid::WEntityComponentId> point_light_ids{};
+        std::vector<PointLight> point_lights{};
+
+        std::vector<wcr::wid::WEntityComponentId> directional_light_ids{};
+        std::vector<DirectionalLight> directional_lights{};
+
+        /** @brief Keeps the vectors capacity. */
+        void Clear() noexcept {
+            has_camera = false;
+            model_ids.clear();
+            models.clear();
+            point_light_ids.clear();
+            point_lights.clear();
+            directional_light_ids.clear();
+            directional_lights.clear();
+        }
+    };
 
 }
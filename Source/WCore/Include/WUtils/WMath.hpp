@@ -6,6 +6,7 @@
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/trigonometric.hpp>
 #include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include <cmath>
 #include <array>
@@ -98,6 +99,25 @@ namespace WMath {
 
     }
 
+    /**
+     * @brief Euler rotation to quaternion, following the rotation order.
+     */
+    inline glm::quat ToQuat(glm::vec3 in_euler_rotation,
+                            ERotationOrder in_rotation_order) {
+        return glm::quat_cast(
+            RotateMatrix(glm::mat3{1}, in_euler_rotation, in_rotation_order)
+            );
+    }
+
+    inline glm::mat4 ToMat4(glm::vec3 in_position,
+                            glm::quat in_rotation,
+                            glm::vec3 in_scale) {
+
+        return glm::translate(glm::mat4{1}, in_position) *
+            glm::mat4_cast(in_rotation) *
+            glm::scale(glm::mat4{1}, in_scale);
+    }
+
     /**
      * x is 0, y is 1, z is 2
      * Returns an array of 3 elements with a numeric translation of each axis
@@ -1,11 +1,23 @@
 #include "WCore/TObjectDataBase.hpp"
+#include "WCore/TSparseSet.hpp"
+#include "WCore/TChunkedSparseSet.hpp"
+#include "WCore/TSparseIndex.hpp"
+#include "WCore/IdPool.hpp"
 #include "WCore/WCore.hpp"
 #include "WCore/TWAllocator.hpp"
 #include "WCore/WId.hpp"
+#include "WCore/TWorkStealingDeque.hpp"
+#include "WCore/TMpscQueue.hpp"
+#include "WCore/TEvent.hpp"
+#include "WCore/TFunction.hpp"
+#include "WCore/TGenerator.hpp"
+#include "WCore/WHash.hpp"
+#include "WCore/WThreadLib.hpp"
 #include <functional>
 #include <string_view>
 
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 
 #include "WCore/TRef.hpp"
@@ -17,7 +29,18 @@
 #include <cstdio>
 #include <cstdint>
 #include <print>
+#include <array>
 #include <bitset> 
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <format>
+#include <stdexcept>
 
 struct B{};
 
@@ -117,6 +140,499 @@ bool WIDCompoundNullValue_Test() {
     return true;
 }
 
+bool IdPool_Test() {
+    wcr::IdPool<std::uint32_t> pool;
+
+    for (std::uint32_t i=1; i<=100; i++) {
+        if (pool.Generate() != i) return false;
+    }
+
+    // Release in a scattered order, ranges must merge back.
+    pool.AddToPool(50);
+    pool.AddToPool(52);
+    pool.AddToPool(51);
+    pool.ReleaseMany(std::vector<std::uint32_t>{10, 12, 11, 13, 90});
+
+    if (pool.RangeCount() != 4) return false;  // [10,13] [50,52] [90] [101,max]
+
+    pool.AddRangeToPool(14, 49);
+    if (pool.RangeCount() != 3) return false;  // [10,52] [90] [101,max]
+
+    // Extract must split the range.
+    pool.ExtractFromPool(30);
+    if (pool.IsFree(30) || !pool.IsFree(29) || !pool.IsFree(31)) return false;
+    if (pool.RangeCount() != 4) return false;
+
+    if (pool.Generate() != 10) return false;
+
+    wcr::IdPool<std::uint8_t> small_pool{{{.first=1, .last=3}}};
+    small_pool.Generate();
+    small_pool.Generate();
+    small_pool.Generate();
+
+    return small_pool.Empty();
+}
+
+template<typename IndexPolicy>
+bool TSparseSet_IndexPolicy_Test() {
+    TSparseSet<std::uint32_t,
+               std::allocator<std::uint32_t>,
+               std::allocator<std::size_t>,
+               IndexPolicy> sset;
+
+    for (std::uint32_t i=1; i<10000; i+=3) {
+        sset.Insert(i, i * 2);
+    }
+
+    for (std::uint32_t i=1; i<10000; i+=6) {
+        sset.Remove(i);
+    }
+
+    if (sset.Count() != 1666) return false;
+
+    for (std::uint32_t i=1; i<10000; i+=3) {
+        bool removed = (i - 1) % 6 == 0;
+        if (sset.Contains(i) == removed) return false;
+        if (!removed && sset.Get(i) != i * 2) return false;
+    }
+
+    // dense indexes and values must stay paired after removals.
+    bool paired = true;
+    sset.ForEach([&paired](std::size_t _idx, std::uint32_t & _v) {
+        paired = paired && _v == _idx * 2;
+    });
+
+    auto copy = sset;
+    sset.Clear();
+
+    return paired &&
+        !sset.Contains(4) &&
+        copy.Contains(4) &&
+        copy.Get(4) == 8;
+}
+
+bool TChunkedSparseSet_Test() {
+    // 64 bytes chunks, 16 values per chunk.
+    TChunkedSparseSet<std::uint32_t, 64, TSparsePagedIndex<>> sset;
+
+    sset.Insert(1, 2);
+    const std::uint32_t * first = &sset.Get(1);
+
+    for (std::uint32_t i=4; i<10000; i+=3) {
+        sset.Insert(i, i * 2);
+    }
+
+    // Growth must not move existing values.
+    if (first != &sset.Get(1)) return false;
+    if (sset.ChunkCount() != (sset.Count() + 15) / 16) return false;
+
+    for (std::uint32_t i=1; i<10000; i+=6) {
+        sset.Remove(i);
+    }
+
+    if (sset.Count() != 1666) return false;
+
+    bool paired = true;
+    sset.ForEach([&paired](std::size_t _idx, std::uint32_t & _v) {
+        paired = paired && _v == _idx * 2;
+    });
+
+    std::size_t count = 0;
+    for (auto & v : sset) {
+        paired = paired && sset.Get(sset.IndexAt(count)) == v;
+        count++;
+    }
+
+    auto copy = sset;
+    sset.Clear();
+
+    // Chunks are kept after Clear.
+    sset.Insert(7, 14);
+
+    return paired &&
+        count == 1666 &&
+        !sset.Contains(4) &&
+        sset.Get(7) == 14 &&
+        copy.Contains(4) &&
+        copy.Get(4) == 8;
+}
+
+bool TWorkStealingDeque_Test() {
+    // Small capacity to force growth.
+    TWorkStealingDeque<std::size_t> deque(4);
+
+    for (std::size_t i=0; i<100; i++) {
+        deque.Push(i);
+    }
+
+    if (deque.Count() != 100 || deque.Capacity() < 100) return false;
+
+    std::size_t value;
+
+    // Owner takes the newest, thieves the oldest.
+    if (!deque.Pop(value) || value != 99) return false;
+    if (!deque.Steal(value) || value != 0) return false;
+
+    std::size_t count = 2;
+    while (deque.Pop(value)) count++;
+
+    return count == 100 &&
+        deque.Empty() &&
+        !deque.Steal(value);
+}
+
+bool TMpscQueue_Test() {
+    constexpr std::size_t producers = 4;
+    constexpr std::size_t per_producer = 20'000;
+
+    // Small capacity, producers retry while the consumer drains.
+    TMpscQueue<std::uint64_t> queue(64);
+
+    std::vector<std::thread> threads;
+    for (std::size_t p=0; p<producers; p++) {
+        threads.emplace_back([&queue, p]() {
+            for (std::uint64_t i=0; i<per_producer; i++) {
+                while (!queue.Push((p << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Values of each producer arrive in push order.
+    std::vector<std::uint64_t> next(producers, 0);
+    bool ordered = true;
+    std::size_t count = 0;
+    std::uint64_t value;
+
+    while (count < producers * per_producer) {
+        if (!queue.Pop(value)) continue;
+
+        std::size_t p = value >> 32;
+        ordered = ordered && (value & 0xffffffff) == next[p]++;
+        count++;
+    }
+
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    return ordered &&
+        queue.Empty() &&
+        !queue.Pop(value);
+}
+
+bool TMpscQueue_Throw_Test() {
+    struct Throwing {
+        std::uint32_t value{0};
+
+        Throwing() = default;
+
+        explicit Throwing(std::uint32_t in_value) : value(in_value) {
+            if (in_value == 0) throw std::runtime_error("Throwing");
+        }
+    };
+
+    TMpscQueue<Throwing> queue(4);
+
+    bool pushed = queue.Emplace(1u);
+
+    bool thrown = false;
+    try {
+        (void) queue.Emplace(0u);
+    }
+    catch (const std::runtime_error &) {
+        thrown = true;
+    }
+
+    // A failed construction doesn't claim a cell, the consumer doesn't stall.
+    pushed = pushed && queue.Emplace(2u);
+
+    Throwing first, second;
+    bool popped = queue.Pop(first) && queue.Pop(second);
+
+    return pushed && thrown && popped &&
+        first.value == 1 &&
+        second.value == 2 &&
+        queue.Empty();
+}
+
+bool TInplaceFunction_Test() {
+    std::uint32_t calls = 0;
+    auto shared = std::make_shared<std::uint32_t>(3);
+
+    TInplaceFunction<std::uint32_t(std::uint32_t)> fn(
+        [&calls, shared](std::uint32_t _v) {
+            calls++;
+            return _v * *shared;
+        });
+
+    TInplaceFunction<std::uint32_t(std::uint32_t)> copy(fn);
+    TInplaceFunction<std::uint32_t(std::uint32_t)> moved(std::move(fn));
+
+    bool result = copy(2) == 6 &&
+        moved(3) == 9 &&
+        calls == 2 &&
+        fn.IsEmpty() &&
+        shared.use_count() == 3;
+
+    copy.Reset();
+    moved = nullptr;
+
+    return result &&
+        shared.use_count() == 1;
+}
+
+bool TEvent_Test() {
+    std::uint32_t sum = 0;
+
+    // Any std::function subscriber, whatever its capture size.
+    TEvent<void(std::uint32_t)> event;
+
+    std::array<std::uint32_t, 32> weights{};
+    weights.fill(2);
+
+    std::function<void(std::uint32_t)> existing = [&sum](std::uint32_t _v) { sum += _v; };
+
+    event.Subscribe(existing);
+    wcr::wid::WEventId id = event.Subscribe([&sum, weights](std::uint32_t _v) {
+        sum += _v * weights[0];
+    });
+
+    event.Emit(1u);
+    event.Unsubscribe(id);
+    event.Emit(1u);
+
+    // Small captures stored inline.
+    TInplaceEvent<void(std::uint32_t)> inplace_event;
+    inplace_event.Subscribe([&sum](std::uint32_t _v) { sum += _v * 10; });
+    inplace_event.Emit(1u);
+
+    return sum == 14;
+}
+
+bool TEventChannel_Test() {
+    TEventChannel<void(std::uint32_t, const std::string &)> channel(16);
+
+    std::vector<std::uint32_t> values;
+    std::size_t chars = 0;
+
+    channel.Subscribe([&values, &chars](std::uint32_t _v, const std::string & _s) {
+        values.push_back(_v);
+        chars += _s.size();
+    });
+
+    std::thread producer([&channel]() {
+        for (std::uint32_t i=0; i<8; i++) {
+            while (!channel.Post(i, std::string(i, 'x'))) {}
+        }
+    });
+    producer.join();
+
+    // Nothing runs until dispatched.
+    bool deferred = values.empty() && channel.Pending() == 8;
+
+    std::size_t count = channel.Dispatch();
+
+    return deferred &&
+        count == 8 &&
+        values == std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5, 6, 7} &&
+        chars == 28 &&
+        channel.Dispatch() == 0;
+}
+
+TGenerator<std::uint32_t> Range_Gen(std::uint32_t in_begin, std::uint32_t in_end) {
+    for (std::uint32_t i=in_begin; i<in_end; i++) {
+        co_yield i;
+    }
+}
+
+bool TGenerator_Test() {
+    std::vector<std::uint32_t> values;
+    for (std::uint32_t v : Range_Gen(2, 6)) {
+        values.push_back(v);
+    }
+
+    // Leaving the loop early destroys the suspended coroutine.
+    std::uint32_t first = 0;
+    for (std::uint32_t v : Range_Gen(10, 1'000'000)) {
+        first = v;
+        break;
+    }
+
+    TObjectDataBase<A, B, wcr::wid::WId<>::IdType> od{
+        [](wcr::wid::WId<>::IdType const &) ->A {return {};},
+        [](A const & )->void {}
+    };
+
+    od.InsertAt<A>(1, {});
+    od.InsertAt<A>(5, {});
+    od.InsertAt<A>(9, {});
+
+    const IObjectDataBase<B, wcr::wid::WId<>::IdType> & iod = od;
+
+    std::vector<wcr::wid::WId<>::IdType> ids;
+    for (auto id : iod.GenerateIndexes()) {
+        ids.push_back(id);
+    }
+
+    return values == std::vector<std::uint32_t>{2, 3, 4, 5} &&
+        first == 10 &&
+        ids == od.Indexes();
+}
+
+TTask<std::uint64_t> Sum_Task(WThreadLib::WJobSystem & in_job_system, std::uint64_t in_n) {
+    co_await WThreadLib::ScheduleOn(in_job_system);
+
+    std::uint64_t sum = 0;
+    for (std::uint64_t i=1; i<=in_n; i++) {
+        sum += i;
+    }
+
+    co_return sum;
+}
+
+TTask<std::uint64_t> Pipeline_Task(WThreadLib::WJobSystem & in_job_system) {
+    TTask<std::uint64_t> a = Sum_Task(in_job_system, 100);
+    TTask<std::uint64_t> b = Sum_Task(in_job_system, 1000);
+
+    std::uint64_t result = co_await a;
+    result += co_await b;
+
+    co_return result;
+}
+
+TTask<> Throw_Task() {
+    throw std::runtime_error("TTask error");
+    co_return;
+}
+
+bool TTask_Test(std::size_t in_workers) {
+    WThreadLib::WJobSystem job_system(in_workers);
+
+    std::uint64_t result = WThreadLib::WaitTask(job_system, Pipeline_Task(job_system));
+
+    bool thrown = false;
+    try {
+        WThreadLib::WaitTask(job_system, Throw_Task());
+    }
+    catch (const std::runtime_error &) {
+        thrown = true;
+    }
+
+    return result == 5050 + 500500 &&
+        thrown;
+}
+
+bool WJobSystem_Dependencies_Test(std::size_t in_workers) {
+    WThreadLib::WJobSystem job_system(in_workers);
+
+    std::atomic<std::uint32_t> step{0};
+    bool ordered = true;
+
+    WThreadLib::WJobCounter counter;
+
+    auto a = job_system.Schedule([&]() {
+        ordered = ordered && step.fetch_add(1) == 0;
+    }, {}, &counter);
+
+    auto b = job_system.Schedule([&]() {
+        ordered = ordered && step.fetch_add(1) == 1;
+    }, {a}, &counter);
+
+    auto c = job_system.Schedule([&]() {
+        ordered = ordered && step.fetch_add(1) == 2;
+    }, {a, b}, &counter);
+
+    job_system.Wait(c);
+    if (!a.IsDone() || !b.IsDone()) return false;
+
+    // Depending on a finished job runs right away.
+    auto d = job_system.Schedule([&]() { step.fetch_add(1); }, {c}, &counter);
+
+    job_system.Wait(counter);
+
+    return ordered &&
+        d.IsDone() &&
+        step.load() == 4;
+}
+
+bool WJobSystem_ParallelFor_Test(std::size_t in_workers) {
+    WThreadLib::WJobSystem job_system(in_workers);
+
+    constexpr std::size_t N = 100'000;
+    std::vector<std::uint32_t> values(N, 0);
+
+    job_system.ParallelFor(0, N, 64, [&values](std::size_t _i) {
+        values[_i] += static_cast<std::uint32_t>(_i);
+    });
+
+    std::atomic<std::size_t> ranges{0};
+    job_system.ParallelForRange(0, N, [&ranges](std::size_t _begin, std::size_t _end) {
+        ranges.fetch_add(_end - _begin);
+    });
+
+    // Nested ParallelFor from inside a job.
+    std::atomic<std::size_t> nested{0};
+    auto job = job_system.Schedule([&]() {
+        job_system.ParallelFor(0, 1000, 10, [&nested](std::size_t) { nested.fetch_add(1); });
+    });
+    job_system.Wait(job);
+
+    bool match = true;
+    for (std::size_t i=0; i<N; i++) {
+        match = match && values[i] == i;
+    }
+
+    return match &&
+        ranges.load() == N &&
+        nested.load() == 1000;
+}
+
+bool Hash64_Test() {
+    // Reference XXH64 values.
+    if (wcr::hash::Hash64(std::string_view("")) != 0xEF46DB3751D8E999ULL) return false;
+    if (wcr::hash::Hash64(std::string_view("abc")) != 0x44BC2CF5AD770999ULL) return false;
+    if (wcr::hash::Hash64(std::string_view("Nobody inspects the spammish repetition")) !=
+        0xFBCEA83C8A378BF1ULL) return false;
+
+    // Every tail length and the 32 bytes stripes.
+    std::string text(100, 'w');
+    std::vector<std::uint64_t> hashes;
+    for (std::size_t i=0; i<text.size(); i++) {
+        hashes.push_back(wcr::hash::Hash64(std::string_view(text.data(), i)));
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+
+    return std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end() &&
+        wcr::hash::Hash64(std::string_view("abc"), 1) != wcr::hash::Hash64(std::string_view("abc")) &&
+        wcr::hash::HashValues(0, std::uint32_t{1}, std::uint64_t{2}) ==
+        wcr::hash::HashValues(0, std::uint32_t{1}, std::uint64_t{2}) &&
+        wcr::hash::HashValues(0, std::uint32_t{1}, std::uint64_t{2}) !=
+        wcr::hash::HashValues(0, std::uint32_t{2}, std::uint64_t{1});
+}
+
+template<typename IndexPolicy>
+using TSparseSetBench = TSparseSet<std::uint32_t,
+                                   std::allocator<std::uint32_t>,
+                                   std::allocator<std::size_t>,
+                                   IndexPolicy>;
+
+template<typename IndexPolicy>
+void TSparseSet_FillBench(TSparseSetBench<IndexPolicy> & out_sset,
+                          std::vector<std::size_t> & out_lookups) {
+    constexpr std::size_t N = 1'000'000;
+
+    out_sset.Reserve(N);
+    for (std::size_t i=1; i<=N; i++) {
+        out_sset.Insert(i, static_cast<std::uint32_t>(i));
+    }
+
+    out_lookups.resize(N);
+    std::iota(out_lookups.begin(), out_lookups.end(), 1);
+    std::shuffle(out_lookups.begin(), out_lookups.end(), std::mt19937_64{42});
+}
 
 TEST_CASE("WCore") {
     SECTION("TWAllocator") {
@@ -131,6 +647,141 @@ TEST_CASE("WCore") {
     SECTION("WId") {
         CHECK(WIDCompoundNullValue_Test());
     }
+    SECTION("IdPool") {
+        CHECK(IdPool_Test());
+    }
+    SECTION("WHash") {
+        CHECK(Hash64_Test());
+    }
+    SECTION("TSparseSet") {
+        CHECK(TSparseSet_IndexPolicy_Test<TSparseHashIndex>());
+        CHECK(TSparseSet_IndexPolicy_Test<TSparsePagedIndex<>>());
+        CHECK(TSparseSet_IndexPolicy_Test<TSparsePagedIndex<64>>());
+        CHECK(TChunkedSparseSet_Test());
+    }
+    SECTION("TEvent") {
+        CHECK(TInplaceFunction_Test());
+        CHECK(TEvent_Test());
+        CHECK(TEventChannel_Test());
+    }
+    SECTION("WThreadLib") {
+        CHECK(TWorkStealingDeque_Test());
+        CHECK(TMpscQueue_Test());
+        CHECK(TMpscQueue_Throw_Test());
+        CHECK(TGenerator_Test());
+        CHECK(TTask_Test(0));
+        CHECK(TTask_Test(3));
+        CHECK(WJobSystem_Dependencies_Test(0));
+        CHECK(WJobSystem_Dependencies_Test(3));
+        CHECK(WJobSystem_ParallelFor_Test(0));
+        CHECK(WJobSystem_ParallelFor_Test(3));
+    }
+
+}
+
+TEST_CASE("WCore_Benchmark", "[!benchmark]") {
+    std::vector<std::size_t> lookups;
+
+    TSparseSetBench<TSparseHashIndex> hash_sset;
+    TSparseSet_FillBench(hash_sset, lookups);
+
+    TSparseSetBench<TSparsePagedIndex<>> paged_sset;
+    TSparseSet_FillBench(paged_sset, lookups);
+
+    BENCHMARK("TSparseSet 1M random Get, TSparseHashIndex") {
+        std::uint64_t sum=0;
+        for (auto idx : lookups) {
+            sum += hash_sset.Get(idx);
+        }
+        return sum;
+    };
+
+    BENCHMARK("TSparseSet 1M random Get, TSparsePagedIndex") {
+        std::uint64_t sum=0;
+        for (auto idx : lookups) {
+            sum += paged_sset.Get(idx);
+        }
+        return sum;
+    };
+
+    TObjectDataBase<A, B, wcr::wid::WId<>::IdType> od{
+        [](wcr::wid::WId<>::IdType const &) ->A {return {};},
+        [](A const & )->void {}
+    };
+
+    for (std::size_t i=1; i<=1'000'000; i++) {
+        od.InsertAt<A>(i, {});
+    }
+
+    BENCHMARK("TObjectDataBase 1M ids, Indexes") {
+        std::uint64_t sum=0;
+        for (auto id : od.Indexes()) {
+            sum += id;
+        }
+        return sum;
+    };
+
+    BENCHMARK("TObjectDataBase 1M ids, GenerateIndexes") {
+        std::uint64_t sum=0;
+        for (auto id : od.GenerateIndexes()) {
+            sum += id;
+        }
+        return sum;
+    };
 
+    BENCHMARK("TObjectDataBase 1M ids, IterIndexes") {
+        std::uint64_t sum=0;
+        for (auto id : od.IterIndexes()) {
+            sum += id;
+        }
+        return sum;
+    };
+
+    std::vector<std::byte> bytes(64 << 20, std::byte{0x5a});
+
+    BENCHMARK("Hash64 64MB") {
+        return wcr::hash::Hash64(bytes);
+    };
 }
 
+TEST_CASE("WThreadLib_Benchmark", "[!benchmark]") {
+    constexpr std::size_t N = 4'000'000;
+    std::vector<float> values(N, 1.5f);
+
+    std::size_t max_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    // Threads include the calling thread.
+    for (std::size_t threads=1; threads <= max_threads; threads *= 2) {
+        WThreadLib::WJobSystem job_system(threads - 1);
+
+        BENCHMARK(std::format("ParallelFor 4M sqrt, {} threads", threads)) {
+            job_system.ParallelFor(0, N, 4096, [&values](std::size_t _i) {
+                values[_i] = std::sqrt(values[_i] * values[_i] + 1.f);
+            });
+            return values[N - 1];
+        };
+
+        BENCHMARK(std::format("TEventChannel 10K posts, {} producers", threads)) {
+            TEventChannel<void(std::uint32_t)> channel(16'384);
+
+            std::uint64_t sum = 0;
+            channel.Subscribe([&sum](std::uint32_t _v) { sum += _v; });
+
+            job_system.ParallelFor(0, 10'000, 256, [&channel](std::size_t _i) {
+                while (!channel.Post(static_cast<std::uint32_t>(_i))) {}
+            });
+
+            channel.Dispatch();
+            return sum;
+        };
+
+        BENCHMARK(std::format("Schedule 10K empty jobs, {} threads", threads)) {
+            WThreadLib::WJobCounter counter;
+            for (std::size_t i=0; i<10'000; i++) {
+                job_system.Schedule([]() {}, counter);
+            }
+            job_system.Wait(counter);
+            return counter.Count();
+        };
+    }
+}
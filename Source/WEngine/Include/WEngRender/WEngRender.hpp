@@ -148,18 +148,28 @@ namespace wng::render {
 
     }
 
-    inline void InitializeResources(
-        IRender * in_render,
-        was::Level * in_level,
+    /**
+     * @brief Render resources used by the static meshes of a level.
+     */
+    struct LevelResources {
+        TSparseSet<wcr::wid::WAssetId> static_meshes{};
+        TSparseSet<wcr::wid::WAssetId> textures{};
+        TSparseSet<wcr::wid::WAssetId> render_pipelines{};
+    };
+
+    inline LevelResources CollectResources(
+        const was::Level * in_level,
         const WAssetDb & in_asset_db
         ) {
 
-        TSparseSet<wcr::wid::WAssetId> static_meshes;
-        static_meshes.Reserve(64);
-        TSparseSet<wcr::wid::WAssetId> texture_assets;
-        texture_assets.Reserve(64);
-        TSparseSet<wcr::wid::WAssetId> render_pipelines;
-        render_pipelines.Reserve(64);
+        LevelResources result;
+        result.static_meshes.Reserve(64);
+        result.textures.Reserve(64);
+        result.render_pipelines.Reserve(64);
+
+        auto & static_meshes = result.static_meshes;
+        auto & texture_assets = result.textures;
+        auto & render_pipelines = result.render_pipelines;
 
         in_level->ForEachComponent<wcm::StaticMesh>(
             [&static_meshes,
@@ -221,34 +231,83 @@ namespace wng::render {
             }
             );
 
+        return result;
+    }
+
+    inline void LoadStaticMesh(
+        IRender * in_render,
+        const WAssetDb & in_asset_db,
+        const wcr::wid::WAssetId & in_id
+        ) {
+        auto & static_mesh = in_asset_db.Get<was::StaticMesh>(in_id);
+
+        static_mesh.ForEachMesh(
+            [&in_render]
+            (was::StaticMesh * _sma,
+             wcr::wid::WSubIdxId _id,
+             wct::geometry::WMesh & _m) {
+
+                wcr::wid::WTypeAssetIndexId asset_index {
+                    wcr::wid::null_id,
+                    _sma->Get_asset_id(),
+                    _id};
+
+                in_render->LoadStaticMesh(asset_index, _m);
+            }
+            );
+    }
+
+    inline void UnloadStaticMesh(
+        IRender * in_render,
+        const WAssetDb & in_asset_db,
+        const wcr::wid::WAssetId & in_id
+        ) {
+        in_asset_db.Get<was::StaticMesh>(in_id).ForEachMesh(
+            [&in_render](was::StaticMesh * _sm, const wcr::wid::WSubIdxId & _id, wct::geometry::WMesh & _m) {
+                in_render->UnloadStaticMesh(
+                    {wcr::wid::null_id, _sm->Get_asset_id(), _id}
+                    );
+            }
+            );
+    }
+
+    inline void LoadTexture(
+        IRender * in_render,
+        const WAssetDb & in_asset_db,
+        const wcr::wid::WAssetId & in_id
+        ) {
+        in_render->LoadTexture(in_id, in_asset_db.Get<was::Texture>(in_id));
+    }
+
+    /**
+     * @brief Load the level render resources and create its pipeline bindings.
+     * Meshes and textures in in_resident are already loaded (level streaming) and skipped.
+     */
+    inline void InitializeResources(
+        IRender * in_render,
+        was::Level * in_level,
+        const WAssetDb & in_asset_db,
+        const LevelResources * in_resident=nullptr
+        ) {
+
+        LevelResources resources = CollectResources(in_level, in_asset_db);
+
         // Load Meshes
-        for (const wcr::wid::WAssetId & id : static_meshes) {
-            auto & static_mesh = in_asset_db.Get<was::StaticMesh>(id);
-            
-            static_mesh.ForEachMesh(
-                [&in_render, &in_asset_db]
-                (was::StaticMesh * _sma,
-                 wcr::wid::WSubIdxId _id,
-                 wct::geometry::WMesh & _m) {
-                    
-                    wcr::wid::WTypeAssetIndexId asset_index {
-                        wcr::wid::null_id,
-                        _sma->Get_asset_id(),
-                        _id};
+        for (const wcr::wid::WAssetId & id : resources.static_meshes) {
+            if (in_resident && in_resident->static_meshes.Contains(id.GetId())) continue;
 
-                    in_render->LoadStaticMesh(asset_index, _m);
-                }
-                );
+            LoadStaticMesh(in_render, in_asset_db, id);
         }
 
         // Load Textures
-        for (const wcr::wid::WAssetId & id : texture_assets) {
-            auto & texture_asset = in_asset_db.Get<was::Texture>(id);
-            in_render->LoadTexture(id, texture_asset);
+        for (const wcr::wid::WAssetId & id : resources.textures) {
+            if (in_resident && in_resident->textures.Contains(id.GetId())) continue;
+
+            LoadTexture(in_render, in_asset_db, id);
         }
 
         // Initialize Render Pipelines
-        for (const wcr::wid::WAssetId & id : render_pipelines) {
+        for (const wcr::wid::WAssetId & id : resources.render_pipelines) {
             auto & render_pipeline = in_asset_db.Get<was::RenderPipeline>(id);
             in_render->CreateRenderPipeline(&render_pipeline);
         }
@@ -404,10 +463,15 @@ namespace wng::render {
         in_render->RefreshPipelines();
     }
 
+    /**
+     * @brief Unload the level render resources and delete its pipeline bindings.
+     * Meshes and textures in in_keep stay loaded, used by a streamed level.
+     */
     inline void ReleaseRenderResources(
         IRender * in_render,
         was::Level * in_level,
-        const WAssetDb & in_asset_db
+        const WAssetDb & in_asset_db,
+        const LevelResources * in_keep=nullptr
         ) {
 
         TSparseSet<wcr::wid::WAssetId> static_meshes;
@@ -476,6 +540,8 @@ namespace wng::render {
             );
         
         for(auto & id : static_meshes) {
+            if (in_keep && in_keep->static_meshes.Contains(id.GetId())) continue;
+
             in_asset_db.Get<was::StaticMesh>(id).ForEachMesh(
                 [&in_render](was::StaticMesh * _sm, const wcr::wid::WSubIdxId & _id, wct::geometry::WMesh & _m) {
                     in_render->UnloadStaticMesh(
@@ -486,6 +552,8 @@ namespace wng::render {
         }
 
         for(auto & id : texture_assets) {
+            if (in_keep && in_keep->textures.Contains(id.GetId())) continue;
+
             in_render->UnloadTexture(id);
         }
 
@@ -495,4 +563,87 @@ namespace wng::render {
             // TODO: if a render pipeline has no bindings can be marked to unload.
         }
     }
+
+    /**
+     * @brief Collect model matrices of the static meshes in out_snapshot.
+     * Transforms are interpolated with in_alpha, see wcm::Transform::Interpolated.
+     */
+    inline void ExtractModels(
+        was::Level * in_level,
+        float in_alpha,
+        wct::render::RenderSnapshot & out_snapshot
+        ) {
+
+        in_level->ForEachComponent<wcm::StaticMesh>(
+            [&in_level, &in_alpha, &out_snapshot](wcm::StaticMesh * in_component) {
+                if (!in_component->Get_static_mesh_asset().IsValid()) return;
+
+                const wcm::Transform & transform_component = in_level
+                    ->GetComponent<wcm::Transform>(in_component->Get_entity_id());
+
+                // Same binding updated in InitializeResources, only the first static mesh.
+                out_snapshot.model_ids.push_back({
+                        in_level->Get_asset_id(),
+                        in_component->Get_entity_id(),
+                        in_level->GetComponentTypeId<wcm::StaticMesh>(),
+                        {0}
+                    });
+
+                out_snapshot.models.push_back(
+                    wrd::render::ToUBOGraphicsStruct(
+                        transform_component.Interpolated(in_alpha)
+                        )
+                    );
+            }
+            );
+    }
+
+    /**
+     * @brief Collect the active point and directional lights in out_snapshot.
+     */
+    inline void ExtractLights(
+        was::Level * in_level,
+        wct::render::RenderSnapshot & out_snapshot
+        ) {
+
+        in_level->ForEachComponent<wcm::light::Point>(
+            [&in_level, &out_snapshot](wcm::light::Point * cmp) {
+                if (!cmp->Get_active()) return;
+
+                out_snapshot.point_light_ids.push_back({
+                        in_level->Get_asset_id(),
+                        cmp->Get_entity_id(),
+                        in_level->GetComponentTypeId<wcm::light::Point>(),
+                        wcr::wid::null_id
+                    });
+
+                out_snapshot.point_lights.push_back(
+                    wrd::light::ToPointLight(
+                        in_level->GetComponent<wcm::Transform>(cmp->Get_entity_id()),
+                        *cmp
+                        )
+                    );
+            }
+            );
+
+        in_level->ForEachComponent<wcm::light::Directional>(
+            [&in_level, &out_snapshot](wcm::light::Directional * cmp) {
+                if (!cmp->Get_active()) return;
+
+                out_snapshot.directional_light_ids.push_back({
+                        in_level->Get_asset_id(),
+                        cmp->Get_entity_id(),
+                        in_level->GetComponentTypeId<wcm::light::Directional>(),
+                        wcr::wid::null_id
+                    });
+
+                out_snapshot.directional_lights.push_back(
+                    wrd::light::ToDirectionalLight(
+                        in_level->GetComponent<wcm::Transform>(cmp->Get_entity_id()),
+                        *cmp
+                        )
+                    );
+            }
+            );
+    }
 }
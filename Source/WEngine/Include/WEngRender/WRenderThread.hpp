@@ -0,0 +1,118 @@
+#pragma once
+
+#include "WCore/WCore.hpp"
+#include "WCoreTypes/WRenderTypes.hpp"
+#include "WInterfaces/IRender.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pipelines the render with the simulation using two wct::render::RenderSnapshot.
+ * The main thread fills the back snapshot while the render thread applies
+ * the front snapshot to the IRender and draws it.
+ * Any other IRender call from the main thread must be preceded by Sync.
+ */
+class WENGINE_API WRenderThread {
+public:
+
+    using CommandFn = std::function<void(IRender *)>;
+
+public:
+
+    /**
+     * @brief When in_threaded is false Publish applies and draws in the calling thread.
+     */
+    explicit WRenderThread(IRender * in_render, bool in_threaded=true);
+
+    ~WRenderThread();
+
+    WRenderThread(const WRenderThread &) = delete;
+
+    WRenderThread(WRenderThread &&) = delete;
+
+    WRenderThread & operator=(const WRenderThread &) = delete;
+
+    WRenderThread & operator=(WRenderThread &&) = delete;
+
+    /**
+     * @brief Snapshot filled for the next Publish, main thread only.
+     */
+    wct::render::RenderSnapshot & Back() noexcept {
+        return snapshots_[back_];
+    }
+
+    /**
+     * @brief Run in_command in the render thread before drawing the next published snapshot,
+     * main thread only.
+     */
+    void Enqueue(CommandFn && in_command) {
+        commands_[back_].push_back(std::move(in_command));
+    }
+
+    /**
+     * @brief Waits until the previous snapshot is drawn and hands the back snapshot to the render thread.
+     * @return Milliseconds blocked in the main thread.
+     */
+    double Publish();
+
+    /**
+     * @brief Waits until every published snapshot is drawn.
+     */
+    void Sync();
+
+    WNODISCARD bool IsThreaded() const noexcept {
+        return threaded_;
+    }
+
+    /**
+     * @brief Milliseconds applying and drawing the last drawn snapshot.
+     */
+    WNODISCARD double LastDrawMs() const noexcept {
+        return last_draw_ms_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Run the commands, upload the snapshot data and draw a frame.
+     */
+    static void Draw(IRender * in_render,
+                     std::vector<CommandFn> & in_commands,
+                     wct::render::RenderSnapshot & in_snapshot);
+
+private:
+
+    void Loop();
+
+    IRender * render_;
+
+    bool threaded_;
+
+    std::array<wct::render::RenderSnapshot, 2> snapshots_{};
+
+    // Commands published with each snapshot.
+    std::array<std::vector<CommandFn>, 2> commands_{};
+
+    std::uint8_t back_{0};
+
+    std::uint64_t frame_{0};
+
+    std::mutex mutex_{};
+
+    std::condition_variable cv_{};
+
+    // The front snapshot is published and not drawn yet.
+    bool pending_{false};
+
+    bool stop_{false};
+
+    std::atomic<double> last_draw_ms_{0};
+
+    std::thread thread_{};
+
+};
@@ -3,11 +3,14 @@
 #include "WCore/WConcepts.hpp"
 #include "WCore/WCore.hpp"
 #include "WCore/TRef.hpp"
+#include "WCore/TMpscQueue.hpp"
 #include "WInterfaces/IRender.hpp"
 #include "WImporterRegister/WImporterRegister.hpp"
 #include "WObjectDb/WAssetDb.hpp"
 #include "WCoreTypes/WEngineStructs.hpp"
 #include "WInput/WInputMappingRegister.hpp"
+#include "WEngRender/WRenderThread.hpp"
+#include "WEngine/WLevelStreamer.hpp"
 
 #include "WSystems/WSystemsRegister.hpp"
 #include "WSystems/WSystemsRunner.hpp"
@@ -15,25 +18,73 @@
 #include "WWindow/WWindow.hpp"
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 class WENGINE_API WEngine
 {
+private:
+
+public:
+
+    /**
+     * @brief How a level asset becomes the running level.
+     * Reference runs the asset in place without copies, changes persist in the asset.
+     * Copy runs a copy of the asset, each activation starts from the asset state,
+     * for callers that restart a level they mutate.
+     */
+    enum class ELevelActivation : std::uint8_t {
+        Reference,
+        Copy
+    };
+
 private:
 
     struct LevelInfoStruct {
+        // Level requested by MarkLoadLevel
         wcr::wid::WAssetId current_level{0};
+        // Running level asset id
+        wcr::wid::WAssetId active_level{0};
+        // False while the requested level streams.
         bool loaded{false};
-        was::Level level{};
+        ELevelActivation activation{ELevelActivation::Reference};
+        // Running level, the asset or level_copy.
+        was::Level * level{nullptr};
+        was::Level level_copy{};
+        // Time spent activating the running level.
+        double activation_ms{0};
     };
 
     struct StartupInfo {
         wcr::wid::WAssetId startup_level{0};
     };
 
+public:
+
+    /**
+     * @brief Run without window nor input callbacks,
+     * each frame advances the engine cycle fixed_delta_time seconds.
+     */
+    struct HeadlessInfo {
+        double fixed_delta_time{1.0 / 60.0};
+    };
+
+    /**
+     * @brief Fixed step simulation, pre systems run once per fixed_delta_time
+     * accumulated frame time, post systems and draw once per frame.
+     * Frames that would need more than max_ticks lose the remaining time.
+     */
+    struct SimulationInfo {
+        double fixed_delta_time{1.0 / 60.0};
+        std::uint32_t max_ticks{8};
+    };
+
 public:
 
     WEngine(std::unique_ptr<IRender> && in_render);
 
+    WEngine(std::unique_ptr<IRender> && in_render, const HeadlessInfo & in_headless);
+
     virtual ~WEngine()=default;
 
     WEngine(const WEngine & other) = delete;
@@ -44,17 +95,79 @@ public:
 
     WEngine & operator=(WEngine && other);
 
+    /**
+     * @brief Run the startup level until the window is closed.
+     * Needs a window, headless engines use RunFrames.
+     */
     void Run();
 
+    /**
+     * @brief Run the startup level in_frames frames and unload it, works in headless mode.
+     * @return Timings of each frame.
+     */
+    std::vector<WFrameTimingsStruct> RunFrames(std::size_t in_frames);
+
+    WNODISCARD bool IsHeadless() const noexcept {
+        return state_.headless.has_value();
+    }
+
+    void Simulation(const SimulationInfo & in_simulation) noexcept;
+
+    const SimulationInfo & Simulation() const noexcept {
+        return state_.simulation;
+    }
+
+    /**
+     * @brief Draw frame N in a render thread while the simulation runs frame N+1.
+     * Enabled by default, changes apply in the next Run.
+     */
+    void PipelinedRender(bool in_value) noexcept {
+        state_.pipelined_render = in_value;
+    }
+
+    WNODISCARD bool PipelinedRender() const noexcept {
+        return state_.pipelined_render;
+    }
+
+    /**
+     * @brief Activation used in the next level load, ELevelActivation::Reference by default.
+     */
+    void LevelActivation(ELevelActivation in_activation) noexcept {
+        state_.level_activation = in_activation;
+    }
+
+    WNODISCARD ELevelActivation LevelActivation() const noexcept {
+        return state_.level_activation;
+    }
+
+    /**
+     * @brief Render snapshot being filled in the current frame, only valid while running.
+     */
+    wct::render::RenderSnapshot & FrameSnapshot() noexcept {
+        assert(state_.render_thread);
+        return state_.render_thread->Back();
+    }
+
     void StartupLevel(const wcr::wid::WAssetId & in_id) noexcept;
 
     wcr::wid::WAssetId StartupLevel() const noexcept {
         return state_.startup_info.startup_level;
     }
 
-    /** Set a level to be loaded when possible */
+    /**
+     * @brief Stream in_level_id while the running level keeps running,
+     * it is swapped in when its resources are loaded. See WLevelStreamer.
+     */
     void MarkLoadLevel(const wcr::wid::WAssetId & in_level_id);
 
+    WLevelStreamer & LevelStreamer() noexcept {
+        return *state_.level_streamer;
+    }
+
+    const WLevelStreamer & LevelStreamer() const noexcept {
+        return *state_.level_streamer;
+    }
+
     const LevelInfoStruct & LevelInfo() const noexcept {
         return state_.level_info;
     }
@@ -75,6 +188,12 @@ public:
         return state_.input_mapping_register;
     }
 
+    /**
+     * @brief Queue an input from any thread, inputs are dispatched at the start of the next frame.
+     * @return false if the input queue is full and the input is dropped.
+     */
+    bool PostInput(const WInputValuesStruct & in_input);
+
     const WEngineCycleStruct & EngineCycle() const noexcept {
         return state_.engine_cycle;
     }
@@ -89,6 +208,10 @@ public:
         in_fn(state_.systems_reg);
     }
 
+    const WSystemsRunner & SystemsRunner() const noexcept {
+        return state_.systems_runner;
+    }
+
     TRef<IRender> Render() noexcept;
 
     WAssetDb & AssetManager() noexcept;
@@ -101,6 +224,28 @@ private:
 
     void UpdateEngineCycleStruct();
 
+    void UpdateSimulationTicks();
+
+    void DispatchInput();
+
+    void BeginRun();
+
+    WFrameTimingsStruct RunFrame();
+
+    void EndRun();
+
+    /**
+     * @brief Make in_level_id the running level, uses the streamed level when ready.
+     */
+    void ActivateLevel(const wcr::wid::WAssetId & in_level_id);
+
+    void SwapStreamedLevel();
+
+    /**
+     * @brief Creating level assets can move the asset db storage, find the referenced level again.
+     */
+    void RefreshActiveLevel();
+
     void LoadLevel(was::Level & in_level);
 
     void UnloadLevel(was::Level & in_level);
@@ -131,6 +276,8 @@ private:
 
         LevelInfoStruct level_info{};
 
+        ELevelActivation level_activation{ELevelActivation::Reference};
+
         StartupInfo startup_info{};
 
         struct EngineStatus {
@@ -139,17 +286,33 @@ private:
 
         wdw::WWindow window{};
 
+        std::optional<HeadlessInfo> headless{};
+
         WEngineCycleStruct engine_cycle{};
 
+        SimulationInfo simulation{};
+        double accumulator{0};
+
         std::unique_ptr<IRender> render{nullptr};
 
+        bool pipelined_render{true};
+        std::unique_ptr<WRenderThread> render_thread{nullptr};
+
         WAssetDb asset_db{};
 
+        // After asset_db, destroyed first, waits its background job.
+        std::unique_ptr<WLevelStreamer> level_streamer{std::make_unique<WLevelStreamer>()};
+
         WSystemsRegister systems_reg{};
         WSystemsRunner systems_runner{};
 
         WInputMappingRegister input_mapping_register{};
 
+        // Window callbacks and other threads post, RunFrame dispatches.
+        std::unique_ptr<TMpscQueue<WInputValuesStruct>> input_queue{
+            std::make_unique<TMpscQueue<WInputValuesStruct>>(256)
+        };
+
         wim::imp_register::WImporterRegister importers_register{};
 
     } state_{};
@@ -6,6 +6,12 @@ namespace weng::defaults {
 
     WEngine DefaultEngine();
 
+    /**
+     * @brief Default engine with a WNullRender and no window,
+     * frames and simulation ticks advance in_fixed_delta_time seconds.
+     */
+    WEngine HeadlessEngine(double in_fixed_delta_time = 1.0 / 60.0);
+
     inline constexpr
     std::string_view const NULL_RGBA_TEXTURE_ASSET_PATH{
         "/Content/Assets/Textures/null_rgba_texture:null_rgba_texture"
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "WCore/WCore.hpp"
+#include "WCore/TEvent.hpp"
+#include "WCore/WThreadLib.hpp"
+#include "WAssets/Level.hpp"
+#include "WObjectDb/WAssetDb.hpp"
+#include "WEngRender/WEngRender.hpp"
+#include "WEngRender/WRenderThread.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class ELevelStreamingState : std::uint8_t {
+    Idle,
+    /** Workers copy the level and collect its render resources. */
+    Preparing,
+    /** The render thread loads meshes and textures, a budget per frame. */
+    Staging,
+    /** Everything is loaded, the level can be swapped. */
+    Ready,
+    /** The level couldn't be prepared, see WLevelStreamer::Error. */
+    Failed
+};
+
+struct WLevelStreamingProgress {
+    wcr::wid::WAssetId level{};
+    ELevelStreamingState state{ELevelStreamingState::Idle};
+    std::size_t staged{0};
+    std::size_t total{0};
+};
+
+/**
+ * @brief Loads a level while the running level keeps running and rendering.
+ * Start and Update are called from the main thread, the level copy and the resource
+ * collection run in a job, meshes and textures are loaded through WRenderThread commands.
+ * The asset db is frozen from Start to Finish (WAssetDb::Freeze), so the job and
+ * the render thread read assets that don't move.
+ */
+class WENGINE_API WLevelStreamer {
+public:
+
+    using ProgressEvent = TEvent<void(const WLevelStreamingProgress &)>;
+
+public:
+
+    WLevelStreamer() = default;
+
+    ~WLevelStreamer();
+
+    WLevelStreamer(const WLevelStreamer &) = delete;
+
+    WLevelStreamer(WLevelStreamer &&) = delete;
+
+    WLevelStreamer & operator=(const WLevelStreamer &) = delete;
+
+    WLevelStreamer & operator=(WLevelStreamer &&) = delete;
+
+    /**
+     * @brief Start streaming in_level_id, the streamer must be idle.
+     * @param in_copy The swapped level is a copy of the asset, see WEngine::ELevelActivation.
+     * @param in_running The running level, it is only read from this thread.
+     */
+    void Start(const wcr::wid::WAssetId & in_level_id,
+               WAssetDb & in_asset_db,
+               bool in_copy,
+               const was::Level * in_running=nullptr,
+               WThreadLib::WJobSystem & in_job_system=WThreadLib::DefaultJobSystem());
+
+    /**
+     * @brief Advance the streaming, call once per published frame.
+     */
+    void Update(WRenderThread & in_render_thread);
+
+    /**
+     * @brief Back to idle after the level is swapped or failed,
+     * staged resources are owned by the level. Unfreezes the asset db.
+     */
+    void Finish();
+
+    /**
+     * @brief Stop the streaming and unload the staged resources.
+     * The render must be idle and every enqueued command executed.
+     */
+    void Cancel(IRender * in_render, const WAssetDb & in_asset_db);
+
+    WNODISCARD ELevelStreamingState State() const noexcept {
+        return progress_.state;
+    }
+
+    WNODISCARD bool IsIdle() const noexcept {
+        return progress_.state == ELevelStreamingState::Idle;
+    }
+
+    WNODISCARD bool IsReady() const noexcept {
+        return progress_.state == ELevelStreamingState::Ready;
+    }
+
+    WNODISCARD bool IsFailed() const noexcept {
+        return progress_.state == ELevelStreamingState::Failed;
+    }
+
+    /**
+     * @brief Why the preparation failed, empty if it didn't.
+     */
+    const std::string & Error() const noexcept {
+        return error_;
+    }
+
+    WNODISCARD bool IsCopy() const noexcept {
+        return copy_;
+    }
+
+    const WLevelStreamingProgress & Progress() const noexcept {
+        return progress_;
+    }
+
+    /**
+     * @brief Resources of the streamed level, loaded when ready.
+     * The ones shared with the running level were not staged, they stay loaded.
+     */
+    const wng::render::LevelResources & Resources() const noexcept {
+        return resources_;
+    }
+
+    /**
+     * @brief Copy of the streamed level, only with in_copy.
+     */
+    was::Level & LevelCopy() noexcept {
+        return level_copy_;
+    }
+
+    /**
+     * @brief Meshes and textures loaded per frame.
+     */
+    void StagingBudget(std::size_t in_budget) noexcept {
+        budget_ = in_budget > 0 ? in_budget : 1;
+    }
+
+    WNODISCARD std::size_t StagingBudget() const noexcept {
+        return budget_;
+    }
+
+    /**
+     * @brief Emitted in the main thread each time the state or the staged count change.
+     */
+    ProgressEvent & OnProgress() noexcept {
+        return on_progress_;
+    }
+
+private:
+
+    void WaitPrepare();
+
+    void BeginStaging();
+
+    void Fail();
+
+    void SetProgress(ELevelStreamingState in_state, std::size_t in_staged);
+
+    WLevelStreamingProgress progress_{};
+
+    wng::render::LevelResources resources_{};
+
+    // Meshes and textures of resources_ not loaded by the running level.
+    wng::render::LevelResources staging_{};
+
+    was::Level level_copy_{};
+
+    bool copy_{false};
+
+    // Frozen from Start to Finish.
+    WAssetDb * asset_db_{nullptr};
+
+    // Set by the prepare job, read once it is done.
+    std::string error_{};
+
+    // Resources enqueued in the render thread, meshes first.
+    std::size_t enqueued_{0};
+
+    // Resources loaded by the render thread.
+    std::atomic<std::size_t> staged_{0};
+
+    std::size_t budget_{4};
+
+    WThreadLib::WJobSystem * job_system_{nullptr};
+
+    WThreadLib::WJobHandle prepare_job_{};
+
+    ProgressEvent on_progress_{};
+
+};
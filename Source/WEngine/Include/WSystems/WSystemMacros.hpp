@@ -21,6 +21,16 @@ class WEngine;
             }                                                       \
     bool WSystems:: _FN(const WSystemParameters & parameters) {
 
+/**
+ * @brief Same as START_DEFINE_WSYSTEM, the system declares its component access.
+ * e.g. START_DEFINE_WSYSTEM_ACCESS(Fn, WSystemAccess().Read<wcm::Camera>().Write<wcm::Transform>())
+ */
+#define START_DEFINE_WSYSTEM_ACCESS(_FN, ...)                       \
+    void WSystems:: _FN ## _REG(WSystemsRegister & in_register) {   \
+        in_register.RegSystem(#_FN, _FN, __VA_ARGS__);              \
+            }                                                       \
+    bool WSystems:: _FN(const WSystemParameters & parameters) {
+
 #define END_DEFINE_WSYSTEM() return true; }
 
 #define START_DEFINE_WSYSTEMS_REG(_MODULE, _NAME) void WSystems:: _MODULE ## _ ## _NAME ## _REG (WSystemsRegister & in_register) {
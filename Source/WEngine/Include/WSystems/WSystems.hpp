@@ -5,6 +5,9 @@
 #include "WSystems/WSystemMacros.hpp"
 #include "WAssets/Level.hpp"
 
+#include <cstdint>
+#include <vector>
+
 struct WSystemParameters {
     WEngine * engine;
     was::Level * level;
@@ -12,6 +15,84 @@ struct WSystemParameters {
 
 using WSystemFn = TFnPtr<bool(const WSystemParameters &)>;
 
+/**
+ * @brief Engine state written by systems, besides the level components.
+ */
+enum class EEngineState : std::uint32_t {
+    // IRender calls, resources and pipelines.
+    Render = 1u << 0,
+    // Input mappings and bindings.
+    Input = 1u << 1,
+    // Camera of the frame render snapshot.
+    SnapshotCamera = 1u << 2,
+    // Models and lights of the frame render snapshot.
+    SnapshotScene = 1u << 3,
+    All = ~0u
+};
+
+/**
+ * @brief Components a system reads and writes, used to run systems in parallel.
+ * Systems without a declared access conflict with every other system.
+ * WriteEngine marks the engine state a system changes (render, input...),
+ * systems writing the same state never run at the same time.
+ * Structural changes (create or remove entities and components) need undeclared access.
+ */
+struct WSystemAccess {
+
+    template<std::derived_from<WComponent> ... Ts>
+    WSystemAccess & Read() {
+        declared = true;
+        (reads.push_back(Ts::StaticClass()), ...);
+        return *this;
+    }
+
+    template<std::derived_from<WComponent> ... Ts>
+    WSystemAccess & Write() {
+        declared = true;
+        (writes.push_back(Ts::StaticClass()), ...);
+        return *this;
+    }
+
+    WSystemAccess & WriteEngine(EEngineState in_state=EEngineState::All) {
+        declared = true;
+        engine_writes |= static_cast<std::uint32_t>(in_state);
+        return *this;
+    }
+
+    /**
+     * @brief True if both systems can't run at the same time.
+     */
+    WNODISCARD bool ConflictsWith(const WSystemAccess & other) const {
+        if (!declared || !other.declared) return true;
+
+        if (engine_writes & other.engine_writes) return true;
+
+        return Overlaps(writes, other.writes) ||
+            Overlaps(writes, other.reads) ||
+            Overlaps(reads, other.writes);
+    }
+
+    std::vector<const WClass *> reads{};
+    std::vector<const WClass *> writes{};
+    // EEngineState bits.
+    std::uint32_t engine_writes{0};
+    bool declared{false};
+
+private:
+
+    static bool Overlaps(const std::vector<const WClass *> & in_a,
+                         const std::vector<const WClass *> & in_b) {
+        for (const WClass * a : in_a) {
+            for (const WClass * b : in_b) {
+                if (a == b || a->IsBaseOf(b) || b->IsBaseOf(a)) return true;
+            }
+        }
+
+        return false;
+    }
+
+};
+
 START_WSYSTEMS_REG(WENGINE, WSYSTEMS)
 
     DECLARE_WSYSTEM(WENGINE_API, SystemInit_InitializeTransformsMatrix)
@@ -20,12 +101,16 @@ START_WSYSTEMS_REG(WENGINE, WSYSTEMS)
 
     DECLARE_WSYSTEM(WENGINE_API, SystemInit_CameraInput)
 
+    DECLARE_WSYSTEM(WENGINE_API, SystemPre_StorePreviousTransforms)
+
     DECLARE_WSYSTEM(WENGINE_API, SystemPre_UpdateMovement)
 
     DECLARE_WSYSTEM(WENGINE_API, SystemPre_CameraInputMovement)
 
     DECLARE_WSYSTEM(WENGINE_API, SystemPost_UpdateRenderCamera)
 
+    DECLARE_WSYSTEM(WENGINE_API, SystemPost_ExtractRenderSnapshot)
+
     DECLARE_WSYSTEM(WENGINE_API, SystemEnd_RenderLevelResources)
 
 END_WSYSTEMS_REG()
@@ -14,12 +14,18 @@ class WENGINE_API WSystemsRegister {
 public:
     WSystemsRegister();
 
-    wcr::wid::WSystemId RegSystem(const char * in_name, const WSystemFn & in_system);
+    wcr::wid::WSystemId RegSystem(const char * in_name,
+                                  const WSystemFn & in_system,
+                                  const WSystemAccess & in_access={});
 
     WSystemFn Get(const wcr::wid::WSystemId & in_id) const {
         return system_set_.Get(in_id.GetId());
     }
 
+    const WSystemAccess & GetAccess(const wcr::wid::WSystemId & in_id) const {
+        return access_set_.Get(in_id.GetId());
+    }
+
     wcr::wid::WSystemId GetId(const char * in_name) const {
         return name_wid_.at(in_name);
     }
@@ -35,6 +41,7 @@ public:
 private:
 
     TSparseSet<WSystemFn> system_set_;
+    TSparseSet<WSystemAccess> access_set_;
 
     wcr::IdPool<wcr::wid::WSystemId::IdType> id_pool_;
     std::unordered_map<std::string, wcr::wid::WSystemId> name_wid_;
@@ -2,18 +2,81 @@
 
 #include "WCore/WCore.hpp"
 #include "WCore/TSparseSet.hpp"
+#include "WCore/WThreadLib.hpp"
 #include "WSystems/WSystems.hpp"
 
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 /**
  * @brief Active in use systems.
+ * Each level stage (init, pre, post, end) builds a dependency graph from the systems access,
+ * a system depends on the earlier systems (in insertion order) it conflicts with.
+ * Systems without conflicts run in parallel in the job system,
+ * conflicting systems keep their order.
  */
 class WENGINE_API WSystemsRunner {
+public:
+
+    enum class ESystemLocation : std::uint8_t {
+        INIT,
+        PRE,
+        POST,
+        END
+    };
+
+    /**
+     * @brief Timings of the last run of a level stage.
+     */
+    struct StageReport {
+        std::size_t system_count{0};
+        // Systems in the longest dependency chain.
+        std::size_t critical_path_length{0};
+        // Sum of the systems run time.
+        double work_ms{0};
+        // Run time of the longest dependency chain.
+        double critical_path_ms{0};
+        double wall_ms{0};
+
+        /**
+         * @brief Best possible speedup with the stage dependencies.
+         */
+        WNODISCARD double Parallelism() const noexcept {
+            return critical_path_ms > 0 ? work_ms / critical_path_ms : 1.0;
+        }
+
+        /**
+         * @brief Achieved speedup over running the systems serially.
+         */
+        WNODISCARD double Speedup() const noexcept {
+            return wall_ms > 0 ? work_ms / wall_ms : 1.0;
+        }
+    };
+
 private:
 
-    using Systems = std::unordered_map<wcr::wid::WAssetId, TSparseSet<WSystemFn>>;
+    struct SystemEntry {
+        WSystemFn fn{};
+        WSystemAccess access{};
+    };
+
+    /**
+     * @brief Systems of a level stage, the graph is rebuilt on the next run after a change.
+     */
+    struct Stage {
+        TSparseSet<SystemEntry> systems{};
+
+        // Dense positions of the systems each system waits for.
+        mutable std::vector<std::vector<std::size_t>> dependencies{};
+        mutable std::vector<double> times_ms{};
+        // No pair of systems can run at the same time.
+        mutable bool serial{true};
+        mutable bool dirty{true};
+        mutable StageReport report{};
+    };
+
+    using Systems = std::unordered_map<wcr::wid::WAssetId, Stage>;
 
 public:
 
@@ -34,23 +97,27 @@ public:
     wcr::wid::WLevelSystemId AddInitSystem(
         wcr::wid::WAssetId const & in_level_id,
         wcr::wid::WSystemId const & in_system_id,
-        WSystemFn const & in_fn);
+        WSystemFn const & in_fn,
+        WSystemAccess const & in_access={});
 
     wcr::wid::WLevelSystemId AddPreSystem(
         wcr::wid::WAssetId const & in_level_id,
         wcr::wid::WSystemId const & in_system_id,
-        WSystemFn const & in_fn);
+        WSystemFn const & in_fn,
+        WSystemAccess const & in_access={});
 
     wcr::wid::WLevelSystemId AddPostSystem(
         wcr::wid::WAssetId const & in_level,
         wcr::wid::WSystemId const & in_system_id,
-        WSystemFn const & in_fn);
+        WSystemFn const & in_fn,
+        WSystemAccess const & in_access={});
 
     wcr::wid::WLevelSystemId AddEndSystem(
         wcr::wid::WAssetId const & in_level,
         wcr::wid::WSystemId const & in_system_id,
-        WSystemFn const & in_fn);
-    
+        WSystemFn const & in_fn,
+        WSystemAccess const & in_access={});
+
 
     void RemoveSystem(const wcr::wid::WLevelSystemId & in_id);
 
@@ -68,20 +135,39 @@ public:
 
     void RunEndSystems(const wcr::wid::WAssetId & levelid, const WSystemParameters &) const;
 
-private:
+    /**
+     * @brief Timings and parallelism of the last run of a level stage.
+     */
+    StageReport GetStageReport(const wcr::wid::WAssetId & in_level_id,
+                               const ESystemLocation & in_location) const;
 
-    enum class ESystemLocation : std::uint8_t {
-        INIT,
-        PRE,
-        POST,
-        END
-    };
+    /**
+     * @brief Job system used to run parallel stages, nullptr uses WThreadLib::DefaultJobSystem.
+     */
+    void SetJobSystem(WThreadLib::WJobSystem * in_job_system) noexcept {
+        job_system_ = in_job_system;
+    }
+
+private:
 
     wcr::wid::WLevelSystemId AddSystem(Systems & out_system,
                              const ESystemLocation & in_location,
                              wcr::wid::WAssetId const & in_level_id,
                              const wcr::wid::WSystemId & in_system_id,
-                             const WSystemFn & in_system);
+                             const WSystemFn & in_system,
+                             const WSystemAccess & in_access);
+
+    Systems & LocationSystems(const ESystemLocation & in_location);
+
+    const Systems & LocationSystems(const ESystemLocation & in_location) const;
+
+    void RunStage(const Systems & in_systems,
+                  const wcr::wid::WAssetId & in_level_id,
+                  const WSystemParameters & in_parameters) const;
+
+    static void BuildStageGraph(const Stage & in_stage);
+
+    static void UpdateStageReport(const Stage & in_stage, double in_wall_ms);
 
     Systems init_systems_;
     Systems pre_systems_;
@@ -90,4 +176,6 @@ private:
 
     std::unordered_map<wcr::wid::WLevelSystemId, ESystemLocation> systemid_location_;
 
+    WThreadLib::WJobSystem * job_system_{nullptr};
+
 };
@@ -19,6 +19,18 @@
 
 #include "WEngRender/WEngRender.hpp"
 
+#include <chrono>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(const Clock::time_point & in_start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - in_start).count();
+    }
+
+}
+
 // WEngine WEngine::DefaultCreate()
 // {
 //     WEngine result(std::make_unique<WVkRender>());
@@ -53,10 +65,21 @@ WEngine::WEngine(std::unique_ptr<IRender> && in_render)
     Initialize();
 }
 
+WEngine::WEngine(std::unique_ptr<IRender> && in_render, const HeadlessInfo & in_headless)
+{
+    state_.render = std::move(in_render);
+    state_.headless = in_headless;
+    Initialize();
+}
+
 WEngine::WEngine(WEngine && other):
     state_(std::move(other.state_))
 
 {
+    if (state_.level_info.level == &other.state_.level_info.level_copy) {
+        state_.level_info.level = &state_.level_info.level_copy;
+    }
+
     if (state_.window.IsValid()) {
         state_.window.SetWindowUserPtr(this);
     }
@@ -68,6 +91,10 @@ WEngine & WEngine::operator=(WEngine && other)
     if (this != &other) {
         state_ = std::move(other.state_);
 
+        if (state_.level_info.level == &other.state_.level_info.level_copy) {
+            state_.level_info.level = &state_.level_info.level_copy;
+        }
+
         if (state_.window.IsValid()) {
             state_.window.SetWindowUserPtr(this);
         }
@@ -77,6 +104,10 @@ WEngine & WEngine::operator=(WEngine && other)
 }
 
 void WEngine::Initialize() {
+    if (IsHeadless()) {
+        return;
+    }
+
     state_.window.Initialize();
     state_.window.SetWindowUserPtr(this);
 
@@ -88,77 +119,234 @@ void WEngine::Initialize() {
 }
 
 void WEngine::Run()
+{
+    assert(!IsHeadless() && "Headless engines have no window, use RunFrames.");
+
+    BeginRun();
+
+    while(!state_.window.ShouldClose()) {
+        UpdateEngineCycleStruct();
+        state_.window.PollEvents();
+
+        RunFrame();
+    }
+
+    EndRun();
+}
+
+std::vector<WFrameTimingsStruct> WEngine::RunFrames(std::size_t in_frames)
+{
+    std::vector<WFrameTimingsStruct> result;
+    result.reserve(in_frames);
+
+    BeginRun();
+
+    for (std::size_t i=0; i < in_frames; i++) {
+        UpdateEngineCycleStruct();
+
+        if (!IsHeadless()) {
+            state_.window.PollEvents();
+        }
+
+        result.push_back(RunFrame());
+    }
+
+    EndRun();
+
+    return result;
+}
+
+void WEngine::BeginRun()
 {
     assert(state_.startup_info.startup_level.IsValid());
 
     state_.level_info.current_level = state_.startup_info.startup_level;
-    state_.level_info.level =
-        (state_.asset_db.Get<was::Level>(state_.level_info.current_level));
+    ActivateLevel(state_.level_info.current_level);
 
-    LoadLevel(state_.level_info.level);
+    LoadLevel(*state_.level_info.level);
 
     state_.level_info.loaded = true;
+    state_.accumulator = 0;
 
-    while(!state_.window.ShouldClose()) {
-        UpdateEngineCycleStruct();
-        state_.window.PollEvents();
-        
-        if (!state_.level_info.loaded) {
-            UnloadLevel(state_.level_info.level);
+    state_.render_thread = std::make_unique<WRenderThread>(
+        state_.render.get(),
+        state_.pipelined_render
+        );
+}
 
-            Render()->WaitIdle();
+WFrameTimingsStruct WEngine::RunFrame()
+{
+    WFrameTimingsStruct timings{};
 
-            state_.level_info.level =
-                state_.asset_db.Get<was::Level>(
-                state_.level_info.current_level);
+    auto frame_start = Clock::now();
 
-            LoadLevel(state_.level_info.level);
+    RefreshActiveLevel();
 
-            WLOG("Level Load Done.");
+    DispatchInput();
 
-            state_.level_info.loaded = true;
-        }
-        else
-        {
-            state_.systems_runner
-                .RunPreSystems(0, {this, &state_.level_info.level});
+    if (state_.level_streamer->IsFailed()) {
+        state_.level_streamer->Finish();
 
-            state_.systems_runner
-                .RunPreSystems(state_.level_info.level.Get_asset_id(),
-                               {this, &state_.level_info.level});
+        // Keep running the active level.
+        state_.level_info.current_level = state_.level_info.active_level;
+        state_.level_info.loaded = true;
+    }
+
+    if (!state_.level_info.loaded && state_.level_streamer->IsIdle()) {
+        state_.level_streamer->Start(
+            state_.level_info.current_level,
+            state_.asset_db,
+            state_.level_activation == ELevelActivation::Copy,
+            state_.level_info.level
+            );
+    }
+
+    if (state_.level_streamer->IsReady()) {
+        SwapStreamedLevel();
+    }
+    else
+    {
+        UpdateSimulationTicks();
 
+        auto start = Clock::now();
+
+        for (std::uint32_t i=0; i < state_.engine_cycle.SimulationTicks; i++) {
             state_.systems_runner
-                .RunPostSystems(0, {this, &state_.level_info.level});
+                .RunPreSystems(0, {this, state_.level_info.level});
 
             state_.systems_runner
-                .RunPostSystems(state_.level_info.level.Get_asset_id(),
-                                {this, &state_.level_info.level});
+                .RunPreSystems(state_.level_info.active_level,
+                               {this, state_.level_info.level});
 
-            Render()->Draw();
+            state_.engine_cycle.SimulationTime += state_.engine_cycle.FixedDeltaTime;
         }
+
+        timings.simulation_ticks = state_.engine_cycle.SimulationTicks;
+        timings.pre_systems = ElapsedMs(start);
+        start = Clock::now();
+
+        state_.systems_runner
+            .RunPostSystems(0, {this, state_.level_info.level});
+
+        state_.systems_runner
+            .RunPostSystems(state_.level_info.active_level,
+                            {this, state_.level_info.level});
+
+        timings.post_systems = ElapsedMs(start);
+
+        // Staging commands go with this frame.
+        state_.level_streamer->Update(*state_.render_thread);
+
+        timings.draw = state_.render_thread->Publish();
+        timings.render = state_.render_thread->LastDrawMs();
     }
-    
+
+    // Input callbacks use the level between frames.
+    RefreshActiveLevel();
+
+    timings.frame = ElapsedMs(frame_start);
+
+    return timings;
+}
+
+void WEngine::EndRun()
+{
+    // Draws the published snapshots and joins the render thread.
+    state_.render_thread.reset();
+
     Render()->WaitIdle();
-    UnloadLevel(state_.level_info.level);
+
+    RefreshActiveLevel();
+
+    state_.level_streamer->Cancel(
+        Render().Ptr(),
+        state_.asset_db
+        );
+
+    UnloadLevel(*state_.level_info.level);
+}
+
+void WEngine::SwapStreamedLevel()
+{
+    // Level resources are released from this thread.
+    state_.render_thread->Sync();
+    Render()->WaitIdle();
+
+    UnloadLevel(*state_.level_info.level);
+
+    ActivateLevel(state_.level_streamer->Progress().level);
+
+    LoadLevel(*state_.level_info.level);
+
+    WLOG("Level Load Done.");
+
+    state_.level_streamer->Finish();
+
+    // Other level could be requested while streaming.
+    state_.level_info.loaded =
+        state_.level_info.current_level == state_.level_info.active_level;
+    state_.accumulator = 0;
 }
 
 void WEngine::MarkLoadLevel(const wcr::wid::WAssetId & in_level) {
+    if (!state_.render_thread) {
+        // Not running, loaded at Run.
+        StartupLevel(in_level);
+        return;
+    }
+
     state_.level_info.current_level = in_level;
     state_.level_info.loaded = false;
 }
 
+void WEngine::ActivateLevel(const wcr::wid::WAssetId & in_level_id) {
+    auto start = Clock::now();
+
+    LevelInfoStruct & info = state_.level_info;
+    WLevelStreamer & streamer = *state_.level_streamer;
+
+    const bool streamed = streamer.IsReady() && streamer.Progress().level == in_level_id;
+
+    info.active_level = in_level_id;
+    info.activation = streamed ?
+        (streamer.IsCopy() ? ELevelActivation::Copy : ELevelActivation::Reference) :
+        state_.level_activation;
+
+    if (info.activation == ELevelActivation::Copy) {
+        info.level_copy = streamed ?
+            std::move(streamer.LevelCopy()) :
+            state_.asset_db.Get<was::Level>(in_level_id);
+        info.level = &info.level_copy;
+    }
+    else {
+        info.level_copy = {};
+        info.level = &state_.asset_db.Get<was::Level>(in_level_id);
+    }
+
+    info.activation_ms = ElapsedMs(start);
+
+    WFLOG("[INFO] Level {} activated in {} ms.", in_level_id.GetId(), info.activation_ms);
+}
+
+void WEngine::RefreshActiveLevel() {
+    if (state_.level_info.activation == ELevelActivation::Reference) {
+        state_.level_info.level =
+            &state_.asset_db.Get<was::Level>(state_.level_info.active_level);
+    }
+}
+
 void WEngine::LoadLevel(was::Level & in_level) {
     // TODO register level systems
 
     WFLOG("[DEBUG] Run Engine Init Systems.");
     state_.systems_runner.RunInitSystems(
-        0, {this, &state_.level_info.level}
+        0, {this, &in_level}
         );
 
     WFLOG("[DEBUG] Run Level Init Systems.")
     state_.systems_runner.RunInitSystems(
-        state_.level_info.level.Get_asset_id(),
-        {this, &state_.level_info.level}
+        state_.level_info.active_level,
+        {this, &in_level}
         );
 }
 
@@ -171,6 +359,13 @@ void WEngine::UnloadLevel(was::Level & in_level) {
     
 }
 
+void WEngine::Simulation(const SimulationInfo & in_simulation) noexcept {
+    assert(in_simulation.fixed_delta_time > 0);
+
+    state_.simulation = in_simulation;
+    state_.engine_cycle.FixedDeltaTime = in_simulation.fixed_delta_time;
+}
+
 void WEngine::StartupLevel(const wcr::wid::WAssetId& in_id) noexcept {
     state_.startup_info.startup_level = in_id;
 }
@@ -207,28 +402,28 @@ void WEngine::StartupLevel(const wcr::wid::WAssetId& in_id) noexcept {
 wcr::wid::WLevelSystemId WEngine::AddInitSystem(const wcr::wid::WAssetId & in_level_id, std::string_view in_system_name) {
     wcr::wid::WSystemId wsid = state_.systems_reg.GetId(in_system_name);
     return state_.systems_runner.AddInitSystem(
-        in_level_id, wsid, state_.systems_reg.Get(wsid)
+        in_level_id, wsid, state_.systems_reg.Get(wsid), state_.systems_reg.GetAccess(wsid)
         );
 }
 
 wcr::wid::WLevelSystemId WEngine::AddPreSystem(const wcr::wid::WAssetId & in_level_id, std::string_view in_system_name) {
     wcr::wid::WSystemId wsid = state_.systems_reg.GetId(in_system_name);
     return state_.systems_runner.AddPreSystem(
-        in_level_id, wsid, state_.systems_reg.Get(wsid)
+        in_level_id, wsid, state_.systems_reg.Get(wsid), state_.systems_reg.GetAccess(wsid)
         );
 }
 
 wcr::wid::WLevelSystemId WEngine::AddPostSystem(const wcr::wid::WAssetId & in_level_id, std::string_view in_system_name) {
     wcr::wid::WSystemId wsid = state_.systems_reg.GetId(in_system_name);
     return state_.systems_runner.AddPostSystem(
-        in_level_id, wsid, state_.systems_reg.Get(wsid)
+        in_level_id, wsid, state_.systems_reg.Get(wsid), state_.systems_reg.GetAccess(wsid)
         );
 }
 
 wcr::wid::WLevelSystemId WEngine::AddEndSystem(const wcr::wid::WAssetId & in_level_id, std::string_view in_system_name) {
     wcr::wid::WSystemId wsid = state_.systems_reg.GetId(in_system_name);
     return state_.systems_runner.AddEndSystem(
-        in_level_id, wsid, state_.systems_reg.Get(wsid)
+        in_level_id, wsid, state_.systems_reg.Get(wsid), state_.systems_reg.GetAccess(wsid)
         );
 }
 
@@ -242,17 +437,66 @@ WAssetDb & WEngine::AssetManager() noexcept {
 }
 
 void WEngine::UpdateEngineCycleStruct() {
-    double seconds = glfwGetTime();
+    if (IsHeadless()) {
+        // Exact step, differences of the accumulated time drift.
+        state_.engine_cycle.DeltaTime = state_.headless->fixed_delta_time;
+        state_.engine_cycle.TotalTime += state_.headless->fixed_delta_time;
+    }
+    else {
+        double seconds = glfwGetTime();
+
+        state_.engine_cycle.DeltaTime = seconds - state_.engine_cycle.TotalTime;
+        state_.engine_cycle.TotalTime = seconds;
+    }
 
-    state_.engine_cycle.DeltaTime = seconds - state_.engine_cycle.TotalTime;
-    state_.engine_cycle.TotalTime = seconds;
     state_.engine_cycle.fps = 1 / state_.engine_cycle.DeltaTime;
 }
 
+void WEngine::UpdateSimulationTicks() {
+    const double step = state_.simulation.fixed_delta_time;
+
+    state_.accumulator += state_.engine_cycle.DeltaTime;
+
+    std::uint32_t ticks = static_cast<std::uint32_t>(state_.accumulator / step);
+
+    if (ticks > state_.simulation.max_ticks) {
+        // Simulation can't keep up, drop the time instead of spiraling.
+        ticks = state_.simulation.max_ticks;
+        state_.accumulator = ticks * step;
+    }
+
+    state_.accumulator -= ticks * step;
+
+    state_.engine_cycle.FixedDeltaTime = step;
+    state_.engine_cycle.SimulationTicks = ticks;
+    state_.engine_cycle.Alpha = state_.accumulator / step;
+}
+
+bool WEngine::PostInput(const WInputValuesStruct & in_input) {
+    if (!state_.input_queue->Push(in_input)) {
+        WFLOG_Warning("Input queue full, input dropped.");
+        return false;
+    }
+
+    return true;
+}
+
+void WEngine::DispatchInput() {
+    WInputValuesStruct input;
+
+    while (state_.input_queue->Pop(input)) {
+        state_.input_mapping_register.Emit(input, this);
+    }
+}
+
 void WEngine::FrameBufferSizeCallback(wdw::WWindow* in_window, int in_width, int in_height)
 {
     auto app = reinterpret_cast<WEngine*>(in_window->GetWindowUserPtr());
 
+    if (app->state_.render_thread) {
+        app->state_.render_thread->Sync();
+    }
+
     app->state_.render->Rescale(
         static_cast<std::uint32_t>(in_width),
         static_cast<std::uint32_t>(in_height)
@@ -267,7 +511,7 @@ void WEngine::KeyCallback(wdw::WWindow * in_window, int key, int scancode, int a
 
     WInputValuesStruct ival = {imd, 1.f, {0,0}};
 
-    app->state_.input_mapping_register.Emit(ival, app);
+    app->PostInput(ival);
 }
 
 void WEngine::CursorCallback(wdw::WWindow * in_window, double in_x, double in_y) {
@@ -279,5 +523,5 @@ void WEngine::CursorCallback(wdw::WWindow * in_window, double in_x, double in_y)
         {in_x, in_y}
     };
 
-    app->state_.input_mapping_register.Emit(ival, app);
+    app->PostInput(ival);
 }
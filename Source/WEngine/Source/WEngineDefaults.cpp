@@ -7,9 +7,11 @@
 #include "WObjectDb/WAssetDb.hpp"
 #include "WAssets/Texture.hpp"
 #include "WVulkan/WVkRender.hpp"
+#include "WRender/WNullRender.hpp"
 #include "WImporter/WImporterTexture.hpp"
 #include "WImporter/WImporterObj.hpp"
 #include "WImporter/WImporterGltf.hpp"
+#include "WImporter/WImporterCooked.hpp"
 #include "WImporterRegister/WImporterRegister.hpp"
 #include "WSystems/WSystems.hpp"
 
@@ -203,49 +205,75 @@ namespace {
 
         mapping_asset.Set_input_map(input_map);
     }
-}
 
+    void DefaultRegister(WEngine & out_engine) {
 
+        out_engine.ImportersRegister().Register<wim::importer::WImporterObj>();
+        out_engine.ImportersRegister().Register<wim::importer::WImportTexture>();
+        out_engine.ImportersRegister().Register<wim::importer::WImporterCooked>();
 
-WEngine weng::defaults::DefaultEngine() {
-    
-    WEngine result(std::make_unique<WVkRender>());
+        out_engine.RegSystems(WSystems::WENGINE_WSYSTEMS_REG);
 
-    result.ImportersRegister().Register<wim::importer::WImporterObj>();
-    result.ImportersRegister().Register<wim::importer::WImportTexture>();
-    
-    result.RegSystems(WSystems::WENGINE_WSYSTEMS_REG);
+        // This must be the first included system
 
-    // This must be the first included system
-    
-    result.AddInitSystem(0, "SystemInit_InitializeTransformsMatrix");
+        out_engine.AddInitSystem(0, "SystemInit_InitializeTransformsMatrix");
 
-    result.AddInitSystem(0, "SystemInit_RenderLevelResources");
+        out_engine.AddInitSystem(0, "SystemInit_RenderLevelResources");
 
-    result.AddPostSystem(0, "SystemPost_UpdateRenderCamera");
+        // Keeps the interpolation state, must run before any other pre system.
+        out_engine.AddPreSystem(0, "SystemPre_StorePreviousTransforms");
 
-    result.AddEndSystem(0, "SystemEnd_RenderLevelResources");
+        out_engine.AddPostSystem(0, "SystemPost_UpdateRenderCamera");
 
-    // Default Assets
+        out_engine.AddPostSystem(0, "SystemPost_ExtractRenderSnapshot");
 
-    DefaultTextures(result.AssetManager());
+        out_engine.AddEndSystem(0, "SystemEnd_RenderLevelResources");
 
-    DefaultRenderPipelines(result.AssetManager());
+        // Default Assets
 
-    DefaultInputAssets(result.AssetManager());
+        DefaultTextures(out_engine.AssetManager());
 
-    // Gltf importer
-    result.ImportersRegister()
-        .Register<wim::importer::WImporterGltf>(
-            result.AssetManager().GetId(weng::defaults::PBR_PIPELINE_ASSET_PATH),
-            result.AssetManager().GetId(weng::defaults::PBR_PIPE_PARAMS_NULL_ASSET_PATH),
-            wcr::wid::null_id,
-            result.AssetManager().GetId(weng::defaults::NULL_TEXTURE_ASSET_PATH),
-            result.AssetManager().GetId(weng::defaults::NULL_RGBA_TEXTURE_ASSET_PATH),
-            result.AssetManager().GetId(weng::defaults::NULL_NORMAL_TEXTURE_ASSET_PATH)
-            );
+        DefaultRenderPipelines(out_engine.AssetManager());
+
+        DefaultInputAssets(out_engine.AssetManager());
+
+        // Gltf importer
+        out_engine.ImportersRegister()
+            .Register<wim::importer::WImporterGltf>(
+                out_engine.AssetManager().GetId(weng::defaults::PBR_PIPELINE_ASSET_PATH),
+                out_engine.AssetManager().GetId(weng::defaults::PBR_PIPE_PARAMS_NULL_ASSET_PATH),
+                wcr::wid::null_id,
+                out_engine.AssetManager().GetId(weng::defaults::NULL_TEXTURE_ASSET_PATH),
+                out_engine.AssetManager().GetId(weng::defaults::NULL_RGBA_TEXTURE_ASSET_PATH),
+                out_engine.AssetManager().GetId(weng::defaults::NULL_NORMAL_TEXTURE_ASSET_PATH)
+                );
+
+        // TODO Plugins Modules Loading
+    }
+}
 
-    // TODO Plugins Modules Loading
+
+
+WEngine weng::defaults::DefaultEngine() {
+    
+    WEngine result(std::make_unique<WVkRender>());
+
+    DefaultRegister(result);
 
     return result;    
 }
+
+WEngine weng::defaults::HeadlessEngine(double in_fixed_delta_time) {
+
+    WEngine result(std::make_unique<WNullRender>(),
+                   WEngine::HeadlessInfo{in_fixed_delta_time});
+
+    // One simulation tick per frame.
+    WEngine::SimulationInfo simulation = result.Simulation();
+    simulation.fixed_delta_time = in_fixed_delta_time;
+    result.Simulation(simulation);
+
+    DefaultRegister(result);
+
+    return result;
+}
@@ -0,0 +1,248 @@
+#include "WEngine/WLevelStreamer.hpp"
+
+#include "WLog.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace {
+
+    /**
+     * @brief Meshes and textures of in_level not loaded by in_running.
+     */
+    wng::render::LevelResources StagingResources(
+        const wng::render::LevelResources & in_level,
+        const wng::render::LevelResources & in_running
+        ) {
+        wng::render::LevelResources result;
+
+        for (const wcr::wid::WAssetId & id : in_level.static_meshes) {
+            if (!in_running.static_meshes.Contains(id.GetId())) {
+                result.static_meshes.Insert(id.GetId(), id);
+            }
+        }
+
+        for (const wcr::wid::WAssetId & id : in_level.textures) {
+            if (!in_running.textures.Contains(id.GetId())) {
+                result.textures.Insert(id.GetId(), id);
+            }
+        }
+
+        return result;
+    }
+
+}
+
+WLevelStreamer::~WLevelStreamer() {
+    WaitPrepare();
+
+    if (asset_db_) {
+        asset_db_->Unfreeze();
+    }
+}
+
+void WLevelStreamer::Start(const wcr::wid::WAssetId & in_level_id,
+                           WAssetDb & in_asset_db,
+                           bool in_copy,
+                           const was::Level * in_running,
+                           WThreadLib::WJobSystem & in_job_system) {
+    assert(IsIdle());
+
+    progress_.level = in_level_id;
+    copy_ = in_copy;
+    enqueued_ = 0;
+    staged_.store(0, std::memory_order_relaxed);
+    job_system_ = &in_job_system;
+    error_.clear();
+
+    const was::Level * source = &in_asset_db.Get<was::Level>(in_level_id);
+
+    // No asset is created until Finish, asset references stay valid in other threads.
+    asset_db_ = &in_asset_db;
+    asset_db_->Freeze();
+
+    SetProgress(ELevelStreamingState::Preparing, 0);
+
+    wng::render::LevelResources running{};
+
+    // The simulation writes the running level, a referenced asset is not read by the job.
+    if (!copy_ || source == in_running) {
+        try {
+            if (copy_) {
+                level_copy_ = *source;
+            }
+
+            if (in_running) {
+                running = wng::render::CollectResources(in_running, in_asset_db);
+            }
+
+            resources_ = wng::render::CollectResources(
+                copy_ ? &level_copy_ : source,
+                in_asset_db
+                );
+
+            staging_ = StagingResources(resources_, running);
+        }
+        catch (const std::exception & e) {
+            error_ = e.what();
+            Fail();
+            return;
+        }
+
+        BeginStaging();
+        return;
+    }
+
+    // The running level is only read from this thread.
+    try {
+        if (in_running) {
+            running = wng::render::CollectResources(in_running, in_asset_db);
+        }
+    }
+    catch (const std::exception & e) {
+        error_ = e.what();
+        Fail();
+        return;
+    }
+
+    prepare_job_ = in_job_system.Schedule(
+        [this, source, running=std::move(running)]() {
+            // Jobs must not throw, Update reports the error.
+            try {
+                level_copy_ = *source;
+
+                resources_ = wng::render::CollectResources(&level_copy_, *asset_db_);
+
+                staging_ = StagingResources(resources_, running);
+            }
+            catch (const std::exception & e) {
+                error_ = e.what();
+            }
+            catch (...) {
+                error_ = "Unknown error.";
+            }
+        }
+        );
+}
+
+void WLevelStreamer::Update(WRenderThread & in_render_thread) {
+    if (progress_.state == ELevelStreamingState::Preparing) {
+        if (!prepare_job_.IsDone()) return;
+
+        prepare_job_ = {};
+
+        if (!error_.empty()) {
+            Fail();
+            return;
+        }
+
+        BeginStaging();
+    }
+
+    if (progress_.state != ELevelStreamingState::Staging) return;
+
+    const std::size_t mesh_count = staging_.static_meshes.Count();
+    const WAssetDb * asset_db = asset_db_;
+
+    // Resources of the running level are already loaded, only the rest is staged.
+    for (std::size_t i=0; i < budget_ && enqueued_ < progress_.total; i++, enqueued_++) {
+        if (enqueued_ < mesh_count) {
+            wcr::wid::WAssetId id = staging_.static_meshes.DenseData()[enqueued_];
+
+            in_render_thread.Enqueue(
+                [this, id, asset_db](IRender * _render) {
+                    wng::render::LoadStaticMesh(_render, *asset_db, id);
+                    staged_.fetch_add(1, std::memory_order_release);
+                });
+        }
+        else {
+            wcr::wid::WAssetId id = staging_.textures.DenseData()[enqueued_ - mesh_count];
+
+            in_render_thread.Enqueue(
+                [this, id, asset_db](IRender * _render) {
+                    wng::render::LoadTexture(_render, *asset_db, id);
+                    staged_.fetch_add(1, std::memory_order_release);
+                });
+        }
+    }
+
+    std::size_t staged = staged_.load(std::memory_order_acquire);
+
+    SetProgress(staged == progress_.total ?
+                ELevelStreamingState::Ready :
+                ELevelStreamingState::Staging,
+                staged);
+}
+
+void WLevelStreamer::Finish() {
+    WaitPrepare();
+
+    if (asset_db_) {
+        asset_db_->Unfreeze();
+        asset_db_ = nullptr;
+    }
+
+    resources_ = {};
+    staging_ = {};
+    level_copy_ = {};
+    enqueued_ = 0;
+    progress_.total = 0;
+
+    SetProgress(ELevelStreamingState::Idle, 0);
+}
+
+void WLevelStreamer::Cancel(IRender * in_render, const WAssetDb & in_asset_db) {
+    if (IsIdle()) return;
+
+    WaitPrepare();
+
+    // Staged resources are not used by the running level.
+    const std::size_t mesh_count = staging_.static_meshes.Count();
+
+    for (std::size_t i=0; i < enqueued_; i++) {
+        if (i < mesh_count) {
+            wng::render::UnloadStaticMesh(
+                in_render, in_asset_db, staging_.static_meshes.DenseData()[i]
+                );
+        }
+        else {
+            in_render->UnloadTexture(staging_.textures.DenseData()[i - mesh_count]);
+        }
+    }
+
+    WFLOG("[INFO] Level {} streaming canceled.", progress_.level.GetId());
+
+    Finish();
+}
+
+void WLevelStreamer::WaitPrepare() {
+    if (prepare_job_.IsValid()) {
+        job_system_->Wait(prepare_job_);
+        prepare_job_ = {};
+    }
+}
+
+void WLevelStreamer::BeginStaging() {
+    progress_.total = staging_.static_meshes.Count() + staging_.textures.Count();
+
+    SetProgress(ELevelStreamingState::Staging, 0);
+}
+
+void WLevelStreamer::Fail() {
+    WFLOG("[ERROR] Level {} streaming failed: {}", progress_.level.GetId(), error_);
+
+    resources_ = {};
+    staging_ = {};
+    level_copy_ = {};
+
+    SetProgress(ELevelStreamingState::Failed, 0);
+}
+
+void WLevelStreamer::SetProgress(ELevelStreamingState in_state, std::size_t in_staged) {
+    if (progress_.state == in_state && progress_.staged == in_staged) return;
+
+    progress_.state = in_state;
+    progress_.staged = in_staged;
+
+    on_progress_.Emit(progress_);
+}
@@ -0,0 +1,138 @@
+#include "WEngRender/WRenderThread.hpp"
+
+#include <chrono>
+#include <span>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(const Clock::time_point & in_start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - in_start).count();
+    }
+
+}
+
+WRenderThread::WRenderThread(IRender * in_render, bool in_threaded) :
+    render_(in_render),
+    threaded_(in_threaded)
+{
+    if (threaded_) {
+        thread_ = std::thread([this]() { Loop(); });
+    }
+}
+
+WRenderThread::~WRenderThread() {
+    if (!thread_.joinable()) return;
+
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+
+    cv_.notify_all();
+    thread_.join();
+}
+
+double WRenderThread::Publish() {
+    auto start = Clock::now();
+
+    snapshots_[back_].frame = frame_++;
+
+    if (!threaded_) {
+        Draw(render_, commands_[back_], snapshots_[back_]);
+        commands_[back_].clear();
+        snapshots_[back_].Clear();
+
+        double elapsed = ElapsedMs(start);
+        last_draw_ms_.store(elapsed, std::memory_order_relaxed);
+
+        return elapsed;
+    }
+
+    {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this]() { return !pending_; });
+
+        back_ ^= 1;
+        pending_ = true;
+    }
+
+    cv_.notify_all();
+
+    double elapsed = ElapsedMs(start);
+
+    // The render thread is done with the new back snapshot.
+    commands_[back_].clear();
+    snapshots_[back_].Clear();
+
+    return elapsed;
+}
+
+void WRenderThread::Sync() {
+    if (!threaded_) return;
+
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this]() { return !pending_; });
+}
+
+void WRenderThread::Draw(IRender * in_render,
+                         std::vector<CommandFn> & in_commands,
+                         wct::render::RenderSnapshot & in_snapshot) {
+    for (CommandFn & command : in_commands) {
+        command(in_render);
+    }
+
+    if (in_snapshot.has_camera) {
+        in_render->UpdateUboCamera(in_snapshot.camera);
+    }
+
+    for (std::size_t i=0; i < in_snapshot.models.size(); i++) {
+        std::uint8_t * ptr = reinterpret_cast<std::uint8_t *>(&in_snapshot.models[i]);
+
+        in_render->UpdateParameterDynamic(
+            in_snapshot.model_ids[i],
+            {
+                .binding=wct::render::CommonBindings::MODEL_UBO,
+                .data=wct::render::UBORef(ptr, sizeof(wct::render::ModelUBO)),
+                .offset=0
+            }
+            );
+    }
+
+    in_render->UpdatePointLights(
+        std::span(in_snapshot.point_light_ids),
+        std::span(in_snapshot.point_lights)
+        );
+
+    in_render->UpdateDirectionalLights(
+        std::span(in_snapshot.directional_light_ids),
+        std::span(in_snapshot.directional_lights)
+        );
+
+    in_render->Draw();
+}
+
+void WRenderThread::Loop() {
+    std::unique_lock lock(mutex_);
+
+    while (true) {
+        cv_.wait(lock, [this]() { return pending_ || stop_; });
+
+        // Published snapshots are drawn before stopping.
+        if (!pending_) return;
+
+        const std::uint8_t front = back_ ^ 1;
+
+        lock.unlock();
+
+        auto start = Clock::now();
+        Draw(render_, commands_[front], snapshots_[front]);
+        last_draw_ms_.store(ElapsedMs(start), std::memory_order_relaxed);
+
+        lock.lock();
+
+        pending_ = false;
+        cv_.notify_all();
+    }
+}
@@ -15,8 +15,9 @@
 #include <glm/geometric.hpp>
 
 
-START_DEFINE_WSYSTEM(SystemInit_InitializeTransformsMatrix)
-    parameters.engine->LevelInfo().level.ForEachComponent<wcm::Transform>(
+START_DEFINE_WSYSTEM_ACCESS(SystemInit_InitializeTransformsMatrix,
+                            WSystemAccess().Write<wcm::Transform>())
+    parameters.engine->LevelInfo().level->ParallelForEachComponent<wcm::Transform>(
         [&parameters](wcm::Transform * _transform) {
             // WTransformStruct & ts = _transform->TransformStruct();
             
@@ -28,22 +29,31 @@ START_DEFINE_WSYSTEM(SystemInit_InitializeTransformsMatrix)
                         _transform->Get_rotation_order(),
                         _transform->Get_scale()
                         ));
-            
+
+            _transform->StorePrevious();
         }
         );
 END_DEFINE_WSYSTEM()
 
 
-START_DEFINE_WSYSTEM(SystemInit_RenderLevelResources)
+START_DEFINE_WSYSTEM_ACCESS(SystemInit_RenderLevelResources,
+                            WSystemAccess()
+                            .Read<wcm::StaticMesh, wcm::Transform>()
+                            .WriteEngine(EEngineState::Render))
+    // Resources loaded by the level streamer are skipped.
     wng::render::InitializeResources(
         parameters.engine->Render().Ptr(),
         parameters.level,
-        parameters.engine->AssetManager()
+        parameters.engine->AssetManager(),
+        &parameters.engine->LevelStreamer().Resources()
         );
 END_DEFINE_WSYSTEM()
 
 
-START_DEFINE_WSYSTEM(SystemInit_CameraInput)
+START_DEFINE_WSYSTEM_ACCESS(SystemInit_CameraInput,
+                            WSystemAccess()
+                            .Read<wcm::Camera>()
+                            .WriteEngine(EEngineState::Input))
 
     wcr::wid::WEntityId camid;
     parameters.level->GetFirstComponent<wcm::Camera>(camid);
@@ -80,7 +90,9 @@ START_DEFINE_WSYSTEM(SystemInit_CameraInput)
         frontaction,
         [camid](const WInputValuesStruct & _v, was::Action const * _a, WEngine * _e) {
 
-            auto & ic = _e->LevelInfo().level.GetComponent<wcm::CameraInput>(camid);
+            if (!_e->LevelInfo().level->IsAlive(camid)) return;
+
+            auto & ic = _e->LevelInfo().level->GetComponent<wcm::CameraInput>(camid);
 
             switch(_v.input.mode) {
             case EInputMode::Press:
@@ -99,7 +111,9 @@ START_DEFINE_WSYSTEM(SystemInit_CameraInput)
         backaction,
         [camid](const WInputValuesStruct & _v, was::Action const * _a, WEngine * _e) {
 
-            auto & ic = _e->LevelInfo().level.GetComponent<wcm::CameraInput>(camid);
+            if (!_e->LevelInfo().level->IsAlive(camid)) return;
+
+            auto & ic = _e->LevelInfo().level->GetComponent<wcm::CameraInput>(camid);
 
             switch(_v.input.mode) {
             case EInputMode::Press:
@@ -118,7 +132,9 @@ START_DEFINE_WSYSTEM(SystemInit_CameraInput)
         leftaction,
         [camid](const WInputValuesStruct & _v, was::Action const * _a, WEngine * _e) {
 
-            auto & ic = _e->LevelInfo().level.GetComponent<wcm::CameraInput>(camid);
+            if (!_e->LevelInfo().level->IsAlive(camid)) return;
+
+            auto & ic = _e->LevelInfo().level->GetComponent<wcm::CameraInput>(camid);
 
             switch(_v.input.mode) {
             case EInputMode::Press:
@@ -137,7 +153,9 @@ START_DEFINE_WSYSTEM(SystemInit_CameraInput)
         rightaction,
         [camid](const WInputValuesStruct & _v, was::Action const * _a, WEngine * _e) {
 
-            auto & ic = _e->LevelInfo().level.GetComponent<wcm::CameraInput>(camid);
+            if (!_e->LevelInfo().level->IsAlive(camid)) return;
+
+            auto & ic = _e->LevelInfo().level->GetComponent<wcm::CameraInput>(camid);
 
             switch(_v.input.mode) {
             case EInputMode::Press:
@@ -156,8 +174,10 @@ START_DEFINE_WSYSTEM(SystemInit_CameraInput)
         mousemovement,
         [camid](const WInputValuesStruct & _v, was::Action const * _a, WEngine * _e) {
 
+            if (!_e->LevelInfo().level->IsAlive(camid)) return;
+
             auto * transform_component = &_e->LevelInfo()
-                .level.GetComponent<wcm::Transform>(camid);
+                .level->GetComponent<wcm::Transform>(camid);
             
             // WTransformStruct & t = _e->LevelInfo()
             //     .level.GetComponent<wcm::Transform>(camid)
@@ -168,6 +188,8 @@ START_DEFINE_WSYSTEM(SystemInit_CameraInput)
             rot.y = _v.direction.x * -0.001;
 
             transform_component->Set_rotation(rot);
+            // Input runs outside the fixed steps, don't interpolate it a frame behind.
+            transform_component->Set_previous_rotation(rot);
 
             transform_component->Set_transform_matrix(
                 WMath::ToMat4(
@@ -184,36 +206,47 @@ START_DEFINE_WSYSTEM(SystemInit_CameraInput)
 END_DEFINE_WSYSTEM()
 
 
-START_DEFINE_WSYSTEM(SystemPre_UpdateMovement)
-    parameters.level->ForEachComponent<wcm::Movement>(
-        [&parameters](wcm::Movement * mc){
-            wcm::Transform & tc = parameters.level->
-                GetComponent<wcm::Transform>(mc->Get_entity_id());
+START_DEFINE_WSYSTEM_ACCESS(SystemPre_StorePreviousTransforms,
+                            WSystemAccess().Write<wcm::Transform>())
+    parameters.level->ParallelForEachComponent<wcm::Transform>(
+        [](wcm::Transform * _transform) {
+            _transform->StorePrevious();
+        }
+        );
+END_DEFINE_WSYSTEM()
+
 
-            float amag = std::min(glm::length(mc->Get_acceleration()), mc->Get_max_acceleration());
+START_DEFINE_WSYSTEM_ACCESS(SystemPre_UpdateMovement,
+                            WSystemAccess().Write<wcm::Movement, wcm::Transform>())
+    parameters.level->Query<wcm::Movement, wcm::Transform>().ParallelForEach(
+        [&parameters](const wcr::wid::WEntityId & _id,
+                      wcm::Movement & mc,
+                      wcm::Transform & tc) {
+
+            float amag = std::min(glm::length(mc.Get_acceleration()), mc.Get_max_acceleration());
 
             if (amag > 0.0000001) {
-                mc->Set_acceleration(glm::normalize(mc->Get_acceleration()) * amag);
+                mc.Set_acceleration(glm::normalize(mc.Get_acceleration()) * amag);
             }
             else {
-                mc->Set_acceleration(glm::vec3{0});
+                mc.Set_acceleration(glm::vec3{0});
             }
 
-            mc->Set_velocity(
-                mc->Get_velocity() + mc->Get_acceleration() * (float)parameters.engine->EngineCycle().DeltaTime
+            mc.Set_velocity(
+                mc.Get_velocity() + mc.Get_acceleration() * (float)parameters.engine->EngineCycle().FixedDeltaTime
                 );
 
-            float vlength = glm::length(mc->Get_velocity());
-            float vmag = std::min(vlength, mc->Get_max_velocity());
+            float vlength = glm::length(mc.Get_velocity());
+            float vmag = std::min(vlength, mc.Get_max_velocity());
 
             glm::vec3 current_direction{0.00001, 0.00001, 0.00001};
             if(vlength > 0.0000001) {
-                current_direction = glm::normalize(mc->Get_velocity());
+                current_direction = glm::normalize(mc.Get_velocity());
             }
 
-            float drag = mc->Get_drag() * (float)parameters.engine->EngineCycle().DeltaTime;
+            float drag = mc.Get_drag() * (float)parameters.engine->EngineCycle().FixedDeltaTime;
 
-            mc->Set_velocity(
+            mc.Set_velocity(
                 (current_direction * vmag) - (current_direction * vmag * drag)
                 );
 
@@ -221,11 +254,11 @@ START_DEFINE_WSYSTEM(SystemPre_UpdateMovement)
 
             tc.Set_position(
                 tc.Get_position() +
-                mc->Get_velocity() * (float)parameters.engine->EngineCycle().DeltaTime
+                mc.Get_velocity() * (float)parameters.engine->EngineCycle().FixedDeltaTime
                 );
 
             // ts.position +=
-            //     mc->Get_velocity() * (float)parameters.engine->EngineCycle().DeltaTime;
+            //     mc.Get_velocity() * (float)parameters.engine->EngineCycle().FixedDeltaTime;
 
             tc.Set_transform_matrix(
                 WMath::ToMat4(
@@ -245,7 +278,10 @@ START_DEFINE_WSYSTEM(SystemPre_UpdateMovement)
 END_DEFINE_WSYSTEM()
 
 
-START_DEFINE_WSYSTEM(SystemPre_CameraInputMovement)
+START_DEFINE_WSYSTEM_ACCESS(SystemPre_CameraInputMovement,
+                            WSystemAccess()
+                            .Read<wcm::CameraInput, wcm::Transform>()
+                            .Write<wcm::Movement>())
     wcr::wid::WEntityId id;
     auto & ic = parameters.level->GetFirstComponent<wcm::CameraInput>(id);
     auto & tc = parameters.level->GetComponent<wcm::Transform>(id);
@@ -272,33 +308,55 @@ START_DEFINE_WSYSTEM(SystemPre_CameraInputMovement)
 END_DEFINE_WSYSTEM()
 
 
-START_DEFINE_WSYSTEM(SystemPost_UpdateRenderCamera)
-    parameters.level->ForEachComponent<wcm::Camera> (
-        [&parameters] (wcm::Camera * cam) {
-
-            wcm::Transform & ts =
-                parameters.level->GetComponent<wcm::Transform>(
-                    cam->Get_entity_id()
-                    );
+START_DEFINE_WSYSTEM_ACCESS(SystemPost_UpdateRenderCamera,
+                            WSystemAccess()
+                            .Read<wcm::Camera, wcm::Transform>()
+                            .WriteEngine(EEngineState::SnapshotCamera))
+    parameters.level->Query<wcm::Camera, wcm::Transform>().ForEach(
+        [&parameters] (const wcr::wid::WEntityId & _id,
+                       wcm::Camera & cam,
+                       wcm::Transform & ts) {
 
             wct::render::RenderSize rsize = parameters.engine->Render()->RenderSize();
+            wct::render::RenderSnapshot & snapshot = parameters.engine->FrameSnapshot();
 
-            parameters.engine->Render()->UpdateUboCamera(
-                wrd::render::ToUBOCameraStruct(
-                    *cam,
-                    ts,
-                    (float) rsize.width / (float) rsize.height
-                    )
+            snapshot.camera = wrd::render::ToUBOCameraStruct(
+                cam,
+                ts.Interpolated((float) parameters.engine->EngineCycle().Alpha),
+                (float) rsize.width / (float) rsize.height
                 );
+            snapshot.has_camera = true;
         });
 END_DEFINE_WSYSTEM()
 
 
-START_DEFINE_WSYSTEM(SystemEnd_RenderLevelResources)
+START_DEFINE_WSYSTEM_ACCESS(SystemPost_ExtractRenderSnapshot,
+                            WSystemAccess()
+                            .Read<wcm::StaticMesh, wcm::Transform>()
+                            .Read<wcm::light::Point, wcm::light::Directional>()
+                            .WriteEngine(EEngineState::SnapshotScene))
+    wct::render::RenderSnapshot & snapshot = parameters.engine->FrameSnapshot();
+
+    wng::render::ExtractModels(
+        parameters.level,
+        (float) parameters.engine->EngineCycle().Alpha,
+        snapshot
+        );
+
+    wng::render::ExtractLights(parameters.level, snapshot);
+END_DEFINE_WSYSTEM()
+
+
+START_DEFINE_WSYSTEM_ACCESS(SystemEnd_RenderLevelResources,
+                            WSystemAccess()
+                            .Read<wcm::StaticMesh>()
+                            .WriteEngine(EEngineState::Render))
+    // Resources shared with the streamed level stay loaded.
     wng::render::ReleaseRenderResources(
         parameters.engine->Render().Ptr(),
         parameters.level,
-        parameters.engine->AssetManager()
+        parameters.engine->AssetManager(),
+        &parameters.engine->LevelStreamer().Resources()
         );
 END_DEFINE_WSYSTEM()
 
@@ -2,14 +2,18 @@
 
 WSystemsRegister::WSystemsRegister() :
     system_set_(),
+    access_set_(),
     id_pool_()
 {
 }
 
-wcr::wid::WSystemId WSystemsRegister::RegSystem(const char * in_name, const WSystemFn & in_system) {
+wcr::wid::WSystemId WSystemsRegister::RegSystem(const char * in_name,
+                                                const WSystemFn & in_system,
+                                                const WSystemAccess & in_access) {
     wcr::wid::WSystemId id = id_pool_.Generate();
 
     system_set_.Insert(id.GetId(), in_system);
+    access_set_.Insert(id.GetId(), in_access);
 
     name_wid_[in_name] = id;
 
@@ -1,44 +1,65 @@
 #include "WSystems/WSystemsRunner.hpp"
 #include "WCore/WCore.hpp"
 
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(const Clock::time_point & in_start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - in_start).count();
+    }
+
+}
+
 wcr::wid::WLevelSystemId WSystemsRunner::AddInitSystem(const wcr::wid::WAssetId & in_level_id,
                                         const wcr::wid::WSystemId & in_system_id,
-                                        const WSystemFn & in_system) {
+                                        const WSystemFn & in_system,
+                                        const WSystemAccess & in_access) {
     return AddSystem(init_systems_,
-                     ESystemLocation::PRE,
+                     ESystemLocation::INIT,
                      in_level_id,
                      in_system_id,
-                     in_system);
+                     in_system,
+                     in_access);
 }
 
 wcr::wid::WLevelSystemId WSystemsRunner::AddPreSystem(const wcr::wid::WAssetId & in_level_id,
                                        const wcr::wid::WSystemId & in_system_id,
-                                       const WSystemFn & in_system) {
+                                       const WSystemFn & in_system,
+                                       const WSystemAccess & in_access) {
     return AddSystem(pre_systems_,
                      ESystemLocation::PRE,
                      in_level_id,
                      in_system_id,
-                     in_system);
+                     in_system,
+                     in_access);
 }
 
 wcr::wid::WLevelSystemId WSystemsRunner::AddPostSystem(const wcr::wid::WAssetId & in_level_id,
                                         const wcr::wid::WSystemId & in_system_id,
-                                        const WSystemFn & in_system) {
+                                        const WSystemFn & in_system,
+                                        const WSystemAccess & in_access) {
     return AddSystem(post_systems_,
                      ESystemLocation::POST,
                      in_level_id,
                      in_system_id,
-                     in_system);
+                     in_system,
+                     in_access);
 }
 
 wcr::wid::WLevelSystemId WSystemsRunner::AddEndSystem(const wcr::wid::WAssetId & in_level_id,
                                        const wcr::wid::WSystemId & in_system_id,
-                                       const WSystemFn & in_system) {
+                                       const WSystemFn & in_system,
+                                       const WSystemAccess & in_access) {
     return AddSystem(end_systems_,
                      ESystemLocation::END,
                      in_level_id,
                      in_system_id,
-                     in_system);
+                     in_system,
+                     in_access);
 }
 
 void WSystemsRunner::RemoveSystem(const wcr::wid::WLevelSystemId & in_id) {
@@ -46,21 +67,10 @@ void WSystemsRunner::RemoveSystem(const wcr::wid::WLevelSystemId & in_id) {
     wcr::wid::WSystemId sysid;
 
     in_id.ExtractWIds(lvlid, sysid);
-    
-    switch(systemid_location_[in_id]) {
-    case ESystemLocation::INIT:
-        init_systems_[lvlid].Remove(in_id.GetId());
-        break;
-    case ESystemLocation::PRE:
-        pre_systems_[lvlid].Remove(in_id.GetId());
-        break;
-    case ESystemLocation::POST:
-        post_systems_[lvlid].Remove(in_id.GetId());
-        break;
-    case ESystemLocation::END:
-        end_systems_[lvlid].Remove(in_id.GetId());
-        break;
-    }
+
+    Stage & stage = LocationSystems(systemid_location_[in_id])[lvlid];
+    stage.systems.Remove(sysid.GetId());
+    stage.dirty = true;
 
     systemid_location_.extract(in_id);
 }
@@ -83,57 +93,176 @@ void WSystemsRunner::Clear() {
 
 void WSystemsRunner::RunInitSystems(const wcr::wid::WAssetId & in_level_id,
                                     const WSystemParameters & in_parameters) const {
-    if(!init_systems_.contains(in_level_id)) {
-        return;
-    }
-
-    for(auto & fn : init_systems_.at(in_level_id)) {
-        fn(in_parameters);
-    }
+    RunStage(init_systems_, in_level_id, in_parameters);
 }
 
 void WSystemsRunner::RunPreSystems(const wcr::wid::WAssetId & in_level_id,
                                    const WSystemParameters & in_parameters) const {
-    if (!pre_systems_.contains(in_level_id)) return;
-
-    for (auto & fn : pre_systems_.at(in_level_id)) {
-        fn(in_parameters);
-    }
+    RunStage(pre_systems_, in_level_id, in_parameters);
 }
 
 void WSystemsRunner::RunPostSystems(const wcr::wid::WAssetId & in_level_id,
                                     const WSystemParameters & in_parameters) const {
-    if (!post_systems_.contains(in_level_id)) return;
-
-    for (auto & fn : post_systems_.at(in_level_id)) {
-        fn(in_parameters);
-    }
+    RunStage(post_systems_, in_level_id, in_parameters);
 }
 
 void WSystemsRunner::RunEndSystems(const wcr::wid::WAssetId & in_level_id,
                                    const WSystemParameters & in_parameters) const {
-    if (!end_systems_.contains(in_level_id)) return;
+    RunStage(end_systems_, in_level_id, in_parameters);
+}
 
-    for (auto & fn : end_systems_.at(in_level_id)) {
-        fn(in_parameters);
-    }
+WSystemsRunner::StageReport WSystemsRunner::GetStageReport(const wcr::wid::WAssetId & in_level_id,
+                                                           const ESystemLocation & in_location) const {
+    const Systems & systems = LocationSystems(in_location);
+
+    auto it = systems.find(in_level_id);
+    if (it == systems.end()) return {};
+
+    return it->second.report;
 }
 
 wcr::wid::WLevelSystemId WSystemsRunner::AddSystem(Systems & out_system,
                                          const ESystemLocation & in_location,
                                          wcr::wid::WAssetId const & in_level_id,
                                          const wcr::wid::WSystemId & in_system_id,
-                                         const WSystemFn & in_system) {
+                                         const WSystemFn & in_system,
+                                         const WSystemAccess & in_access) {
 
     wcr::wid::WLevelSystemId lvlsysid{in_level_id, in_system_id};
 
-    out_system[in_level_id].Insert(in_system_id.GetId(), in_system);
+    Stage & stage = out_system[in_level_id];
+    stage.systems.Insert(in_system_id.GetId(), SystemEntry{in_system, in_access});
+    stage.dirty = true;
 
     systemid_location_[lvlsysid] = in_location;
 
     return lvlsysid;
-        
+
+}
+
+WSystemsRunner::Systems & WSystemsRunner::LocationSystems(const ESystemLocation & in_location) {
+    switch(in_location) {
+    case ESystemLocation::INIT:
+        return init_systems_;
+    case ESystemLocation::PRE:
+        return pre_systems_;
+    case ESystemLocation::POST:
+        return post_systems_;
+    case ESystemLocation::END:
+    default:
+        return end_systems_;
+    }
+}
+
+const WSystemsRunner::Systems & WSystemsRunner::LocationSystems(const ESystemLocation & in_location) const {
+    return const_cast<WSystemsRunner *>(this)->LocationSystems(in_location);
+}
+
+void WSystemsRunner::RunStage(const Systems & in_systems,
+                              const wcr::wid::WAssetId & in_level_id,
+                              const WSystemParameters & in_parameters) const {
+    auto it = in_systems.find(in_level_id);
+    if (it == in_systems.end()) return;
+
+    const Stage & stage = it->second;
+
+    if (stage.dirty) {
+        BuildStageGraph(stage);
+    }
+
+    const std::size_t count = stage.systems.Count();
+    const SystemEntry * entries = stage.systems.DenseData();
+
+    auto run_system = [&stage, entries, &in_parameters](std::size_t _pos) {
+        auto start = Clock::now();
+        entries[_pos].fn(in_parameters);
+        stage.times_ms[_pos] = ElapsedMs(start);
+    };
+
+    auto start = Clock::now();
+
+    if (stage.serial) {
+        for (std::size_t i=0; i < count; i++) {
+            run_system(i);
+        }
+    }
+    else {
+        WThreadLib::WJobSystem & job_system = job_system_ ?
+            *job_system_ :
+            WThreadLib::DefaultJobSystem();
+
+        WThreadLib::WJobCounter counter;
+        std::vector<WThreadLib::WJobHandle> handles(count);
+        std::vector<WThreadLib::WJobHandle> dependencies;
+
+        for (std::size_t i=0; i < count; i++) {
+            dependencies.clear();
+            for (std::size_t d : stage.dependencies[i]) {
+                dependencies.push_back(handles[d]);
+            }
+
+            handles[i] = job_system.Schedule(
+                [&run_system, i]() { run_system(i); },
+                std::span<const WThreadLib::WJobHandle>(dependencies),
+                &counter
+                );
+        }
+
+        job_system.Wait(counter);
+    }
+
+    UpdateStageReport(stage, ElapsedMs(start));
+}
+
+void WSystemsRunner::BuildStageGraph(const Stage & in_stage) {
+    const std::size_t count = in_stage.systems.Count();
+    const SystemEntry * entries = in_stage.systems.DenseData();
+
+    in_stage.dependencies.assign(count, {});
+    in_stage.times_ms.assign(count, 0.0);
+    in_stage.serial = true;
+
+    for (std::size_t i=0; i < count; i++) {
+        for (std::size_t j=0; j < i; j++) {
+            if (entries[i].access.ConflictsWith(entries[j].access)) {
+                in_stage.dependencies[i].push_back(j);
+            }
+            else {
+                in_stage.serial = false;
+            }
+        }
+    }
+
+    in_stage.dirty = false;
 }
 
+void WSystemsRunner::UpdateStageReport(const Stage & in_stage, double in_wall_ms) {
+    const std::size_t count = in_stage.times_ms.size();
+
+    // Dependencies always point to earlier positions, positions are in topological order.
+    std::vector<double> finish_ms(count, 0.0);
+    std::vector<std::size_t> chain(count, 0);
+
+    StageReport report{};
+    report.system_count = count;
+    report.wall_ms = in_wall_ms;
+
+    for (std::size_t i=0; i < count; i++) {
+        double start_ms = 0.0;
+        std::size_t length = 0;
 
+        for (std::size_t d : in_stage.dependencies[i]) {
+            start_ms = std::max(start_ms, finish_ms[d]);
+            length = std::max(length, chain[d]);
+        }
 
+        finish_ms[i] = start_ms + in_stage.times_ms[i];
+        chain[i] = length + 1;
+
+        report.work_ms += in_stage.times_ms[i];
+        report.critical_path_ms = std::max(report.critical_path_ms, finish_ms[i]);
+        report.critical_path_length = std::max(report.critical_path_length, chain[i]);
+    }
+
+    in_stage.report = report;
+}
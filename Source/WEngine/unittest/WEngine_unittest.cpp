@@ -0,0 +1,218 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include "WSystems/WSystems.hpp"
+#include "WSystems/WSystemsRunner.hpp"
+#include "WEngine/WEngine.hpp"
+#include "WEngine/WEngineDefaults.hpp"
+#include "WAssets/Level.hpp"
+#include "WComponents/Transform.hpp"
+#include "WComponents/Movement.hpp"
+#include "WComponents/Camera.hpp"
+#include "WCore/WThreadLib.hpp"
+#include "WLog.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // Systems are function pointers, test state is global.
+
+    std::atomic<std::uint32_t> running{0};
+    std::atomic<std::uint32_t> max_running{0};
+    std::atomic<std::uint32_t> arrived{0};
+    std::atomic<bool> rendezvous_timeout{false};
+    std::atomic<std::uint32_t> order_counter{0};
+    std::atomic<std::uint32_t> order[4]{};
+
+    void ResetState() {
+        running = 0;
+        max_running = 0;
+        arrived = 0;
+        rendezvous_timeout = false;
+        order_counter = 0;
+        for (auto & o : order) o = 0;
+    }
+
+    void Enter() {
+        std::uint32_t current = running.fetch_add(1) + 1;
+        std::uint32_t max = max_running.load();
+        while (current > max && !max_running.compare_exchange_weak(max, current)) {}
+    }
+
+    void Leave() {
+        running.fetch_sub(1);
+    }
+
+    /**
+     * @brief Waits until both rendezvous systems run, only possible if they run at the same time.
+     */
+    bool RendezvousSystem(const WSystemParameters &) {
+        Enter();
+        arrived.fetch_add(1);
+
+        auto start = std::chrono::steady_clock::now();
+        while (arrived.load() < 2) {
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(2)) {
+                rendezvous_timeout = true;
+                break;
+            }
+            std::this_thread::yield();
+        }
+
+        Leave();
+        return true;
+    }
+
+    template<std::uint32_t N>
+    bool OrderedSystem(const WSystemParameters &) {
+        Enter();
+        order[N] = ++order_counter;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        Leave();
+        return true;
+    }
+
+}
+
+bool WSystemsRunner_Parallel_Test() {
+    ResetState();
+
+    WThreadLib::WJobSystem job_system(2);
+    WSystemsRunner runner;
+    runner.SetJobSystem(&job_system);
+
+    runner.AddPreSystem(0, 1, RendezvousSystem, WSystemAccess().Write<wcm::Transform>());
+    runner.AddPreSystem(0, 2, RendezvousSystem, WSystemAccess().Write<wcm::Movement>());
+
+    runner.RunPreSystems(0, {nullptr, nullptr});
+
+    WSystemsRunner::StageReport report =
+        runner.GetStageReport(0, WSystemsRunner::ESystemLocation::PRE);
+
+    return !rendezvous_timeout &&
+        max_running == 2 &&
+        report.system_count == 2 &&
+        report.critical_path_length == 1;
+}
+
+bool WSystemsRunner_Conflict_Test() {
+    ResetState();
+
+    WThreadLib::WJobSystem job_system(4);
+    WSystemsRunner runner;
+    runner.SetJobSystem(&job_system);
+
+    // Write and read of the same component, a base class write and an undeclared system.
+    runner.AddPreSystem(0, 1, OrderedSystem<0>, WSystemAccess().Write<wcm::Transform>());
+    runner.AddPreSystem(0, 2, OrderedSystem<1>, WSystemAccess().Read<wcm::Transform>());
+    runner.AddPreSystem(0, 3, OrderedSystem<2>, WSystemAccess().Write<WComponent>());
+    runner.AddPreSystem(0, 4, OrderedSystem<3>);
+
+    runner.RunPreSystems(0, {nullptr, nullptr});
+
+    WSystemsRunner::StageReport report =
+        runner.GetStageReport(0, WSystemsRunner::ESystemLocation::PRE);
+
+    return max_running == 1 &&
+        order[0] == 1 && order[1] == 2 && order[2] == 3 && order[3] == 4 &&
+        report.critical_path_length == 4;
+}
+
+bool WSystemsRunner_Order_Test() {
+    WThreadLib::WJobSystem job_system(4);
+    WSystemsRunner runner;
+    runner.SetJobSystem(&job_system);
+
+    // 0 -> 1 -> 2 chain, 3 is independent of all of them.
+    runner.AddPostSystem(0, 1, OrderedSystem<0>,
+                         WSystemAccess().Write<wcm::Transform>());
+    runner.AddPostSystem(0, 2, OrderedSystem<1>,
+                         WSystemAccess().Read<wcm::Transform>().Write<wcm::Movement>());
+    runner.AddPostSystem(0, 3, OrderedSystem<2>,
+                         WSystemAccess().Read<wcm::Movement>().WriteEngine(EEngineState::Render));
+    runner.AddPostSystem(0, 4, OrderedSystem<3>,
+                         WSystemAccess().Read<wcm::Camera>().WriteEngine(EEngineState::Input));
+
+    for (std::uint32_t i=0; i<20; i++) {
+        ResetState();
+
+        runner.RunPostSystems(0, {nullptr, nullptr});
+
+        if (!(order[0] < order[1] && order[1] < order[2])) return false;
+    }
+
+    WSystemsRunner::StageReport report =
+        runner.GetStageReport(0, WSystemsRunner::ESystemLocation::POST);
+
+    WFLOG("Post stage: work {:.3f} ms, critical path {:.3f} ms, wall {:.3f} ms, speedup {:.2f}",
+          report.work_ms, report.critical_path_ms, report.wall_ms, report.Speedup());
+
+    return report.system_count == 4 &&
+        report.critical_path_length == 3 &&
+        report.critical_path_ms < report.work_ms &&
+        report.Parallelism() > 1.0;
+}
+
+bool WSystemAccess_Test() {
+    WSystemAccess camera = WSystemAccess().Read<wcm::Camera, wcm::Transform>()
+        .WriteEngine(EEngineState::SnapshotCamera);
+    WSystemAccess scene = WSystemAccess().Read<wcm::Transform>()
+        .WriteEngine(EEngineState::SnapshotScene);
+    WSystemAccess engine = WSystemAccess().WriteEngine();
+    WSystemAccess undeclared{};
+
+    return !camera.ConflictsWith(scene) &&
+        camera.ConflictsWith(engine) &&
+        scene.ConflictsWith(engine) &&
+        undeclared.ConflictsWith(camera) &&
+        WSystemAccess().Write<wcm::Transform>().ConflictsWith(scene) &&
+        !WSystemAccess().Write<wcm::Movement>().ConflictsWith(scene);
+}
+
+bool WEngine_HeadlessTicks_Test() {
+    WEngine engine = weng::defaults::HeadlessEngine(1.0 / 30.0);
+
+    wcr::wid::WAssetId level_id = engine.AssetManager().Create<was::Level>(
+        "/Content/Test/HeadlessLevel:HeadlessLevel"
+        );
+
+    was::Level & level = engine.AssetManager().Get<was::Level>(level_id);
+
+    wcr::wid::WEntityId camera = level.CreateEntity<WEntity>();
+    level.CreateComponent<wcm::Transform>(camera);
+    level.CreateComponent<wcm::Camera>(camera);
+
+    engine.StartupLevel(level_id);
+
+    constexpr std::size_t frames = 1000;
+    std::vector<WFrameTimingsStruct> timings = engine.RunFrames(frames);
+
+    // Exactly one tick each frame, no drift between the frame and the simulation steps.
+    std::size_t ticks = 0;
+    for (const WFrameTimingsStruct & t : timings) {
+        if (t.simulation_ticks != 1) return false;
+        ticks += t.simulation_ticks;
+    }
+
+    return timings.size() == frames &&
+        ticks == frames &&
+        engine.EngineCycle().FixedDeltaTime == 1.0 / 30.0;
+}
+
+TEST_CASE("WEngine") {
+    SECTION("WSystemsRunner") {
+        CHECK(WSystemAccess_Test());
+        CHECK(WSystemsRunner_Parallel_Test());
+        CHECK(WSystemsRunner_Conflict_Test());
+        CHECK(WSystemsRunner_Order_Test());
+    }
+    SECTION("Headless") {
+        CHECK(WEngine_HeadlessTicks_Test());
+    }
+}
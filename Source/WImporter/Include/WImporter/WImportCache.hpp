@@ -0,0 +1,110 @@
+#pragma once
+
+#include "WCore/WCore.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace wim::importer {
+
+    /**
+     * @brief On disk cache of imported assets, content addressed.
+     *
+     * An entry is a directory of cooked files (see WCookedAsset.hpp) named by its key,
+     * the key hashes the source file bytes with the importer name, version and options,
+     * so an unchanged source imported with the same settings reuses the cooked result.
+     * Entries are written in a temporary directory and renamed when complete.
+     *
+     * Shared by the importers (WImporter::SetImportCache), stats are atomic.
+     */
+    class WIMPORTER_API WImportCache {
+    public:
+
+        struct Stats {
+            std::uint64_t hits{0};
+            std::uint64_t misses{0};
+            // Size of the cooked data loaded on hits, not decoded again.
+            std::uint64_t bytes_saved{0};
+        };
+
+        explicit WImportCache(std::filesystem::path in_directory) noexcept;
+
+        ~WImportCache() = default;
+
+        WImportCache(const WImportCache &) = delete;
+
+        WImportCache(WImportCache &&) = delete;
+
+        WImportCache & operator=(const WImportCache &) = delete;
+
+        WImportCache & operator=(WImportCache &&) = delete;
+
+    public:
+
+        /**
+         * @brief Key of an import, in_sources are the HashFile of every file read by the import.
+         * Change in_version whenever the importer output changes.
+         */
+        static std::uint64_t Key(std::string_view in_importer,
+                                 std::uint32_t in_version,
+                                 std::uint64_t in_options,
+                                 std::span<const std::uint64_t> in_sources) noexcept;
+
+        /**
+         * @brief Hash64 of the file content, the hash of no bytes if it can't be read.
+         */
+        static std::uint64_t HashFile(const std::string & in_path);
+
+        /**
+         * @brief Cooked file in_index of in_name in the entry directory.
+         */
+        static std::string File(const std::filesystem::path & in_entry,
+                                std::string_view in_name,
+                                std::size_t in_index=0);
+
+        /**
+         * @brief Entry directory of in_key, counts a hit or a miss.
+         */
+        std::optional<std::filesystem::path> Find(std::uint64_t in_key);
+
+        /**
+         * @brief Drop an entry that failed to load, its hit is counted as a miss.
+         */
+        void Discard(std::uint64_t in_key);
+
+        /**
+         * @brief Start writing the entry of in_key, files go in the returned directory
+         * and are visible after Commit.
+         */
+        std::filesystem::path Begin(std::uint64_t in_key);
+
+        void Commit(std::uint64_t in_key);
+
+        WNODISCARD Stats GetStats() const noexcept;
+
+        WNODISCARD const std::filesystem::path & Directory() const noexcept {
+            return directory_;
+        }
+
+    private:
+
+        std::filesystem::path EntryPath(std::uint64_t in_key) const;
+
+        std::filesystem::path PendingPath(std::uint64_t in_key) const;
+
+        std::filesystem::path directory_;
+
+        std::atomic<std::uint64_t> hits_{0};
+
+        std::atomic<std::uint64_t> misses_{0};
+
+        std::atomic<std::uint64_t> bytes_saved_{0};
+
+    };
+
+}
@@ -11,6 +11,8 @@ class WAssetDb;
 
 namespace wim::importer {
 
+    class WImportCache;
+
     class WIMPORTER_API WImporter {
 
     public:
@@ -46,6 +48,22 @@ namespace wim::importer {
         virtual std::unique_ptr<WImporter> Clone()=0;
 
         TOptionalRef<WAssetDb> AssetManager();
+
+        /**
+         * @brief Reuse the cooked result of previous imports of the same sources,
+         * shared by copies of the importer. nullptr disables the cache.
+         */
+        void SetImportCache(std::shared_ptr<WImportCache> in_cache) noexcept {
+            import_cache_ = std::move(in_cache);
+        }
+
+        WNODISCARD const std::shared_ptr<WImportCache> & ImportCache() const noexcept {
+            return import_cache_;
+        }
+
+    private:
+
+        std::shared_ptr<WImportCache> import_cache_{};
     
     };
 
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "WImporter/WImporter.hpp"
+
+namespace wim::importer {
+
+    /**
+     * @brief Loads cooked asset files (see WCookedAsset.hpp) written by
+     * was::StaticMesh::Serialize, was::Texture::Serialize and was::Level::Serialize.
+     */
+    class WIMPORTER_API WImporterCooked final : public WImporter
+    {
+
+    public:
+
+        explicit WImporterCooked() noexcept;
+
+        virtual ~WImporterCooked() = default;
+
+        WImporterCooked(const WImporterCooked & in_other) noexcept = default;
+
+        WImporterCooked(WImporterCooked && out_other) noexcept = default;
+
+        WImporterCooked & operator=(const WImporterCooked & in_other) noexcept = default;
+
+        WImporterCooked & operator=(WImporterCooked && out_other) noexcept = default;
+
+        std::unique_ptr<WImporter> Clone() override {
+            return std::make_unique<WImporterCooked>(*this);
+        }
+
+    public:
+
+        std::vector<wcr::wid::WAssetId> Import(
+            WAssetDb & in_asset_manager,
+            std::string_view file_path,
+            std::string_view asset_directory) override;
+
+        constexpr std::vector<std::string_view> Extensions() const noexcept override {
+            return {".wcooked"};
+        }
+
+        constexpr std::vector<std::string_view> Formats() const noexcept override {
+            return {"wcooked"};
+        }
+    };
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "WImporter/WImporter.hpp"
+#include "WCore/WThreadLib.hpp"
 
 namespace wim::importer {
     
@@ -36,6 +37,11 @@ namespace wim::importer {
 
     public:
 
+        /**
+         * @brief Changes invalidate the WImportCache entries of this importer.
+         */
+        static constexpr std::uint32_t CACHE_VERSION{1};
+
         std::vector<wcr::wid::WAssetId> Import(
             WAssetDb & in_asset_manager,
             std::string_view file_path,
@@ -47,6 +53,14 @@ namespace wim::importer {
 
         virtual std::unique_ptr<WImporter> Clone() override;
 
+        /**
+         * @brief Job system decoding the images and the mesh primitives,
+         * nullptr uses WThreadLib::DefaultJobSystem.
+         */
+        void SetJobSystem(WThreadLib::WJobSystem * in_job_system) noexcept {
+            job_system_ = in_job_system;
+        }
+
     private:
 
         struct RenderPipelines {
@@ -62,6 +76,8 @@ namespace wim::importer {
             
         } textures_{};
 
+        WThreadLib::WJobSystem * job_system_{nullptr};
+
     };
     
 }
@@ -27,6 +27,11 @@ namespace wim::importer {
 
     public:
 
+        /**
+         * @brief Changes invalidate the WImportCache entries of this importer.
+         */
+        static constexpr std::uint32_t CACHE_VERSION{1};
+
         std::vector<wcr::wid::WAssetId> Import(
             WAssetDb & in_asset_manager,
             std::string_view file_path,
@@ -24,6 +24,11 @@ namespace wim::importer {
         std::unique_ptr<WImporter> Clone() override { return std::make_unique<WImportTexture>(*this); }
 
     public:
+
+        /**
+         * @brief Changes invalidate the WImportCache entries of this importer.
+         */
+        static constexpr std::uint32_t CACHE_VERSION{1};
     
         std::vector<wcr::wid::WAssetId> Import(
             WAssetDb & in_asset_manager,
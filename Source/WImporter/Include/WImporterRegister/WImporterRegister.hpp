@@ -63,6 +63,15 @@ namespace wim::imp_register {
             }
         }
 
+        /**
+         * @brief Set the import cache of the registered importers.
+         */
+        void SetImportCache(const std::shared_ptr<wim::importer::WImportCache> & in_cache) {
+            for(auto& p : reg_) {
+                p.second->SetImportCache(in_cache);
+            }
+        }
+
         template<typename T, typename ...Args>
         void Register(Args && ... args) {
             assert(!reg_.contains( std::type_index(typeid(T)) ));
@@ -0,0 +1,123 @@
+#include "WImporter/WImportCache.hpp"
+#include "WCore/WHash.hpp"
+#include "WCore/WMappedFile.hpp"
+#include "WObjects/WCookedAsset.hpp"
+#include "WLog.hpp"
+
+#include <format>
+#include <system_error>
+
+namespace {
+
+    std::uint64_t DirectorySize(const std::filesystem::path & in_directory) {
+        std::error_code ec;
+        std::uint64_t result = 0;
+
+        for (const auto & entry : std::filesystem::directory_iterator(in_directory, ec)) {
+            if (entry.is_regular_file(ec)) {
+                result += entry.file_size(ec);
+            }
+        }
+
+        return result;
+    }
+
+}
+
+// WImportCache
+// ------------
+
+wim::importer::WImportCache::WImportCache(std::filesystem::path in_directory) noexcept :
+    directory_(std::move(in_directory)) {}
+
+std::uint64_t wim::importer::WImportCache::Key(std::string_view in_importer,
+                                               std::uint32_t in_version,
+                                               std::uint64_t in_options,
+                                               std::span<const std::uint64_t> in_sources) noexcept {
+    // Cooked layout changes invalidate the entries too.
+    std::uint64_t seed = wcr::hash::HashValues(
+        wcr::hash::Hash64(in_importer),
+        in_version,
+        was::cooked::VERSION,
+        in_options
+        );
+
+    return wcr::hash::Hash64(std::as_bytes(in_sources), seed);
+}
+
+std::uint64_t wim::importer::WImportCache::HashFile(const std::string & in_path) {
+    WMappedFile file;
+
+    if (!file.Open(in_path)) {
+        return wcr::hash::Hash64(std::span<const std::byte>{});
+    }
+
+    return wcr::hash::Hash64(std::span<const std::byte>(file.Data(), file.Size()));
+}
+
+std::string wim::importer::WImportCache::File(const std::filesystem::path & in_entry,
+                                              std::string_view in_name,
+                                              std::size_t in_index) {
+    return (in_entry / std::format("{}_{}{}", in_name, in_index, was::cooked::EXTENSION)).string();
+}
+
+std::optional<std::filesystem::path> wim::importer::WImportCache::Find(std::uint64_t in_key) {
+    std::filesystem::path entry = EntryPath(in_key);
+
+    std::error_code ec;
+    if (!std::filesystem::is_directory(entry, ec)) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    bytes_saved_.fetch_add(DirectorySize(entry), std::memory_order_relaxed);
+
+    return entry;
+}
+
+void wim::importer::WImportCache::Discard(std::uint64_t in_key) {
+    std::filesystem::path entry = EntryPath(in_key);
+
+    WFLOG_Warning("Invalid import cache entry {}, removed.", entry.string());
+
+    hits_.fetch_sub(1, std::memory_order_relaxed);
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    bytes_saved_.fetch_sub(DirectorySize(entry), std::memory_order_relaxed);
+
+    std::error_code ec;
+    std::filesystem::remove_all(entry, ec);
+}
+
+std::filesystem::path wim::importer::WImportCache::Begin(std::uint64_t in_key) {
+    std::filesystem::path pending = PendingPath(in_key);
+
+    // Left by an import that failed while writing.
+    std::filesystem::remove_all(pending);
+    std::filesystem::create_directories(pending);
+
+    return pending;
+}
+
+void wim::importer::WImportCache::Commit(std::uint64_t in_key) {
+    std::filesystem::path entry = EntryPath(in_key);
+
+    std::filesystem::remove_all(entry);
+    std::filesystem::rename(PendingPath(in_key), entry);
+}
+
+wim::importer::WImportCache::Stats wim::importer::WImportCache::GetStats() const noexcept {
+    return {
+        hits_.load(std::memory_order_relaxed),
+        misses_.load(std::memory_order_relaxed),
+        bytes_saved_.load(std::memory_order_relaxed)
+    };
+}
+
+std::filesystem::path wim::importer::WImportCache::EntryPath(std::uint64_t in_key) const {
+    return directory_ / std::format("{:016x}", in_key);
+}
+
+std::filesystem::path wim::importer::WImportCache::PendingPath(std::uint64_t in_key) const {
+    return directory_ / std::format("{:016x}.pending", in_key);
+}
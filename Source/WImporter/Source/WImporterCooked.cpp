@@ -0,0 +1,60 @@
+#include "WImporter/WImporterCooked.hpp"
+#include "WObjects/WCookedAsset.hpp"
+#include "WAssets/StaticMesh.hpp"
+#include "WAssets/Texture.hpp"
+#include "WAssets/Level.hpp"
+#include "WObjectDb/WAssetDb.hpp"
+#include "WString/WString.hpp"
+
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+
+namespace {
+
+    template<typename T>
+    wcr::wid::WAssetId CreateCooked(WAssetDb & in_asset_manager,
+                                    const std::string & in_file_path,
+                                    std::string_view in_asset_directory) {
+        std::string name = std::filesystem::path(in_file_path).stem().string();
+
+        auto valid_names = in_asset_manager
+            .GenValidAssetName<T>(in_asset_directory, name, name);
+
+        wcr::wid::WAssetId id = in_asset_manager.Create<T>(
+            wstr::AssetPath(
+                in_asset_directory,
+                valid_names[0],
+                valid_names[1])
+            );
+
+        in_asset_manager.Get<T>(id).Deserialize(in_file_path);
+
+        return id;
+    }
+
+}
+
+// WImporterCooked
+// ---------------
+
+wim::importer::WImporterCooked::WImporterCooked() noexcept {}
+
+std::vector<wcr::wid::WAssetId> wim::importer::WImporterCooked::Import(
+    WAssetDb & in_asset_manager,
+    std::string_view file_path,
+    std::string_view asset_directory)
+{
+    std::string path{file_path};
+
+    switch (was::cooked::ReadAssetKind(path)) {
+    case was::cooked::EAssetKind::StaticMesh:
+        return { CreateCooked<was::StaticMesh>(in_asset_manager, path, asset_directory) };
+    case was::cooked::EAssetKind::Texture:
+        return { CreateCooked<was::Texture>(in_asset_manager, path, asset_directory) };
+    case was::cooked::EAssetKind::Level:
+        return { CreateCooked<was::Level>(in_asset_manager, path, asset_directory) };
+    default:
+        throw std::runtime_error(std::format("{} is not a valid cooked asset.", path));
+    }
+}
@@ -2,6 +2,7 @@
 #include "WCore/WCore.hpp"
 #include "WCore/WDebug.hpp"
 #include "WImporter/WImporterGltf.hpp"
+#include "WImporter/WImportCache.hpp"
 #include "WAssets/Texture.hpp"
 #include "WAssets/Level.hpp"
 #include "WComponents/Light/Directional.hpp"
@@ -28,7 +29,11 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/type_trait.hpp>
 
+#include <cstring>
+#include <exception>
+#include <filesystem>
 #include <limits>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 #include <unordered_set>
@@ -136,13 +141,21 @@ namespace {
             WrapTFilter(sampler.wrapT);
     }
 
-    WNODISCARD inline fastgltf::Asset LoadGltf(std::string_view file_path) {
+    constexpr auto GLTF_OPTIONS =
+        fastgltf::Options::DontRequireValidAssetMember |
+        fastgltf::Options::AllowDouble;
+
+    /**
+     * @brief Parse a gltf file, without in_external_buffers only the json and
+     * the glb binary chunk are read.
+     */
+    WNODISCARD inline fastgltf::Asset LoadGltf(std::string_view file_path,
+                                               bool in_external_buffers=true) {
         fastgltf::Parser parser {};
 
-        constexpr auto gltfOptions =
-            fastgltf::Options::DontRequireValidAssetMember |
-            fastgltf::Options::AllowDouble                 |
-            fastgltf::Options::LoadExternalBuffers;
+        const auto gltfOptions = in_external_buffers ?
+            GLTF_OPTIONS | fastgltf::Options::LoadExternalBuffers :
+            GLTF_OPTIONS;
 
         auto data = fastgltf::GltfDataBuffer::FromPath(file_path);
 
@@ -448,6 +461,76 @@ namespace {
         }
     }
 
+    /**
+     * @brief Run in_fn(i) for each index in [0, in_count), each one as an independent job.
+     * Jobs may throw, all of them run and the first exception is rethrown at the end.
+     */
+    template<typename TFn>
+    inline void ParallelCollect(
+        WThreadLib::WJobSystem & in_job_system,
+        std::size_t in_count,
+        TFn && in_fn
+        ) {
+        std::vector<std::exception_ptr> errors(in_count);
+
+        in_job_system.ParallelFor(
+            0, in_count, 1,
+            [&in_fn, &errors](std::size_t _index) {
+                try {
+                    in_fn(_index);
+                }
+                catch (...) {
+                    errors[_index] = std::current_exception();
+                }
+            }
+            );
+
+        for (std::exception_ptr & error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Copy in_accessor to out_values, resized to the accessor count.
+     * Tightly packed accessors with the layout of T are copied with one memcpy,
+     * the rest are converted by fastgltf::copyFromAccessor.
+     */
+    template<typename T>
+    inline void CopyAccessor(
+        fastgltf::Asset const & in_asset,
+        fastgltf::Accessor const & in_accessor,
+        std::vector<T> & out_values
+        ) {
+        using Traits = fastgltf::ElementTraits<T>;
+
+        out_values.resize(in_accessor.count);
+
+        if (in_accessor.count == 0) return;
+
+        if (in_accessor.bufferViewIndex.has_value() &&
+            !in_accessor.sparse.has_value() &&
+            !in_accessor.normalized &&
+            in_accessor.type == Traits::type &&
+            in_accessor.componentType == Traits::enum_component_type &&
+            fastgltf::getElementByteSize(in_accessor.type, in_accessor.componentType) == sizeof(T)) {
+
+            std::size_t view_index = in_accessor.bufferViewIndex.value();
+            auto const & view = in_asset.bufferViews[view_index];
+
+            if (!view.byteStride.has_value() || view.byteStride.value() == sizeof(T)) {
+                auto bytes = fastgltf::DefaultBufferDataAdapter{}(in_asset, view_index);
+                std::size_t size = in_accessor.count * sizeof(T);
+
+                if (in_accessor.byteOffset + size <= bytes.size()) {
+                    std::memcpy(out_values.data(), bytes.data() + in_accessor.byteOffset, size);
+                    return;
+                }
+            }
+        }
+
+        fastgltf::copyFromAccessor<T>(in_asset, in_accessor, out_values.data());
+    }
+
     WNODISCARD inline
     wct::geometry::WMesh CollectMeshPrimitive(
         fastgltf::Asset const & in_asset,
@@ -477,87 +560,64 @@ namespace {
             const fastgltf::Accessor& index_accessor =
                 in_asset.accessors.at(in_primitive.indicesAccessor.value());
 
-            result.indices.reserve(index_accessor.count);
-
-            fastgltf::iterateAccessor<std::uint32_t>(
-                in_asset, index_accessor,
-                [&indices=result.indices]
-                (std::uint32_t idx) {
-                    indices.push_back(idx);
-                }
-                );
+            CopyAccessor(in_asset, index_accessor, result.indices);
         }
-            
-        // Get vertex positions
-        {
-            const fastgltf::Accessor & pos_accessor =
-                in_asset.accessors.at(in_primitive.findAttribute("POSITION")->accessorIndex);
 
-            result.vertices.resize(pos_accessor.count);
+        // Attributes are copied in bulk to SoA columns and interleaved in one pass,
+        // instead of walking the vertices once per attribute.
+        const fastgltf::Accessor & pos_accessor =
+            in_asset.accessors.at(in_primitive.findAttribute("POSITION")->accessorIndex);
 
-            fastgltf::iterateAccessorWithIndex<glm::vec3>(
-                in_asset, pos_accessor,
-                [&vertex=result.vertices]
-                (auto && vert_pos, std::size_t index) {
-                    vertex[index].position = vert_pos;
-                }
-                );
-        }
+        const std::size_t count = pos_accessor.count;
 
-        // Get normals
-        {
-            auto normals = in_primitive.findAttribute("NORMAL");
-            if (normals != in_primitive.attributes.end()) {
-                fastgltf::iterateAccessorWithIndex<glm::vec3>(
-                    in_asset, in_asset.accessors[normals->accessorIndex],
-                    [&vertex=result.vertices]
-                    (auto && normal, std::size_t index) {
-                        vertex[index].normal = normal;
-                    }
-                    );
-            }
-        }
+        std::vector<glm::vec3> positions;
+        CopyAccessor(in_asset, pos_accessor, positions);
 
-        // Get Tangents
-        {
-            auto tangents = in_primitive.findAttribute("TANGENT");
-            if (tangents != in_primitive.attributes.end()) {
-                fastgltf::iterateAccessorWithIndex<glm::vec4>(
-                    in_asset, in_asset.accessors[tangents->accessorIndex],
-                    [&vertex=result.vertices]
-                    (auto && tangent, std::size_t index) {
-                        vertex[index].tangent = tangent;
-                    }
-                    );
-            }
-        }
-
-        // Get Tex Coords 0
-        {
-            auto uv = in_primitive.findAttribute("TEXCOORD_0");
-            if (uv != in_primitive.attributes.end()) {
-                fastgltf::iterateAccessorWithIndex<glm::vec2>(
-                    in_asset, in_asset.accessors[uv->accessorIndex],
-                    [&vertex=result.vertices]
-                    (auto && coords, std::size_t index) {
-                        vertex[index].tex_coords = coords;
-                    }
-                    );
-            }
-        }
+        // Missing attributes are left empty.
+        auto CopyAttribute = [&in_asset, &in_primitive, count]
+            <typename T>
+            (std::string_view _name, std::vector<T> & _values) {
+                auto attribute = in_primitive.findAttribute(_name);
+                if (attribute != in_primitive.attributes.end()) {
+                    CopyAccessor(in_asset, in_asset.accessors[attribute->accessorIndex], _values);
+                    _values.resize(count);
+                }
+            };
 
-        // Get colors
-        {
-            auto colors = in_primitive.findAttribute("COLOR_0");
-            if (colors != in_primitive.attributes.end()) {
-                fastgltf::iterateAccessorWithIndex<glm::vec4>(
-                    in_asset, in_asset.accessors[colors->accessorIndex],
-                    [&vertex=result.vertices]
-                    (auto && color, std::size_t index) {
-                        vertex[index].color = color;
-                    }
-                    );
-            }
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec4> tangents;
+        std::vector<glm::vec2> tex_coords;
+        std::vector<glm::vec4> colors;
+
+        CopyAttribute("NORMAL", normals);
+        CopyAttribute("TANGENT", tangents);
+        CopyAttribute("TEXCOORD_0", tex_coords);
+        CopyAttribute("COLOR_0", colors);
+
+        // Empty columns read a zero value with a zero step, no branches in the loop.
+        const glm::vec3 zero3{0.f};
+        const glm::vec4 zero4{0.f};
+        const glm::vec2 zero2{0.f};
+
+        const glm::vec3 * normal = normals.empty() ? &zero3 : normals.data();
+        const glm::vec4 * tangent = tangents.empty() ? &zero4 : tangents.data();
+        const glm::vec2 * tex_coord = tex_coords.empty() ? &zero2 : tex_coords.data();
+        const glm::vec4 * color = colors.empty() ? &zero4 : colors.data();
+
+        const std::size_t normal_step = normals.empty() ? 0 : 1;
+        const std::size_t tangent_step = tangents.empty() ? 0 : 1;
+        const std::size_t tex_coord_step = tex_coords.empty() ? 0 : 1;
+        const std::size_t color_step = colors.empty() ? 0 : 1;
+
+        result.vertices.resize(count);
+        wct::geometry::WVertex * vertices = result.vertices.data();
+
+        for (std::size_t i=0; i<count; i++) {
+            vertices[i].position = positions[i];
+            vertices[i].tex_coords = tex_coord[i * tex_coord_step];
+            vertices[i].color = color[i * color_step];
+            vertices[i].normal = normal[i * normal_step];
+            vertices[i].tangent = tangent[i * tangent_step];
         }
 
         return result;
@@ -569,7 +629,9 @@ namespace {
         wcr::wid::WAssetId gbuffer_pipeline,
         wcr::wid::WAssetId null_pipe_params,
         wcr::wid::WAssetId transparent_pipeline,
-        std::vector<wcr::wid::WAssetId> const & parameters
+        std::vector<wcr::wid::WAssetId> const & parameters,
+        WThreadLib::WJobSystem & in_job_system,
+        std::vector<was::StaticMesh> * in_cached=nullptr
         ) {
         std::vector<NullableIndex<>> index_sm_map{};
         index_sm_map.reserve(in_asset.meshes.size());
@@ -580,23 +642,33 @@ namespace {
         std::vector<std::string_view> sm_names;
         sm_names.reserve(in_asset.meshes.size());
 
+        // Primitive geometry collected in parallel, each job writes its own mesh slot.
+        struct PrimitiveJob {
+            std::size_t asset_index;
+            std::size_t prim_indx;
+            fastgltf::Primitive const * primitive;
+        };
+
+        std::vector<PrimitiveJob> primitive_jobs;
+
         for (fastgltf::Mesh const & mesh : in_asset.meshes) {
 
             was::StaticMesh sm_asset{};
 
+            // Cached geometry, the pipeline assignments are set below.
+            if (in_cached && !mesh.primitives.empty()) {
+                sm_asset = std::move((*in_cached)[sm_assets.size()]);
+            }
+
             std::size_t prim_indx=0;
             while(prim_indx < mesh.primitives.size() &&
                   prim_indx < sm_asset.Get_meshes().max_size()) {
 
                 auto & primitive = mesh.primitives[prim_indx];
 
-                sm_asset.SetMesh(
-                    CollectMeshPrimitive(
-                        in_asset,
-                        primitive
-                        ),
-                    prim_indx
-                    );
+                if (!in_cached) {
+                    primitive_jobs.push_back({sm_assets.size(), prim_indx, &primitive});
+                }
 
                 if (primitive.materialIndex &&
                     primitive.materialIndex.value() < parameters.size()) {
@@ -630,6 +702,22 @@ namespace {
             }
         }
 
+        ParallelCollect(
+            in_job_system,
+            primitive_jobs.size(),
+            [&in_asset, &primitive_jobs, &sm_assets](std::size_t _index) {
+                PrimitiveJob const & job = primitive_jobs[_index];
+
+                sm_assets[job.asset_index].SetMesh(
+                    CollectMeshPrimitive(
+                        in_asset,
+                        *job.primitive
+                        ),
+                    job.prim_indx
+                    );
+            }
+            );
+
         return std::tuple{std::move(index_sm_map),
                           std::move(sm_assets),
                           std::move(sm_names)};
@@ -740,7 +828,9 @@ namespace {
 
     WNODISCARD inline
     auto CollectTextures(
-        fastgltf::Asset const & in_asset
+        fastgltf::Asset const & in_asset,
+        WThreadLib::WJobSystem & in_job_system,
+        std::vector<was::Texture> * in_cached=nullptr
         ) {
         std::vector<NullableIndex<>> text_assets_map{};
         text_assets_map.resize(in_asset.textures.size(), wcr::wid::null_id);
@@ -751,32 +841,57 @@ namespace {
         std::vector<std::string_view> text_names{};
         text_names.reserve(in_asset.textures.size());
 
+        // Gltf texture of each asset, decoded in parallel into its own slot.
+        std::vector<std::size_t> text_indices{};
+        text_indices.reserve(in_asset.textures.size());
+
         std::size_t idx=0;
 
         for (auto & text : in_asset.textures) {
             if (text.imageIndex.has_value()) {
+                text_assets_map[idx] = text_assets.size();
 
-                auto imgidx = text.imageIndex.value();
-
-                auto const & img = in_asset.images[imgidx];
+                if (in_cached) {
+                    text_assets.push_back(std::move((*in_cached)[text_assets.size()]));
+                }
+                else {
+                    text_assets.emplace_back();
+                }
 
-                text_assets.push_back(CollectImage(in_asset, img));
+                text_names.push_back(wstr::CleanBasename(text.name));
+                text_indices.push_back(idx);
+            } 
 
-                text_assets.back().AddRGBAPadding();
+            idx++;
+        }
 
-                text_names.push_back(wstr::CleanBasename(text.name));
+        if (!in_cached) {
+            ParallelCollect(
+                in_job_system,
+                text_assets.size(),
+                [&in_asset, &text_assets, &text_indices](std::size_t _index) {
+                    auto & text = in_asset.textures[text_indices[_index]];
 
-                if (text.samplerIndex.has_value()) {
-                    auto sampleridx = text.samplerIndex.value();
-                    
-                    text_assets.back().Set_sampler(
-                        ToESampler(in_asset.samplers[sampleridx])
+                    text_assets[_index] = CollectImage(
+                        in_asset,
+                        in_asset.images[text.imageIndex.value()]
                         );
+
+                    text_assets[_index].AddRGBAPadding();
                 }
-                text_assets_map[idx] = text_assets.size()-1;
-            } 
+                );
+        }
 
-            idx++;
+        for (std::size_t i=0; i<text_assets.size(); i++) {
+            auto & text = in_asset.textures[text_indices[i]];
+
+            if (text.samplerIndex.has_value()) {
+                auto sampleridx = text.samplerIndex.value();
+
+                text_assets[i].Set_sampler(
+                    ToESampler(in_asset.samplers[sampleridx])
+                    );
+            }
         }
 
         return std::tuple{std::move(text_assets_map),
@@ -1111,6 +1226,103 @@ namespace {
         }
         return result;
     }
+
+    /**
+     * @brief Files read by the import: the gltf file and its external buffers and images.
+     */
+    WNODISCARD inline
+    std::vector<std::uint64_t> HashSources(
+        fastgltf::Asset const & in_asset,
+        std::string_view file_path
+        ) {
+        std::filesystem::path directory = std::filesystem::path(file_path).parent_path();
+
+        std::vector<std::uint64_t> result;
+        result.push_back(wim::importer::WImportCache::HashFile(std::string(file_path)));
+
+        auto hash_uri = [&result, &directory](auto const & _data) {
+            if (auto uri = std::get_if<fastgltf::sources::URI>(&_data)) {
+                result.push_back(
+                    wim::importer::WImportCache::HashFile(
+                        (directory / uri->uri.fspath()).string()
+                        )
+                    );
+            }
+        };
+
+        for (auto & buffer : in_asset.buffers) {
+            hash_uri(buffer.data);
+        }
+
+        for (auto & image : in_asset.images) {
+            hash_uri(image.data);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Decoded textures and static mesh geometry of a cached import,
+     * in the order CollectTextures and CollectStaticMeshes create them.
+     */
+    struct CachedAssets {
+        std::vector<was::Texture> textures{};
+        std::vector<was::StaticMesh> static_meshes{};
+    };
+
+    WNODISCARD inline
+    std::optional<CachedAssets> LoadCached(
+        fastgltf::Asset const & in_asset,
+        wim::importer::WImportCache & in_cache,
+        std::uint64_t in_key
+        ) {
+        std::optional<std::filesystem::path> entry = in_cache.Find(in_key);
+
+        if (!entry) return std::nullopt;
+
+        CachedAssets result;
+
+        try {
+            for (auto & text : in_asset.textures) {
+                if (!text.imageIndex.has_value()) continue;
+
+                // emplace_back runs before the File argument, the index is taken first.
+                std::size_t index = result.textures.size();
+                result.textures.emplace_back().Deserialize(
+                    wim::importer::WImportCache::File(*entry, "texture", index)
+                    );
+            }
+
+            for (auto & mesh : in_asset.meshes) {
+                if (mesh.primitives.empty()) continue;
+
+                // emplace_back runs before the File argument, the index is taken first.
+                std::size_t index = result.static_meshes.size();
+                result.static_meshes.emplace_back().Deserialize(
+                    wim::importer::WImportCache::File(*entry, "mesh", index)
+                    );
+            }
+        }
+        catch (const std::exception &) {
+            in_cache.Discard(in_key);
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    template<typename T>
+    inline void WriteCached(
+        std::vector<T> & in_assets,
+        std::string_view in_name,
+        std::filesystem::path const & in_entry
+        ) {
+        for (std::size_t i=0; i<in_assets.size(); i++) {
+            in_assets[i].Serialize(
+                wim::importer::WImportCache::File(in_entry, in_name, i)
+                );
+        }
+    }
 }
 
 std::vector<wcr::wid::WAssetId> wim::importer::WImporterGltf::Import(
@@ -1119,11 +1331,67 @@ std::vector<wcr::wid::WAssetId> wim::importer::WImporterGltf::Import(
     std::string_view engine_directory_prefix
     ) {
 
-    fastgltf::Asset gltf_asset=LoadGltf(file_path);
+    const std::shared_ptr<WImportCache> & cache = ImportCache();
+
+    std::uint64_t key{0};
+    std::optional<CachedAssets> cached{};
+    std::filesystem::path pending{};
+
+    fastgltf::Asset gltf_asset;
+
+    if (cache) {
+        // The json is enough for the key and for the assets built on top of the cached ones,
+        // external buffers are loaded on a miss only.
+        gltf_asset = LoadGltf(file_path, false);
+
+        std::vector<std::uint64_t> sources = HashSources(gltf_asset, file_path);
+        key = WImportCache::Key(
+            "WImporterGltf",
+            CACHE_VERSION,
+            static_cast<std::uint64_t>(GLTF_OPTIONS),
+            sources
+            );
+
+        cached = LoadCached(gltf_asset, *cache, key);
+
+        if (!cached) {
+            gltf_asset = LoadGltf(file_path);
+
+            try {
+                pending = cache->Begin(key);
+            }
+            catch (const std::exception & e) {
+                WFLOG_Warning("Can't cache {}: {}", file_path, e.what());
+            }
+        }
+    }
+    else {
+        gltf_asset = LoadGltf(file_path);
+    }
+
+    // Textures and static meshes are collected in parallel, assets are created
+    // in gltf order afterwards so the asset ids don't depend on the scheduling.
+    WThreadLib::WJobSystem & job_system = job_system_ ?
+        *job_system_ :
+        WThreadLib::DefaultJobSystem();
 
     // Materials and textures
     
-    auto [textures_map, text_assets, textures_names] = CollectTextures(gltf_asset);
+    auto [textures_map, text_assets, textures_names] = CollectTextures(
+        gltf_asset,
+        job_system,
+        cached ? &cached->textures : nullptr
+        );
+
+    if (!pending.empty()) {
+        try {
+            WriteCached(text_assets, "texture", pending);
+        }
+        catch (const std::exception & e) {
+            WFLOG_Warning("Can't cache {}: {}", file_path, e.what());
+            pending.clear();
+        }
+    }
 
     // Create Texture Assets
     auto textures_wids = CreateTextures(
@@ -1158,9 +1426,21 @@ std::vector<wcr::wid::WAssetId> wim::importer::WImporterGltf::Import(
         render_pipelines_.pbr_opaque,
         render_pipelines_.pbr_param,
         render_pipelines_.transparent,
-        materials_wid
+        materials_wid,
+        job_system,
+        cached ? &cached->static_meshes : nullptr
         );
 
+    if (!pending.empty()) {
+        try {
+            WriteCached(sm_assets, "mesh", pending);
+            cache->Commit(key);
+        }
+        catch (const std::exception & e) {
+            WFLOG_Warning("Can't cache {}: {}", file_path, e.what());
+        }
+    }
+
     auto sm_wid = CreateStaticMeshes(
         sm_assets,
         sm_names,
@@ -1,7 +1,13 @@
 #include "WImporter/WImporterObj.hpp"
+#include "WImporter/WImportCache.hpp"
 #include "WCoreTypes/WGeometry.hpp"
 #include "WAssets/StaticMesh.hpp"
 #include "WObjectDb/WAssetDb.hpp"
+#include "WLog.hpp"
+
+#include <exception>
+#include <filesystem>
+#include <optional>
 
 #ifndef TINYOBJLOADER_IMPLEMENTATION
 #define TINYOBJLOADER_IMPLEMENTATION
@@ -19,6 +25,31 @@ std::vector<wcr::wid::WAssetId> wim::importer::WImporterObj::Import(
     std::string_view asset_directory
     )
 {
+    const std::shared_ptr<WImportCache> & cache = ImportCache();
+
+    std::uint64_t key{0};
+
+    if (cache) {
+        std::uint64_t source = WImportCache::HashFile(std::string(file_path));
+        key = WImportCache::Key("WImporterObj", CACHE_VERSION, 0, {&source, 1});
+
+        // Skips the obj parsing and the vertex deduplication.
+        if (std::optional<std::filesystem::path> cached = cache->Find(key)) {
+            was::StaticMesh static_mesh{};
+
+            try {
+                static_mesh.Deserialize(WImportCache::File(*cached, "mesh"));
+
+                return {
+                    in_asset_manager.CreateFrom<was::StaticMesh>("StaticMesh", std::move(static_mesh))
+                };
+            }
+            catch (const std::exception &) {
+                cache->Discard(key);
+            }
+        }
+    }
+
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
@@ -96,5 +127,15 @@ std::vector<wcr::wid::WAssetId> wim::importer::WImporterObj::Import(
         static_mesh.SetMesh(std::move(meshes[i]), i);
     }
 
+    if (cache) {
+        try {
+            static_mesh.Serialize(WImportCache::File(cache->Begin(key), "mesh"));
+            cache->Commit(key);
+        }
+        catch (const std::exception & e) {
+            WFLOG_Warning("Can't cache {}: {}", file_path, e.what());
+        }
+    }
+
     return result;
 };
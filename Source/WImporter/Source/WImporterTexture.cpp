@@ -1,9 +1,15 @@
 #include "WImporter/WImporterTexture.hpp"
+#include "WImporter/WImportCache.hpp"
 #include "WCoreTypes/WTexture.hpp"
 #include "WAssets/Texture.hpp"
 #include "WObjectDb/WAssetDb.hpp"
 #include "WString/WString.hpp"
 #include "WLib_stbi.hpp"
+#include "WLog.hpp"
+
+#include <exception>
+#include <filesystem>
+#include <optional>
 
 // WImportTexture
 // --------------
@@ -15,36 +21,69 @@ std::vector<wcr::wid::WAssetId> wim::importer::WImportTexture::Import(
     std::string_view file_path,
     std::string_view asset_directory)
 {
-    auto stbi_image = wim::WLib_wtbi::LoadPath(file_path);
+    const std::shared_ptr<WImportCache> & cache = ImportCache();
+
+    std::uint64_t key{0};
+    std::optional<std::filesystem::path> cached{};
+
+    if (cache) {
+        std::uint64_t source = WImportCache::HashFile(std::string(file_path));
+        key = WImportCache::Key("WImportTexture", CACHE_VERSION, 0, {&source, 1});
+        cached = cache->Find(key);
+    }
+
+    was::Texture texture{};
+    bool decode = !cached;
+
+    if (cached) {
+        try {
+            texture.Deserialize(WImportCache::File(*cached, "texture"));
+        }
+        catch (const std::exception &) {
+            cache->Discard(key);
+            decode = true;
+        }
+    }
+
+    if (decode) {
+        auto stbi_image = wim::WLib_wtbi::LoadPath(file_path);
         
-    if (!stbi_image.pixels)
-    {
-        throw std::runtime_error("Failed to load texture image!");
+        if (!stbi_image.pixels)
+        {
+            throw std::runtime_error("Failed to load texture image!");
+        }
+
+        texture.SetTextureData(
+            stbi_image.pixels.get(),
+            stbi_image.width,
+            stbi_image.height,
+            stbi_image.format
+            );
+
+        if (wct::texture::NumOfChannels(texture.Get_format()) == 3)
+            texture.AddRGBAPadding();
+
+        if (cache) {
+            try {
+                texture.Serialize(WImportCache::File(cache->Begin(key), "texture"));
+                cache->Commit(key);
+            }
+            catch (const std::exception & e) {
+                WFLOG_Warning("Can't cache {}: {}", file_path, e.what());
+            }
+        }
     }
 
     auto valid_names = in_asset_manager
         .GenValidAssetName<was::Texture>(asset_directory, "texture", "texture");
 
-    wcr::wid::WAssetId id = in_asset_manager.Create<was::Texture>(
+    wcr::wid::WAssetId id = in_asset_manager.CreateFrom<was::Texture>(
         wstr::AssetPath(
             asset_directory,
             valid_names[0],
-            valid_names[1])
-        );
-
-    auto & asset = in_asset_manager.Get<was::Texture>(id);
-
-    asset.SetTextureData(
-        stbi_image.pixels.get(),
-        stbi_image.width,
-        stbi_image.height,
-        stbi_image.format
+            valid_names[1]),
+        std::move(texture)
         );
 
-    if (wct::texture::NumOfChannels(asset.Get_format()) == 3)
-        asset.AddRGBAPadding();
-
     return { id };
 }
-
-
@@ -0,0 +1,179 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include "WImporter/WImporterGltf.hpp"
+#include "WImporter/WImportCache.hpp"
+#include "WObjectDb/WAssetDb.hpp"
+#include "WAssets/Texture.hpp"
+#include "WAssets/StaticMesh.hpp"
+#include "WCore/WThreadLib.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // 2x2 RGBA png.
+    constexpr std::array<std::uint8_t, 75> PNG_BYTES{
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44,
+        0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x06, 0x00, 0x00, 0x00, 0x72,
+        0xb6, 0x0d, 0x24, 0x00, 0x00, 0x00, 0x12, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0xf8,
+        0xcf, 0xc0, 0xf0, 0x1f, 0x0c, 0x81, 0x34, 0x18, 0x00, 0x00, 0x49, 0xc8, 0x09, 0xf7, 0xf9,
+        0xab, 0xb6, 0x0d, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+    };
+
+    // One triangle and one texture, buffer: positions, indices and the png.
+    constexpr const char * GLTF_JSON = R"({
+    "asset": {"version": "2.0"},
+    "buffers": [{"uri": "WImporter_Cache_Test.bin", "byteLength": 123}],
+    "bufferViews": [
+        {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+        {"buffer": 0, "byteOffset": 36, "byteLength": 12},
+        {"buffer": 0, "byteOffset": 48, "byteLength": 75}
+    ],
+    "accessors": [
+        {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3",
+         "min": [0.0, 0.0, 0.0], "max": [1.0, 1.0, 0.0]},
+        {"bufferView": 1, "componentType": 5125, "count": 3, "type": "SCALAR"}
+    ],
+    "images": [{"bufferView": 2, "mimeType": "image/png", "name": "Texel"}],
+    "textures": [{"source": 0, "name": "Texel"}],
+    "meshes": [{"name": "Triangle", "primitives": [{"attributes": {"POSITION": 0}, "indices": 1}]}]
+})";
+
+    /**
+     * @brief Write the test gltf and its buffer in in_directory, returns the gltf path.
+     */
+    std::string WriteGltf(const std::filesystem::path & in_directory) {
+        std::filesystem::create_directories(in_directory);
+
+        const std::array<float, 9> positions{0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+        const std::array<std::uint32_t, 3> indices{0, 1, 2};
+
+        std::vector<char> buffer(123, 0);
+        std::memcpy(buffer.data(), positions.data(), sizeof(positions));
+        std::memcpy(buffer.data() + 36, indices.data(), sizeof(indices));
+        std::memcpy(buffer.data() + 48, PNG_BYTES.data(), PNG_BYTES.size());
+
+        std::ofstream(in_directory / "WImporter_Cache_Test.bin", std::ios::binary)
+            .write(buffer.data(), buffer.size());
+
+        std::filesystem::path gltf_path = in_directory / "WImporter_Cache_Test.gltf";
+        std::ofstream(gltf_path) << GLTF_JSON;
+
+        return gltf_path.string();
+    }
+
+    std::size_t CountEntries(const std::filesystem::path & in_directory) {
+        std::size_t result = 0;
+        for (const auto & entry : std::filesystem::directory_iterator(in_directory)) {
+            if (entry.is_directory()) result++;
+        }
+        return result;
+    }
+
+}
+
+bool WImportCache_Entry_Test() {
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "WImportCache_Entry_Test";
+    std::filesystem::remove_all(directory);
+
+    wim::importer::WImportCache cache(directory);
+
+    // Not visible until committed.
+    std::filesystem::path pending = cache.Begin(42);
+    std::ofstream(wim::importer::WImportCache::File(pending, "data")) << "cooked";
+
+    bool hidden = !cache.Find(42).has_value();
+
+    cache.Commit(42);
+
+    std::optional<std::filesystem::path> entry = cache.Find(42);
+
+    bool committed = entry.has_value() &&
+        std::filesystem::exists(wim::importer::WImportCache::File(*entry, "data")) &&
+        !std::filesystem::exists(pending);
+
+    // A discarded hit becomes a miss and the entry is removed.
+    cache.Discard(42);
+
+    wim::importer::WImportCache::Stats stats = cache.GetStats();
+
+    bool discarded = !std::filesystem::exists(*entry) &&
+        stats.hits == 0 &&
+        stats.misses == 2 &&
+        stats.bytes_saved == 0;
+
+    std::filesystem::remove_all(directory);
+
+    return hidden && committed && discarded;
+}
+
+bool WImporterGltf_Cache_Test() {
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "WImporterGltf_Cache_Test";
+    std::filesystem::remove_all(directory);
+
+    std::string gltf_path = WriteGltf(directory / "Source");
+
+    auto cache = std::make_shared<wim::importer::WImportCache>(directory / "Cache");
+
+    WThreadLib::WJobSystem job_system(2);
+
+    wim::importer::WImporterGltf importer({}, {}, {}, {}, {}, {});
+    importer.SetImportCache(cache);
+    importer.SetJobSystem(&job_system);
+
+    // Textures first and static meshes after them, no materials nor scenes.
+    WAssetDb imported_db;
+    std::vector<wcr::wid::WAssetId> imported =
+        importer.Import(imported_db, gltf_path, "/Content/Test");
+
+    wim::importer::WImportCache::Stats first = cache->GetStats();
+
+    WAssetDb cached_db;
+    std::vector<wcr::wid::WAssetId> cached =
+        importer.Import(cached_db, gltf_path, "/Content/Test");
+
+    wim::importer::WImportCache::Stats second = cache->GetStats();
+
+    if (imported.size() != 2 || cached.size() != 2) return false;
+
+    const was::Texture & imported_texture = imported_db.Get<was::Texture>(imported[0]);
+    const was::Texture & cached_texture = cached_db.Get<was::Texture>(cached[0]);
+    const was::StaticMesh & imported_mesh = imported_db.Get<was::StaticMesh>(imported[1]);
+    const was::StaticMesh & cached_mesh = cached_db.Get<was::StaticMesh>(cached[1]);
+
+    bool equal = imported_texture.Get_width() == 2 &&
+        cached_texture.Get_width() == imported_texture.Get_width() &&
+        cached_texture.Get_height() == imported_texture.Get_height() &&
+        cached_texture.Get_format() == imported_texture.Get_format() &&
+        cached_texture.Get_data_() == imported_texture.Get_data_() &&
+        cached_mesh.MeshCount() == imported_mesh.MeshCount() &&
+        cached_mesh.GetMesh(0).vertices == imported_mesh.GetMesh(0).vertices &&
+        cached_mesh.GetMesh(0).indices == imported_mesh.GetMesh(0).indices;
+
+    bool single_entry = CountEntries(directory / "Cache") == 1;
+
+    std::filesystem::remove_all(directory);
+
+    return first.hits == 0 && first.misses == 1 &&
+        second.hits == 1 && second.misses == 1 && second.bytes_saved > 0 &&
+        equal &&
+        single_entry;
+}
+
+TEST_CASE("WImporter") {
+    SECTION("WImportCache") {
+        CHECK(WImportCache_Entry_Test());
+        CHECK(WImporterGltf_Cache_Test());
+    }
+}
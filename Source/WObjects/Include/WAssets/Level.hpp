@@ -26,6 +26,18 @@ namespace was {
 
         void Close(WEngine * in_engine) ;
 
+        /**
+         * @brief Write the entities and components as a cooked asset file (see WCookedAsset.hpp),
+         * component columns are written with WPropertySerializer.
+         * Components keep asset ids, they are valid while the referenced assets keep their ids.
+         */
+        void Serialize(const std::string & in_path) override;
+
+        /**
+         * @brief Replace the entities and components with a cooked level file.
+         */
+        void Deserialize(const std::string & in_path) override;
+
         template<std::derived_from<WEntity> T>
             wcr::wid::WEntityId CreateEntity() {
             std::string actor_path = WEntityPath(T::StaticClass());
@@ -38,6 +50,14 @@ namespace was {
 
         WEntity * GetEntity(const wcr::wid::WEntityId & in_id) const ;
 
+        void RemoveEntity(const wcr::wid::WEntityId & in_id) {
+            entity_component_db.RemoveEntity(in_id);
+        }
+
+        WNODISCARD bool IsAlive(const wcr::wid::WEntityId & in_id) const {
+            return entity_component_db.IsAlive(in_id);
+        }
+
         /**
          * @brief Run in_predicate for each in_class actor (derived from in_class).
          */
@@ -100,6 +120,24 @@ namespace was {
             entity_component_db.ForEachComponent<T>(std::forward<TFn>(in_fn));
         }
 
+        /**
+         * @brief See WEntityComponentDb::ParallelForEachComponent.
+         */
+        template<std::derived_from<WComponent> T, CCallable<void, T*> TFn>
+        void ParallelForEachComponent(TFn && in_fn,
+                                      std::size_t in_grain=0,
+                                      WThreadLib::WJobSystem & in_job_system=WThreadLib::DefaultJobSystem()) const {
+            entity_component_db.ParallelForEachComponent<T>(std::forward<TFn>(in_fn), in_grain, in_job_system);
+        }
+
+        /**
+         * @brief View over entities with all the Ts components.
+         */
+        template<std::derived_from<WComponent> ... Ts>
+        WEntityComponentDb::QueryView<Ts...> Query() const {
+            return entity_component_db.Query<Ts...>();
+        }
+
         template<std::derived_from<WComponent> T>
         wcr::wid::WComponentTypeId GetComponentTypeId() const {
             return entity_component_db.GetComponentTypeId<T>();
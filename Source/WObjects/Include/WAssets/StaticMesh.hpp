@@ -33,6 +33,17 @@ namespace was {
         WPROPERTY(PipelineAssignments, pipeline_assignments,);
 
     public:
+
+        /**
+         * @brief Write the meshes as a cooked asset file, see WCookedAsset.hpp.
+         * Pipeline assignments hold runtime ids and are not written.
+         */
+        void Serialize(const std::string & in_path) override;
+
+        /**
+         * @brief Load the meshes from a cooked asset file, throws std::runtime_error if invalid.
+         */
+        void Deserialize(const std::string & in_path) override;
     
         constexpr void SetMesh(wct::geometry::WMesh const & in_mesh, wcr::wid::WSubIdxId const & in_id=0) {
             meshes[in_id.GetId()] = in_mesh;
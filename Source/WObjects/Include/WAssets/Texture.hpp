@@ -32,6 +32,16 @@ namespace was {
 
     public:
 
+        /**
+         * @brief Write the texels and texture info as a cooked asset file, see WCookedAsset.hpp.
+         */
+        void Serialize(const std::string & in_path) override;
+
+        /**
+         * @brief Load the texture from a cooked asset file, throws std::runtime_error if invalid.
+         */
+        void Deserialize(const std::string & in_path) override;
+
         void SetTextureData(
             std::uint8_t * in_ptr,
             std::uint32_t in_width,
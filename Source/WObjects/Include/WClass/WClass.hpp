@@ -5,16 +5,39 @@
 // #include "WObjects/TWRef.hpp"
 // #include "WCore/TWAllocator.hpp"
 #include "WObjectDb/WDbBuilder.hpp"
+#include "WClass/WProperty.hpp"
+#include "WCore/TArchetype.hpp"
 // #include "WLog.hpp"
 
 // #include <memory>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <type_traits>
+#include <vector>
 // #include <typeindex>
 #include <cassert>
 
+class WComponent;
+
+/**
+ * @brief Runtime class of a WObject type.
+ * Each WClass gets a dense type index and an ancestors bitset the first time
+ * TypeIndex or IsBaseOf is used (WClass instances are constant initialized,
+ * so this can't happen in the constructor).
+ */
 class WOBJECTS_API WClass
 {
+public:
+
+    static constexpr std::size_t NONE_TYPE_INDEX{ std::numeric_limits<std::size_t>::max() };
+
 public:
 
     constexpr WClass() noexcept = default;
@@ -59,11 +82,72 @@ public:
 
     virtual constexpr std::unordered_set<const WClass*> Bases() const =0;
 
+    /**
+     * @brief Properties declared by this class with WPROPERTY, in declaration order.
+     * Base class properties are not included, see ForEachProperty.
+     */
+    virtual std::span<const WProperty> Properties() const=0;
+
+    /**
+     * @brief Empty archetype column of this class, nullptr if it isn't a component class.
+     */
+    virtual std::unique_ptr<IArchetypeColumn<WComponent>> ComponentColumn() const=0;
+
+    /**
+     * @brief Run in_fn for each property of this class and its bases, base properties first.
+     */
+    template<CCallable<void, const WProperty &> TFn>
+    void ForEachProperty(TFn && in_fn) const {
+        const WClass * base = BaseClass();
+        if (base) {
+            base->ForEachProperty(in_fn);
+        }
+
+        for (const WProperty & property : Properties()) {
+            in_fn(property);
+        }
+    }
+
+    /**
+     * @brief Class registered with in_name, nullptr if there is none.
+     * Classes are registered by the generated code when their module is loaded.
+     */
+    static const WClass * FindClass(std::string_view in_name) {
+        auto it = Registry().find(in_name);
+        return it != Registry().end() ? it->second : nullptr;
+    }
+
+    static bool RegisterClass(const WClass * in_class) {
+        return Registry().insert({in_class->name_, in_class}).second;
+    }
+
     /**
      * Returns true if other is derived from this.
      */
-    constexpr bool IsBaseOf(WClass const * other) const {
-        return other->Bases().contains(this);
+    bool IsBaseOf(WClass const * other) const {
+        // Registering other registers its bases, an unregistered class is no base
+        // and its NONE_TYPE_INDEX is out of the ancestors range.
+        const std::vector<std::uint64_t> & ancestors = other->Ancestors();
+        const std::size_t index = type_index_.load(std::memory_order_acquire);
+
+        return (index >> 6) < ancestors.size() &&
+            (ancestors[index >> 6] >> (index & 63)) & 1;
+    }
+
+    /**
+     * @brief Dense index of this class, in [0, TypeCount()).
+     * Base classes always get a lower index than their derived classes.
+     */
+    std::size_t TypeIndex() const {
+        Register();
+        return type_index_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of type indexes assigned so far.
+     */
+    static std::size_t TypeCount() noexcept {
+        return TypeCounter().load(std::memory_order_acquire);
     }
 
     constexpr bool IsEqual(WClass const * other) const {
@@ -111,7 +195,52 @@ protected:
 
 private:
 
+    static std::atomic<std::size_t> & TypeCounter() noexcept {
+        static std::atomic<std::size_t> counter{0};
+        return counter;
+    }
+
+    // Written while modules are loaded, read only afterwards.
+    static std::unordered_map<std::string_view, const WClass *> & Registry() {
+        static std::unordered_map<std::string_view, const WClass *> registry{};
+        return registry;
+    }
+
+    /**
+     * @brief Bit i is set if the class with type index i is a base of this class.
+     */
+    const std::vector<std::uint64_t> & Ancestors() const {
+        Register();
+        return ancestors_;
+    }
+
+    void Register() const {
+        std::call_once(register_flag_, [this]() {
+            const WClass * base = BaseClass();
+
+            if (base) {
+                ancestors_ = base->Ancestors();
+
+                const std::size_t base_index = base->TypeIndex();
+                if ((base_index >> 6) >= ancestors_.size()) {
+                    ancestors_.resize((base_index >> 6) + 1, 0);
+                }
+                ancestors_[base_index >> 6] |= std::uint64_t{1} << (base_index & 63);
+            }
+
+            type_index_.store(TypeCounter().fetch_add(1, std::memory_order_acq_rel),
+                              std::memory_order_release);
+        });
+    }
+
     std::string_view name_;
+
+    mutable std::once_flag register_flag_{};
+
+    // Atomic so IsBaseOf can read it without the register flag.
+    mutable std::atomic<std::size_t> type_index_{NONE_TYPE_INDEX};
+
+    mutable std::vector<std::uint64_t> ancestors_{};
     
 };
 
@@ -3,9 +3,13 @@
 #include "WClass/WClass.hpp"
 // #include "WObjects/TWRef.hpp"
 // #include "WLog.hpp"
+#include <array>
 #include <concepts>
+#include <memory>
+#include <span>
 #include <type_traits>
 #include <string_view>
+#include <utility>
 
 class WObject;
 class WEntity;
@@ -58,6 +62,22 @@ public:
         return BasesConstexpr();
     }
 
+    std::span<const WProperty> Properties() const override {
+        static constexpr auto properties =
+            PropertiesOf(std::make_index_sequence<TPropertyCountOf<T>>{});
+
+        return properties;
+    }
+
+    std::unique_ptr<IArchetypeColumn<WComponent>> ComponentColumn() const override {
+        if constexpr (std::is_convertible_v<T*, WComponent*>) {
+            return std::make_unique<TArchetypeColumn<T, WComponent>>();
+        }
+        else {
+            return nullptr;
+        }
+    }
+
     constexpr std::unordered_set<const WClass*> BasesConstexpr() const {
         std::unordered_set<const WClass*> result;
         const WClass* b = BaseClassConstexpr();
@@ -73,4 +93,9 @@ protected:
 
 private:
 
+    template<std::size_t ... I>
+    static constexpr std::array<WProperty, sizeof...(I)> PropertiesOf(std::index_sequence<I...>) {
+        return { T::WPropertyAt(std::integral_constant<std::size_t, I>{})... };
+    }
+
 };
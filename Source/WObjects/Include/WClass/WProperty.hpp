@@ -0,0 +1,184 @@
+#pragma once
+
+#include "WCore/WBinaryStream.hpp"
+#include "WCoreTypes/WCoreTypes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+class WObject;
+
+/**
+ * @brief How a property is written by WPropertySerializer.
+ * Trivial properties are copied as raw bytes, a column of them in one block.
+ * String and Vector properties are length prefixed.
+ */
+enum class EPropertyKind : std::uint8_t {
+    Unsupported=0,
+    Trivial=1,
+    String=2,
+    Vector=3
+};
+
+/**
+ * @brief Binary encoding of a property type, specialize it for types
+ * that are not trivially copyable, strings or vectors.
+ * element_size is the size of the type (Trivial) or of its elements (String, Vector),
+ * it is stored to detect layout changes.
+ */
+template<typename T>
+struct TPropertyCodec {
+    static constexpr EPropertyKind kind{EPropertyKind::Unsupported};
+    static constexpr std::uint32_t element_size{0};
+};
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+struct TPropertyCodec<T> {
+    static constexpr EPropertyKind kind{EPropertyKind::Trivial};
+    static constexpr std::uint32_t element_size{sizeof(T)};
+
+    static void Write(const T & in_value, WBinaryWriter & in_writer) {
+        in_writer.Write(in_value);
+    }
+
+    static void Read(T & out_value, WBinaryReader & in_reader) {
+        in_reader.Read(&out_value, sizeof(T));
+    }
+};
+
+template<>
+struct TPropertyCodec<std::string> {
+    static constexpr EPropertyKind kind{EPropertyKind::String};
+    static constexpr std::uint32_t element_size{1};
+
+    static void Write(const std::string & in_value, WBinaryWriter & in_writer) {
+        in_writer.WriteString(in_value);
+    }
+
+    static void Read(std::string & out_value, WBinaryReader & in_reader) {
+        out_value = in_reader.ReadString();
+    }
+};
+
+template<std::uint32_t N>
+struct TPropertyCodec<TName<N>> {
+    static constexpr EPropertyKind kind{EPropertyKind::String};
+    static constexpr std::uint32_t element_size{1};
+
+    static void Write(const TName<N> & in_value, WBinaryWriter & in_writer) {
+        in_writer.WriteString(in_value.View());
+    }
+
+    static void Read(TName<N> & out_value, WBinaryReader & in_reader) {
+        std::string_view value = in_reader.ReadString();
+        out_value = TName<N>(value.substr(0, N));
+    }
+};
+
+/**
+ * @brief Vectors of trivially copyable values are copied in one block,
+ * other elements are written one by one with their codec.
+ */
+template<typename T, typename A>
+requires (TPropertyCodec<T>::kind != EPropertyKind::Unsupported && !std::is_same_v<T, bool>)
+struct TPropertyCodec<std::vector<T, A>> {
+    static constexpr EPropertyKind kind{EPropertyKind::Vector};
+    static constexpr std::uint32_t element_size{TPropertyCodec<T>::element_size};
+
+    static void Write(const std::vector<T, A> & in_value, WBinaryWriter & in_writer) {
+        if constexpr (TPropertyCodec<T>::kind == EPropertyKind::Trivial) {
+            in_writer.WriteSpan(std::span<const T>(in_value));
+        }
+        else {
+            in_writer.Write(static_cast<std::uint64_t>(in_value.size()));
+            for (const T & v : in_value) {
+                TPropertyCodec<T>::Write(v, in_writer);
+            }
+        }
+    }
+
+    static void Read(std::vector<T, A> & out_value, WBinaryReader & in_reader) {
+        if constexpr (TPropertyCodec<T>::kind == EPropertyKind::Trivial) {
+            std::size_t count = in_reader.ReadCount(sizeof(T));
+            out_value.resize(count);
+            in_reader.Read(out_value.data(), count * sizeof(T));
+        }
+        else {
+            // Every element takes at least a size.
+            std::size_t count = in_reader.ReadCount(sizeof(std::uint64_t));
+            out_value.resize(count);
+            for (T & v : out_value) {
+                TPropertyCodec<T>::Read(v, in_reader);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Metadata of a WPROPERTY, built by the WPROPERTY macro.
+ * address gives the property of an object of the declaring class (or derived),
+ * write and read encode a value, they are null for Unsupported properties.
+ */
+struct WProperty {
+
+    using AddressFn = void * (*)(WObject *);
+
+    using WriteFn = void (*)(const void *, WBinaryWriter &);
+
+    using ReadFn = void (*)(void *, WBinaryReader &);
+
+    std::string_view name{};
+    EPropertyKind kind{EPropertyKind::Unsupported};
+    std::uint32_t element_size{0};
+    AddressFn address{nullptr};
+    WriteFn write{nullptr};
+    ReadFn read{nullptr};
+
+    template<typename T>
+    static constexpr WProperty Make(std::string_view in_name, AddressFn in_address) noexcept {
+        using Codec = TPropertyCodec<T>;
+
+        WProperty result{in_name, Codec::kind, Codec::element_size, in_address};
+
+        if constexpr (Codec::kind != EPropertyKind::Unsupported) {
+            result.write = [](const void * _value, WBinaryWriter & _writer) {
+                Codec::Write(*static_cast<const T *>(_value), _writer);
+            };
+            result.read = [](void * _value, WBinaryReader & _reader) {
+                Codec::Read(*static_cast<T *>(_value), _reader);
+            };
+        }
+
+        return result;
+    }
+
+    WNODISCARD constexpr bool IsSerializable() const noexcept {
+        return kind != EPropertyKind::Unsupported;
+    }
+};
+
+/**
+ * @brief Compile time property counter of WOBJECT_BODY and WPROPERTY.
+ * Each WPROPERTY declares a WPropertyCount overload taking TPropertyCounter<index + 1>,
+ * overload resolution with TPropertyCounter<WPROPERTY_MAX_COUNT> picks the last declared one.
+ */
+template<std::size_t N>
+struct TPropertyCounter : TPropertyCounter<N - 1> {};
+
+template<>
+struct TPropertyCounter<0> {};
+
+inline constexpr std::size_t WPROPERTY_MAX_COUNT{64};
+
+/**
+ * @brief Number of properties declared by T itself (not by its bases).
+ */
+template<typename T>
+inline constexpr std::size_t TPropertyCountOf =
+    decltype(T::WPropertyCount(TPropertyCounter<WPROPERTY_MAX_COUNT>{}))::value;
@@ -21,6 +21,11 @@ namespace wcm {
         WPROPERTY(glm::vec3, scale, 1.0);
         WPROPERTY(ERotationOrder, rotation_order, ERotationOrder::zxy);
         WPROPERTY(glm::mat4, transform_matrix, 1.0);
+
+        // State at the start of the last simulation step.
+        WPROPERTY(glm::vec3, previous_position, 0.0);
+        WPROPERTY(glm::vec3, previous_rotation, 0.0);
+        WPROPERTY(glm::vec3, previous_scale, 1.0);
     
     public:
 
@@ -36,6 +41,45 @@ namespace wcm {
             Set_transform_matrix(std::move(in_transform_matrix));
         }
 
+        /**
+         * @brief Keep the current state as the previous simulation step state.
+         */
+        void StorePrevious() {
+            previous_position = position;
+            previous_rotation = rotation;
+            previous_scale = scale;
+        }
+
+        /**
+         * @brief Copy between the previous and the current state, in_alpha in [0, 1].
+         * Rotation is interpolated as quaternions, taking the shortest path.
+         */
+        Transform Interpolated(float in_alpha) const {
+            Transform result{*this};
+
+            glm::quat rotation_quat = glm::slerp(
+                WMath::ToQuat(previous_rotation, rotation_order),
+                WMath::ToQuat(rotation, rotation_order),
+                in_alpha
+                );
+
+            result.position = glm::mix(previous_position, position, in_alpha);
+            result.scale = glm::mix(previous_scale, scale, in_alpha);
+
+            result.transform_matrix = WMath::ToMat4(
+                result.position,
+                rotation_quat,
+                result.scale
+                );
+
+            result.rotation = WMath::ToEulerRotation(
+                glm::mat3_cast(rotation_quat),
+                rotation_order
+                );
+
+            return result;
+        }
+
     private:
   
     };
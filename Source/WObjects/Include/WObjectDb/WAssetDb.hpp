@@ -4,6 +4,7 @@
 #include "WCore/IdPool.hpp"
 #include "WCore/WId.hpp"
 #include "WCore/TPathTree.hpp"
+#include "WCore/TSparseIndex.hpp"
 #include "WString/WString.hpp"
 #include "WObjectDb/WObjectDb.hpp"
 #include "WObjects/WAsset.hpp"
@@ -11,6 +12,7 @@
 
 #include <concepts>
 #include <limits>
+#include <stdexcept>
 #include <unordered_map>
 #include <format>
 
@@ -42,6 +44,11 @@ using WAssetDbType = WObjectDb<WAsset, wcr::wid::WAssetId>;
 
     template<std::derived_from<WAsset> T>
     wcr::wid::WAssetId Create(std::string_view in_fullname) {
+        if (IsFrozen()) {
+            throw std::runtime_error(
+                std::format("Can't create {}, the asset db is frozen.", in_fullname));
+        }
+
         wcr::wid::WAssetId id = GetIdPool(T::StaticClass()).Generate();
 
         wclass_track_.RegAsset(id, T::StaticClass());
@@ -123,6 +130,23 @@ using WAssetDbType = WObjectDb<WAsset, wcr::wid::WAssetId>;
 
     WAsset * Get(std::string_view asset_path) const;
 
+    /**
+     * @brief Assets can't be created while frozen, so the storage doesn't move
+     * and other threads can read the assets. Each Freeze needs an Unfreeze.
+     */
+    void Freeze() noexcept {
+        frozen_++;
+    }
+
+    void Unfreeze() noexcept {
+        assert(frozen_ > 0);
+        frozen_--;
+    }
+
+    WNODISCARD bool IsFrozen() const noexcept {
+        return frozen_ > 0;
+    }
+
     wcr::wid::WAssetId GetId(std::string_view asset_path) const;
     
     bool ExistsAsset(std::string_view asset_path) const;
@@ -206,27 +230,37 @@ private:
         wcr::wid::WAssetTypeId::IdType id_counter{0};
 
         std::vector<WClass const *> class_list{};
-        std::unordered_map<WClass const *,std::uint32_t> wclass_id{};
-        std::unordered_map<wcr::wid::WAssetId, wcr::wid::WAssetTypeId::IdType> asset_typeid{};
+        // Asset type id by WClass::TypeIndex, not valid for unused classes
+        std::vector<wcr::wid::WAssetTypeId> wclass_id{};
+        // Asset type id by asset id
+        TSparsePagedIndex<> asset_typeid{};
 
         bool Contains(WClass const * in_class) const {
-            return wclass_id.contains(in_class);
+            const std::size_t index = in_class->TypeIndex();
+            return index < wclass_id.size() && wclass_id[index].IsValid();
         }
 
         void RegAsset(wcr::wid::WAssetId assetid, WClass const * in_class) {
-            if (!wclass_id.contains(in_class)) {
+            const std::size_t index = in_class->TypeIndex();
+
+            if (!Contains(in_class)) {
+                if (index >= wclass_id.size()) {
+                    wclass_id.resize(index + 1);
+                }
+
                 class_list.push_back(in_class);
-                wclass_id[in_class] = id_counter;
+                wclass_id[index] = id_counter;
                 
                 id_counter++;
             }
 
-            asset_typeid[assetid] = wclass_id[in_class];
+            asset_typeid.Set(assetid.GetId(), wclass_id[index].GetId());
             
         }
 
         wcr::wid::WAssetTypeId GetTypeId(WClass const * in_class) const {
-            return wclass_id.at(in_class);
+            assert(Contains(in_class));
+            return wclass_id[in_class->TypeIndex()];
         }
 
         WClass const * GetWClass(wcr::wid::WAssetTypeId in_id) const {
@@ -235,15 +269,17 @@ private:
 
         wcr::wid::WAssetTypeId GetAssetTypeId(wcr::wid::WAssetId in_id) const {
 
-#ifndef NDEBUG
-            auto idtype = asset_typeid.at(in_id);
-#endif
+            assert(asset_typeid.Contains(in_id.GetId()));
             
-            return asset_typeid.at(in_id);
+            return static_cast<wcr::wid::WAssetTypeId::IdType>(
+                asset_typeid.At(in_id.GetId())
+                );
         }
 
     } wclass_track_{};
 
     wcr::TPathTree<wcr::wid::WAssetId> path_tree_{};
 
+    std::uint32_t frozen_{0};
+
 };
@@ -3,16 +3,36 @@
 #include "WCore/WConcepts.hpp"
 #include "WCore/TObjectDataBase.hpp"
 #include "WCore/TFunction.hpp"
-#include "WObjects/TWRef.hpp"
 #include "WCore/TWAllocator.hpp"
 #include "WLog.hpp"
 
+#include <algorithm>
 #include <format>
 #include <memory>
 #include <typeinfo>
 #include <unordered_map>
 #include <typeindex>
 #include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Storage used by the object db of a class.
+ * Contiguous: single buffer, growth moves the objects and emits allocate events.
+ * Chunked: 16KiB chunks, objects don't move when the db grows and no allocate events are emitted.
+ */
+enum class EObjectStorage : std::uint8_t {
+    Contiguous,
+    Chunked
+};
+
+/**
+ * @brief Storage for class T, specialize it to change the storage of a class:
+ * template<> struct TObjectStorageFor<MyClass> { static constexpr EObjectStorage value=EObjectStorage::Chunked; };
+ */
+template<typename T>
+struct TObjectStorageFor {
+    static constexpr EObjectStorage value = EObjectStorage::Contiguous;
+};
 
 struct WDbBuilder {
     
@@ -22,52 +42,24 @@ private:
 
     using OnDeallocateEventFn = void(*)(void*, std::size_t);
 
-    static inline std::unordered_map<std::type_index,
-                                     std::unordered_set<OnAllocateEventFn>> on_allocate_events{};
+    // One event list per type, resolved at compile time.
+    template<typename T>
+    static inline std::vector<OnAllocateEventFn> on_allocate_events{};
 
-    static inline std::unordered_map<std::type_index,
-                                     std::unordered_set<OnDeallocateEventFn>> on_deallocate_events{};
+    template<typename T>
+    static inline std::vector<OnDeallocateEventFn> on_deallocate_events{};
 
     template<typename T>
     static inline void AllocateFn(T * prev_ptr, std::size_t prev_n, T * new_ptr, std::size_t new_n) {
-        if (prev_ptr) {
-            for(size_t i=0; i<prev_n; i++) {
-                if (!BWRef::IsInstanced(prev_ptr + i)) continue;
-                        
-                for (auto & ref : BWRef::Instances(prev_ptr + i)) {
-                    if (ref == nullptr) continue;
-                            
-                    ref->BSet(new_ptr + i);
-                }
-            }
+        for (auto * fn : on_allocate_events<T>) {
+            fn(prev_ptr, prev_n, new_ptr, new_n);
         }
-
-        if (on_allocate_events.contains(typeid(T))) {
-            for (auto * fn : on_allocate_events[typeid(T)]) {
-                fn(prev_ptr, prev_n, new_ptr, new_n);
-            }
-        }
-
     }
 
     template<typename T>
     static inline void DeallocateFn(T * ptr, std::size_t n) {
-        if (ptr) {
-            for(std::size_t i=0; i<n; i++) {
-                if (!BWRef::IsInstanced(ptr + i)) continue;
-
-                for (auto & ref : BWRef::Instances(ptr + i)) {
-                    if (ref == nullptr) continue;
-
-                    ref->BSet(ptr + i);
-                }
-            }
-        }
-
-        if (on_deallocate_events.contains(typeid(T))) {
-            for(auto * fn : on_deallocate_events[typeid(T)]) {
-                fn(ptr,n);
-            }
+        for(auto * fn : on_deallocate_events<T>) {
+            fn(ptr,n);
         }
     }
 
@@ -82,29 +74,38 @@ private:
     template<typename T>
     using TAllocatorBld = TWAllocator<T, decltype(&AllocateFn<T>), decltype(&DeallocateFn<T>)>;
 
-    template<typename T, CConvertibleTo<T> B, typename I>
+    template<typename T, EObjectStorage S>
+    using TStorageBld = std::conditional_t<
+        S == EObjectStorage::Chunked,
+        TChunkedSparseSet<T, 16384, TSparsePagedIndex<>>,
+        TSparseSet<T, TAllocatorBld<T>, std::allocator<std::size_t>, TSparsePagedIndex<>>
+        >;
+
+    template<typename T, CConvertibleTo<T> B, typename I, EObjectStorage S=TObjectStorageFor<T>::value>
     using TObjectDbBld = TObjDb<T,
                                 decltype(&CreateFn<T,I>),
                                 decltype(&DestroyFn<T>),
                                 B, I,
-                                TAllocatorBld<T>>;
+                                TAllocatorBld<T>,
+                                TSparsePagedIndex<>,
+                                TStorageBld<T, S>>;
 
 public:
 
     template<typename T>
     static inline void RegisterOnAllocateEvent(OnAllocateEventFn fn) {
-        if (!on_allocate_events.contains(typeid(T))) {
-            on_allocate_events[typeid(T)]={};
+        auto & events = on_allocate_events<T>;
+        if (std::find(events.begin(), events.end(), fn) == events.end()) {
+            events.push_back(fn);
         }
-        on_allocate_events[typeid(T)].insert(fn);
     }
 
     template<typename T>
     static inline void RegisterOnDeallocateEvent(OnDeallocateEventFn fn) {
-        if (!on_deallocate_events.contains(typeid(T))) {
-            on_deallocate_events[typeid(T)]={};
+        auto & events = on_deallocate_events<T>;
+        if (std::find(events.begin(), events.end(), fn) == events.end()) {
+            events.push_back(fn);
         }
-        on_deallocate_events[typeid(T)].insert(fn);
     }
 
 public:
@@ -155,13 +156,17 @@ public:
             );
     }
 
+    /**
+     * @brief Register the db creation for T objects accessed as B with I ids.
+     * The storage is selected by TObjectStorageFor<T>, DbCast relies on it.
+     */
     template<typename T, CConvertibleTo<T> B, typename I>
     void RegisterBuilder() {
         if (dbcreate_.contains(typeid(RegKey<B,I>))) {
             return;
         }
 
-        dbcreate_[typeid(RegKey<B,I>)] = &CreateObjectDb<T,B,I>;
+        dbcreate_[typeid(RegKey<B,I>)] = &CreateObjectDb<T,B,I,TObjectStorageFor<T>::value>;
     }
 
     template<typename T, CConvertibleTo<T> B, std::integral I>
@@ -171,16 +176,21 @@ public:
 
 private:
 
-    template<typename T, CConvertibleTo<T> B, typename I>
+    template<typename T, CConvertibleTo<T> B, typename I, EObjectStorage S>
     static inline VoidPtr CreateObjectDb() {
 
-        TAllocatorBld<T> a;
+        if constexpr (S == EObjectStorage::Chunked) {
+            return new TObjectDbBld<T,B,I,S>(&CreateFn, &DestroyFn);
+        }
+        else {
+            TAllocatorBld<T> a;
 
-        a.SetAllocateFn(&AllocateFn<T>);
+            a.SetAllocateFn(&AllocateFn<T>);
 
-        a.SetDeallocateFn(&DeallocateFn<T>);
+            a.SetDeallocateFn(&DeallocateFn<T>);
 
-        return new TObjectDbBld<T,B,I>(&CreateFn, &DestroyFn, a);
+            return new TObjectDbBld<T,B,I,S>(&CreateFn, &DestroyFn, a);
+        }
     }
 
     VoidPtr CreateDb(std::type_index typeindex) const {
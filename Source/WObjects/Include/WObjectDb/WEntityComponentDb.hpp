@@ -4,27 +4,194 @@
 
 #include "WObjectDb/WObjectDb.hpp"
 #include "WCore/IdPool.hpp"
+#include "WCore/TArchetype.hpp"
+#include "WCore/TSparseSet.hpp"
+#include "WCore/WBinaryStream.hpp"
+#include "WCore/WThreadLib.hpp"
 #include "WObjects/WEntity.hpp"
 #include "WObjects/WComponent.hpp"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
+#include <tuple>
+#include <utility>
 #include <concepts>
 
+/**
+ * @brief Entities and their components.
+ * Components are stored in archetypes, entities with the same set of component classes
+ * share an archetype and their components are packed in one column per class.
+ * Adding or removing a component moves the entity row to other archetype.
+ */
 class WOBJECTS_API WEntityComponentDb {
 public:
 
     using WEntityDbType = WObjectDb<WEntity, wcr::wid::WEntityId>;
 
-    using WComponentDbType = WObjectDb<WComponent, wcr::wid::WEntityId>;
+    using ArchetypeType = TArchetype<const WClass *, WComponent, wcr::wid::WEntityId::IdType>;
+
+    using ColumnType = ArchetypeType::ColumnType;
+
+    /**
+     * @brief Where the components of an entity are stored.
+     */
+    struct EntityRecord {
+        std::size_t archetype{0};
+        std::size_t row{0};
+    };
+
+    using EntityRecordDbType = TSparseSet<EntityRecord,
+                                          std::allocator<EntityRecord>,
+                                          std::allocator<std::size_t>,
+                                          TSparsePagedIndex<>>;
+
+    /**
+     * @brief Archetypes matched by a query.
+     * columns holds, for each matched archetype, the column of each queried class.
+     * Archetypes are never destroyed, so only archetypes created after
+     * archetypes_seen have to be tested to bring the cache up to date.
+     */
+    struct QueryCache {
+        std::vector<const WClass *> classes{};
+        std::vector<std::size_t> archetypes{};
+        std::vector<std::size_t> columns{};
+        std::size_t archetypes_seen{0};
+    };
+
+    /**
+     * @brief Guards the query caches, copies get their own mutex.
+     */
+    struct QueryMutex {
+        QueryMutex() noexcept = default;
+        QueryMutex(const QueryMutex &) noexcept {}
+        QueryMutex & operator=(const QueryMutex &) noexcept { return *this; }
+
+        std::mutex mutex{};
+    };
+
+    /**
+     * @brief View over the entities that have all Ts components (exact classes).
+     * Matched archetypes are walked linearly, no per entity lookups.
+     * The view stays valid while the db exists, new archetypes are picked up on iteration.
+     */
+    template<std::derived_from<WComponent> ... Ts>
+    class QueryView {
+    public:
+
+        QueryView(const WEntityComponentDb * in_db, QueryCache * in_cache) noexcept :
+            db_(in_db), cache_(in_cache) {}
+
+        template<CCallable<void, const wcr::wid::WEntityId &, Ts&...> TFn>
+        void ForEach(TFn && in_fn) const {
+            db_->UpdateQueryCache(*cache_);
+
+            for (std::size_t m=0; m < cache_->archetypes.size(); m++) {
+                const ArchetypeType & archetype = db_->archetypes_[cache_->archetypes[m]];
+
+                if (archetype.Count() == 0) continue;
+
+                ForEachRow(archetype,
+                           &cache_->columns[m * sizeof...(Ts)],
+                           0,
+                           archetype.Count(),
+                           in_fn,
+                           std::index_sequence_for<Ts...>{});
+            }
+        }
+
+        /**
+         * @brief ForEach with the rows split in ranges of in_grain rows (0 for the job system default)
+         * run in in_job_system. Same contract as WEntityComponentDb::ParallelForEachComponent.
+         */
+        template<CCallable<void, const wcr::wid::WEntityId &, Ts&...> TFn>
+        void ParallelForEach(TFn && in_fn,
+                             std::size_t in_grain=0,
+                             WThreadLib::WJobSystem & in_job_system=WThreadLib::DefaultJobSystem()) const {
+            db_->UpdateQueryCache(*cache_);
+
+            // First row of each matched archetype in the joined row range.
+            std::vector<std::size_t> firsts(cache_->archetypes.size());
+            std::size_t total = 0;
+            for (std::size_t m=0; m < cache_->archetypes.size(); m++) {
+                firsts[m] = total;
+                total += db_->archetypes_[cache_->archetypes[m]].Count();
+            }
+
+            if (total == 0) return;
+
+            if (in_grain == 0) {
+                in_grain = in_job_system.DefaultGrain(total);
+            }
+
+            in_job_system.ParallelForRange(
+                0, total, in_grain,
+                [this, &firsts, &in_fn](std::size_t _begin, std::size_t _end) {
+                    std::size_t m = std::upper_bound(firsts.begin(), firsts.end(), _begin) - firsts.begin() - 1;
+
+                    for (; _begin < _end; m++) {
+                        const ArchetypeType & archetype = db_->archetypes_[cache_->archetypes[m]];
+                        std::size_t row = _begin - firsts[m];
+                        std::size_t count = std::min(archetype.Count() - row, _end - _begin);
+
+                        if (count == 0) continue;
+
+                        ForEachRow(archetype,
+                                   &cache_->columns[m * sizeof...(Ts)],
+                                   row,
+                                   row + count,
+                                   in_fn,
+                                   std::index_sequence_for<Ts...>{});
+
+                        _begin += count;
+                    }
+                });
+        }
+
+        WNODISCARD std::size_t Count() const {
+            db_->UpdateQueryCache(*cache_);
+
+            std::size_t result = 0;
+            for (std::size_t a : cache_->archetypes) {
+                result += db_->archetypes_[a].Count();
+            }
+
+            return result;
+        }
+
+    private:
+
+        template<typename TFn, std::size_t ... I>
+        static void ForEachRow(const ArchetypeType & in_archetype,
+                               const std::size_t * in_columns,
+                               std::size_t in_begin,
+                               std::size_t in_end,
+                               TFn & in_fn,
+                               std::index_sequence<I...>) {
+            std::tuple<Ts*...> data{
+                in_archetype.Column<Ts>(in_columns[I]).Data()...
+            };
+
+            const auto & ids = in_archetype.Ids();
+
+            for (std::size_t row=in_begin; row < in_end; row++) {
+                in_fn(wcr::wid::WEntityId(ids[row]), std::get<I>(data)[row]...);
+            }
+        }
+
+        const WEntityComponentDb * db_;
+        QueryCache * cache_;
+    };
 
 public:
 
-    constexpr WEntityComponentDb() :
-    entity_db_(), component_db_(),
-    entity_id_pool_(), id_entityclass_(),
-    entity_components_(), componentclass_id_(),
-    id_componentclass_(), component_class_id_pool_() {
+    WEntityComponentDb() :
+    entity_db_(), generations_(), id_entityclass_(),
+    archetypes_(1), archetype_index_(), entity_records_(), query_cache_(),
+    componentclass_id_(), id_componentclass_(), component_class_id_pool_() {
+        archetype_index_[{}] = 0;
         InsertEntity<WEntity>(0, "GlobalEntity");
     }
 
@@ -45,7 +212,7 @@ public:
 
         auto id = CreateEntityId(T::StaticClass());
 
-        entity_db_.CreateAt<T>(id);
+        entity_db_.CreateAt<T>(EntityIndex(id));
 
         UpdateEntityData(T::StaticClass(), id, in_name);
 
@@ -55,26 +222,51 @@ public:
 
     template<std::derived_from<WEntity> T>
     void InsertEntity(const wcr::wid::WEntityId & in_id, const char * in_name) {
-        entity_db_.CreateAt<T>(in_id);
+        ReserveEntityId(T::StaticClass(), in_id);
+        entity_db_.CreateAt<T>(EntityIndex(in_id));
         UpdateEntityData(T::StaticClass(), in_id, in_name);
-        entity_id_pool_.ExtractFromPool(in_id.GetId());
+    }
+
+    /**
+     * @brief InsertEntity when the class is only known at runtime,
+     * the in_class storage must exist (an in_class entity was created before).
+     */
+    void InsertEntity(const WClass * in_class, const wcr::wid::WEntityId & in_id, const char * in_name);
+
+    /**
+     * @brief Remove the entity and all its components.
+     * The entity index is recycled with a new generation, in_id stops being alive.
+     */
+    void RemoveEntity(const wcr::wid::WEntityId & in_id);
+
+    /**
+     * @brief True if in_id is an existing entity, false if it was removed (or never created).
+     */
+    WNODISCARD bool IsAlive(const wcr::wid::WEntityId & in_id) const {
+        auto index = EntityIndex(in_id);
+
+        return index < generations_.size() &&
+            generations_[index] == wcr::wid::WEntityId_Meta::Generation(in_id) &&
+            entity_records_.Contains(index);
     }
 
     WEntity * GetEntity(const wcr::wid::WEntityId & in_id) const {
-        assert(id_entityclass_.contains(in_id));
+        assert(IsAlive(in_id));
 
-        return entity_db_.Get(id_entityclass_.at(in_id), in_id);
+        return entity_db_.Get(id_entityclass_.at(EntityIndex(in_id)), EntityIndex(in_id));
     }
 
     WEntity * GetFirstEntity(const WClass * in_class, wcr::wid::WEntityId & out_id) const {
         auto result =  entity_db_.GetFirst(in_class, out_id);
+        out_id = result->Get_entity_id();
 
         return result;
     }
 
     template<std::derived_from<WEntity> T>
     T * GetFirstEntity(wcr::wid::WEntityId & out_id) const {
-        auto result =  entity_db_.GetFirst<T>(out_id);
+        auto result = &entity_db_.GetFirst<T>(out_id);
+        out_id = result->Get_entity_id();
 
         return result;
     }
@@ -86,10 +278,8 @@ public:
     void ForEachEntity(const WClass * in_class, TFn && in_fn) const {
         assert(in_class == WEntity::StaticClass() || WEntity::StaticClass()->IsBaseOf(in_class));
     
-        for(const WClass * c : entity_db_.IterWClasses()) {
-            if(in_class == c || in_class->IsBaseOf(c)) {
-                entity_db_.ForEach(c, std::forward<TFn>(in_fn));
-            }
+        for(const WClass * c : entity_db_.DerivedClasses(in_class)) {
+            entity_db_.ForEach(c, in_fn);
         }
     }
 
@@ -97,39 +287,70 @@ public:
         return entity_db_.Count(in_class);
     }
 
+    /**
+     * @brief Create a T component for in_entity_id.
+     * The entity is moved to the archetype with T added to its signature,
+     * references to components of the moved rows are invalidated.
+     */
     template<std::derived_from<WComponent> T>
     void CreateComponent(const wcr::wid::WEntityId & in_entity_id) {
-        assert(entity_db_.Contains(id_entityclass_[in_entity_id], in_entity_id));
+        assert(IsAlive(in_entity_id));
+        assert(!ContainsComponent(T::StaticClass(), in_entity_id));
 
-        UpdateComponentMetadata(T::StaticClass(), in_entity_id);
+        UpdateComponentMetadata(T::StaticClass());
 
-        component_db_.CreateAt<T>(in_entity_id);
+        MoveEntity(
+            in_entity_id,
+            ArchetypeAdd(
+                entity_records_.Get(EntityIndex(in_entity_id)).archetype,
+                T::StaticClass()
+                )
+            );
 
-        component_db_
-            .Get<T>(in_entity_id)
-            .Set_entity_id(in_entity_id);
+        GetComponent<T>(in_entity_id).Set_entity_id(in_entity_id);
     }
 
-    // /**
-    //  * @brief Create component for entity id.
-    //  */
-    // void CreateComponent(const WClass * in_class,
-    //                      const wcr::wid::WEntityId & in_entity_id);
+    /**
+     * @brief Remove the in_class component from in_entity_id.
+     */
+    void RemoveComponent(const WClass * in_class, const wcr::wid::WEntityId & in_entity_id);
+
+    template<std::derived_from<WComponent> T>
+    void RemoveComponent(const wcr::wid::WEntityId & in_entity_id) {
+        RemoveComponent(T::StaticClass(), in_entity_id);
+    }
 
-    TWRef<WComponent> GetComponentRef(const WClass * in_class,
-                                      const wcr::wid::WEntityId & in_entity_id) const {
-        return GetComponent(in_class, in_entity_id);
+    bool ContainsComponent(const WClass * in_class, const wcr::wid::WEntityId & in_entity_id) const {
+        return IsAlive(in_entity_id) &&
+            archetypes_[entity_records_.Get(EntityIndex(in_entity_id)).archetype].Contains(in_class);
+    }
+
+    template<std::derived_from<WComponent> T>
+    bool ContainsComponent(const wcr::wid::WEntityId & in_entity_id) const {
+        return ContainsComponent(T::StaticClass(), in_entity_id);
     }
 
     template<std::derived_from<WComponent> T>
     T & GetComponent(const wcr::wid::WEntityId & in_entity_id) const {
-        return component_db_.Get<T>(in_entity_id);
+        assert(IsAlive(in_entity_id));
+
+        const EntityRecord & record = entity_records_.Get(EntityIndex(in_entity_id));
+        const ArchetypeType & archetype = archetypes_[record.archetype];
+
+        std::size_t column = archetype.ColumnIndex(T::StaticClass());
+        assert(column != ArchetypeType::NONE);
+
+        return archetype.Column<T>(column).Get(record.row);
     }
 
     WComponent * GetComponent(const WClass * in_class,
                               const wcr::wid::WEntityId & in_entity_id) const {
-        assert(component_db_.Contains(in_class, in_entity_id));
-        return component_db_.Get(in_class, in_entity_id);
+        assert(ContainsComponent(in_class, in_entity_id));
+
+        const EntityRecord & record = entity_records_.Get(EntityIndex(in_entity_id));
+        const ArchetypeType & archetype = archetypes_[record.archetype];
+
+        return archetype.Column(archetype.ColumnIndex(in_class)).BGet(record.row);
     }
 
     WComponent * GetComponent(const wcr::wid::WEntityComponentId & in_entity_component_id) const {
@@ -140,33 +361,169 @@ public:
 
         in_entity_component_id.ExtractWIds(lid, eid, cid, idxid);
 
-        return GetComponent(id_componentclass_.at(cid), eid);
+        return GetComponent(id_componentclass_[cid.GetId()], eid);
     }
 
+    /**
+     * @brief First in_class component (exact class), nullptr if there is none.
+     */
     WComponent * GetFirstComponent(const WClass * in_class, wcr::wid::WEntityId & out_id) const {
-        return component_db_.GetFirst(in_class, out_id);
+        for (const ArchetypeType & archetype : archetypes_) {
+            std::size_t column = archetype.ColumnIndex(in_class);
+            if (column != ArchetypeType::NONE && archetype.Count() > 0) {
+                out_id = archetype.IdAt(0);
+                return archetype.Column(column).BGet(0);
+            }
+        }
+
+        return nullptr;
     }
 
     template<std::derived_from<WComponent> T>
     T & GetFirstComponent(wcr::wid::WEntityId & out_id) const {
-        return component_db_.GetFirst<T>(out_id);
+        WComponent * result = GetFirstComponent(T::StaticClass(), out_id);
+        assert(result);
+
+        return *static_cast<T*>(result);
     }
 
+    /**
+     * @brief Run in_fn for each in_class component (and derived from in_class).
+     */
     template<CCallable<void, WComponent*> TFn>
     void ForEachComponent(const WClass * in_class, TFn && in_fn) const {
-        for(const WClass * c : component_db_.IterWClasses()) {
-            if (c == in_class || in_class->IsBaseOf(c)) {
-                component_db_.ForEach(c, std::forward<TFn>(in_fn));
+        for (const ArchetypeType & archetype : archetypes_) {
+            if (archetype.Count() == 0) continue;
+
+            for (std::size_t i=0; i < archetype.ColumnCount(); i++) {
+                const WClass * c = archetype.Signature()[i];
+                if (c != in_class && !in_class->IsBaseOf(c)) continue;
+
+                archetype.Column(i).BView().ForEach(in_fn);
             }
         }
     }
 
+    /**
+     * @brief Run in_fn for each T component (and derived from T).
+     * Exact T columns are walked without virtual calls.
+     */
     template<std::derived_from<WComponent> T, CCallable<void, T*> TFn>
     void ForEachComponent(TFn && in_fn) const {
-        ForEachComponent(T::StaticClass(),
-                         [&in_fn](WComponent* in_component) {
-                             in_fn(static_cast<T*>(in_component));
-                         });
+        for (const ArchetypeType & archetype : archetypes_) {
+            if (archetype.Count() == 0) continue;
+
+            for (std::size_t i=0; i < archetype.ColumnCount(); i++) {
+                const WClass * c = archetype.Signature()[i];
+
+                if (c == T::StaticClass()) {
+                    for (T & v : archetype.Column<T>(i)) {
+                        in_fn(&v);
+                    }
+                }
+                else if (T::StaticClass()->IsBaseOf(c)) {
+                    archetype.Column(i).BView().ForEach([&in_fn](WComponent * _component) {
+                        in_fn(static_cast<T*>(_component));
+                    });
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Run in_fn for each T component (and derived from T) in in_job_system.
+     * The components are split in ranges of in_grain components (0 for the job system default),
+     * ranges run at the same time in any order.
+     * in_fn can read and write the component it receives, and read any data no other call writes.
+     * It must not write other components (two calls could write the same one),
+     * nor create or remove entities and components.
+     */
+    template<std::derived_from<WComponent> T, CCallable<void, T*> TFn>
+    void ParallelForEachComponent(TFn && in_fn,
+                                  std::size_t in_grain=0,
+                                  WThreadLib::WJobSystem & in_job_system=WThreadLib::DefaultJobSystem()) const {
+        // Matching columns joined in one range, first is the position of the column first component.
+        struct ColumnRange {
+            T * data;
+            TStridedView<WComponent> view;
+            std::size_t first;
+            std::size_t count;
+        };
+
+        std::vector<ColumnRange> ranges;
+        std::size_t total = 0;
+
+        for (const ArchetypeType & archetype : archetypes_) {
+            if (archetype.Count() == 0) continue;
+
+            for (std::size_t i=0; i < archetype.ColumnCount(); i++) {
+                const WClass * c = archetype.Signature()[i];
+
+                if (c == T::StaticClass()) {
+                    ranges.push_back({archetype.Column<T>(i).Data(), {}, total, archetype.Count()});
+                }
+                else if (T::StaticClass()->IsBaseOf(c)) {
+                    ranges.push_back({nullptr, archetype.Column(i).BView(), total, archetype.Count()});
+                }
+                else {
+                    continue;
+                }
+
+                total += archetype.Count();
+            }
+        }
+
+        if (total == 0) return;
+
+        if (in_grain == 0) {
+            in_grain = in_job_system.DefaultGrain(total);
+        }
+
+        in_job_system.ParallelForRange(
+            0, total, in_grain,
+            [&ranges, &in_fn](std::size_t _begin, std::size_t _end) {
+                auto it = std::upper_bound(ranges.begin(), ranges.end(), _begin,
+                                           [](std::size_t _pos, const ColumnRange & _range) {
+                                               return _pos < _range.first;
+                                           }) - 1;
+
+                for (; _begin < _end; it++) {
+                    std::size_t pos = _begin - it->first;
+                    std::size_t count = std::min(it->count - pos, _end - _begin);
+
+                    if (it->data) {
+                        for (std::size_t i=pos; i < pos + count; i++) {
+                            in_fn(it->data + i);
+                        }
+                    }
+                    else {
+                        for (std::size_t i=pos; i < pos + count; i++) {
+                            in_fn(static_cast<T*>(it->view[i]));
+                        }
+                    }
+
+                    _begin += count;
+                }
+            });
+    }
+
+    /**
+     * @brief View over entities with all the Ts components.
+     * Matching archetypes are cached per Ts list and updated incrementally.
+     * Queries can run from several threads while there are no structural changes.
+     */
+    template<std::derived_from<WComponent> ... Ts>
+    QueryView<Ts...> Query() const {
+        std::vector<const WClass *> classes{ Ts::StaticClass()... };
+
+        std::lock_guard lock(query_mutex_.mutex);
+
+        auto it = query_cache_.find(classes);
+        if (it == query_cache_.end()) {
+            it = query_cache_.insert({classes, QueryCache{classes}}).first;
+        }
+
+        return QueryView<Ts...>(this, &it->second);
     }
 
     template<std::derived_from<WComponent> T>
@@ -174,34 +531,93 @@ public:
         return GetComponentTypeId(T::StaticClass());
     }
 
+    /**
+     * @brief Write the entities and components.
+     * Components are written by archetype, each column as a block of property values
+     * (see WPropertySerializer), the cost is linear in the written bytes.
+     */
+    void Serialize(WBinaryWriter & in_writer) const;
+
+    /**
+     * @brief Replace the entities and components with the ones written by Serialize.
+     * Classes are found by name with WClass::FindClass, entity ids are kept.
+     * Throws std::runtime_error for unknown classes or invalid data.
+     */
+    void Deserialize(WBinaryReader & in_reader);
+
     wcr::wid::WComponentTypeId GetComponentTypeId(const WClass * in_class) const {
         assert(WComponent::StaticClass()->IsBaseOf(in_class));
-        return componentclass_id_.at(in_class);
+        assert(in_class->TypeIndex() < componentclass_id_.size());
+        return componentclass_id_[in_class->TypeIndex()];
     }
 
 private:
 
+    static constexpr wcr::wid::WEntityId::IdType EntityIndex(const wcr::wid::WEntityId & in_id) noexcept {
+        return wcr::wid::WEntityId_Meta::Index(in_id);
+    }
+
     wcr::wid::WEntityId CreateEntityId(const WClass * in_class);
 
-    void UpdateComponentMetadata(const WClass * in_component_class, const wcr::wid::WEntityId & in_Id);
+    /**
+     * @brief Take in_id index from the pool and set its generation.
+     */
+    void ReserveEntityId(const WClass * in_class, const wcr::wid::WEntityId & in_id);
+
+    void UpdateComponentMetadata(const WClass * in_component_class);
 
     void UpdateEntityData(const WClass * in_entity_class, const wcr::wid::WEntityId & in_id, const char * in_name);
 
+    /**
+     * @brief Archetype reached adding in_class to in_archetype, created if needed.
+     * New columns are created with WClass::ComponentColumn.
+     */
+    std::size_t ArchetypeAdd(std::size_t in_archetype, const WClass * in_class);
+
+    /**
+     * @brief Archetype reached removing in_class from in_archetype, created if needed.
+     */
+    std::size_t ArchetypeRemove(std::size_t in_archetype, const WClass * in_class);
+
+    std::size_t RegisterArchetype(ArchetypeType && in_archetype);
+
+    void MoveEntity(const wcr::wid::WEntityId & in_entity_id, std::size_t in_archetype);
+
+    /**
+     * @brief Test archetypes created since the last update against in_cache classes.
+     */
+    void UpdateQueryCache(QueryCache & in_cache) const;
+
     WEntityDbType entity_db_{};
 
-    WComponentDbType component_db_{};
+    // Entity indexes, generations are tracked in generations_
+    wcr::IdPool<wcr::wid::WEntityId::IdType> entity_id_pool_{
+        {{.first=1, .last=wcr::wid::WEntityId_Meta::MAX_INDEX}}
+    };
+
+    // Current generation of each entity index
+    std::vector<wcr::wid::WEntityId::IdType> generations_{};
+
+    // Track where the Entity is stored, by entity index
+    std::unordered_map<wcr::wid::WEntityId::IdType, const WClass *> id_entityclass_{};
+
+    // archetypes_[0] is the empty signature archetype, entities without components live there.
+    std::vector<ArchetypeType> archetypes_;
+
+    std::map<std::vector<const WClass *>, std::size_t> archetype_index_;
 
-    wcr::IdPool<wcr::wid::WEntityId::IdType> entity_id_pool_{};
+    // Archetype and row of each entity
+    EntityRecordDbType entity_records_{};
 
-    // Track where the Entity is stored
-    std::unordered_map<wcr::wid::WEntityId, const WClass *> id_entityclass_{};
+    mutable std::map<std::vector<const WClass *>, QueryCache> query_cache_{};
 
-    // Track which components has each entity
-    std::unordered_map<wcr::wid::WEntityId, std::unordered_set<const WClass *>> entity_components_{};
+    mutable QueryMutex query_mutex_{};
 
     // Each component class has a unique 8 bit id
-    std::unordered_map<const WClass *, wcr::wid::WComponentTypeId> componentclass_id_{};
-    std::unordered_map<wcr::wid::WComponentTypeId, const WClass*> id_componentclass_{};  // <- TODO use an array
+    // Component type id by WClass::TypeIndex, not valid for unused classes
+    std::vector<wcr::wid::WComponentTypeId> componentclass_id_{};
+    // Component class by component type id
+    std::vector<const WClass*> id_componentclass_{};
     wcr::IdPool<wcr::wid::WComponentTypeId::IdType> component_class_id_pool_{};
 
 };
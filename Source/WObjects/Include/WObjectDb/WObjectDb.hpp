@@ -27,12 +27,17 @@ public:
 
     using ObjectDbType = IObjectDataBase<WObjClass, typename WIdType::IdType>;
 
-    using DbType =
-        std::unordered_map<WClass const *, std::unique_ptr<ObjectDbType>>;
+    template<std::derived_from<WObjClass> T>
+    using TRefType = TWRef<T, WObjClass, typename WIdType::IdType>;
+
+    // Object dbs by WClass::TypeIndex, nullptr for not stored classes.
+    using DbType = std::vector<std::unique_ptr<ObjectDbType>>;
+
+    using ClassListType = std::vector<const WClass *>;
 
     template<typename ValueFn, typename IncrFn>
     using ClassIterator = TIterator<const WClass *,
-                                    typename DbType::const_iterator,
+                                    typename ClassListType::const_iterator,
                                     WClass const *,
                                     ValueFn,
                                     IncrFn>;
@@ -44,6 +49,7 @@ public:
 
     WObjectDb(WObjectDb const & other) :
     db_(),
+    classes_(),
     initial_memory_size_(other.initial_memory_size_),
     storage_events_(this),
     events_(other.events_)
@@ -75,14 +81,60 @@ public:
     void CreateAt(const WIdType & in_id) {
         EnsureClassStorage<T>();
         
-        assert(!db_[T::StaticClass()]->Contains(in_id));
+        assert(!Db(T::StaticClass())->Contains(in_id));
+
+        Db(T::StaticClass())->CreateAt(in_id);
+    }
+
+    /**
+     * @brief Create a new in_class object at in_id when the class type is only known at runtime.
+     * The in_class storage must exist, see CreateAt<T> and EnsureClassStorage.
+     */
+    void CreateAt(const WClass * in_class, const WIdType & in_id) {
+        assert(!Db(in_class)->Contains(in_id));
+
+        Db(in_class)->CreateAt(in_id);
+    }
+
+    /**
+     * @brief Create the in_class storage when the class type is only known at runtime.
+     * Allocation events are registered by the typed CreateAt<T>.
+     */
+    void EnsureClassStorage(const WClass * in_class) {
+        if (FindDb(in_class)) return;
+
+        const std::size_t index = in_class->TypeIndex();
+
+        if (index >= db_.size()) {
+            db_.resize(index + 1);
+        }
 
-        db_[T::StaticClass()]->CreateAt(in_id);
+        db_[index] =
+            in_class->DbBuilder()
+            . template Create <WObjClass, typename WIdType::IdType>();
+
+        classes_.push_back(in_class);
+
+        for (const WClass * c = in_class; c; c = c->BaseClass()) {
+            const std::size_t c_index = c->TypeIndex();
+
+            if (c_index >= derived_.size()) {
+                derived_.resize(c_index + 1);
+            }
+
+            derived_[c_index].push_back(in_class);
+        }
+    }
+
+    void Remove(const WClass * in_class, const WIdType & in_id) {
+        assert(FindDb(in_class));
+
+        Db(in_class)->Remove(in_id.GetId());
     }
 
     WObjClass * Get(const WClass * in_class, const WIdType & in_id) const {
         WObjClass * result;
-        db_.at(in_class)->Get(in_id, result);
+        Db(in_class)->Get(in_id, result);
 
         return result;
     }
@@ -94,17 +146,33 @@ public:
     T & Get(WIdType in_id) const {
         return T::StaticClass()->DbBuilder()
             .template DbCast<T,WObjClass, typename WIdType::IdType>(
-                db_.at(T::StaticClass()).get()
+                Db(T::StaticClass())
                 )->Get(in_id);
     }
 
+    /**
+     * @brief Stable reference to the object at in_id, valid until the object is removed.
+     */
+    template<std::derived_from<WObjClass> T>
+    TRefType<T> Ref(const WIdType & in_id) const {
+        assert(FindDb(T::StaticClass()));
+
+        return TRefType<T>(Db(T::StaticClass()), in_id.GetId());
+    }
+
+    TRefType<WObjClass> Ref(const WClass * in_class, const WIdType & in_id) const {
+        assert(FindDb(in_class));
+
+        return TRefType<WObjClass>(Db(in_class), in_id.GetId());
+    }
+
     WObjClass * GetFirst(const WClass * in_class, WIdType & out_id) const {
-        assert(db_.contains(in_class));
+        assert(FindDb(in_class));
 
         auto id_value = out_id.GetId();
 
         WObjClass * result;
-        db_.at(in_class)->BGetFirst(result, id_value);
+        Db(in_class)->BGetFirst(result, id_value);
 
         out_id = id_value;
         
@@ -117,7 +185,7 @@ public:
 
         auto & result = T::StaticClass()->DbBuilder()
             .template DbCast<T, WObjClass, typename WIdType::IdType>(
-                db_.at(T::StaticClass()).get()
+                Db(T::StaticClass())
                 )->GetFirst(idval);
 
         out_id = idval;
@@ -126,10 +194,20 @@ public:
 
     /**
      * @brief More flexible but less performant.
+     * Walks the dense chunks of in_class, no virtual call per object.
      */
     template<CCallable<void, const WIdType &, WObjClass *> TFn>
     void ForEachIdValue(const WClass * in_class, TFn && in_fn) const {
-        db_.at(in_class)->BForEachIdValue(std::forward<TFn>(in_fn));
+        ObjectDbType * db = Db(in_class);
+
+        for (std::size_t c=0; c < db->BChunkCount(); c++) {
+            TStridedView<WObjClass> view = db->BChunk(c);
+            const std::size_t * ids = db->BChunkIds(c);
+
+            for (std::size_t i=0; i < view.Count(); i++) {
+                in_fn(WIdType(static_cast<typename WIdType::IdType>(ids[i])), view[i]);
+            }
+        }
     }
 
     /**
@@ -139,7 +217,7 @@ public:
     void ForEachIdValue(TFn && in_fn) const {
         T::StaticClass()->DbBuilder()
             .template DbCast<T,WObjClass,WIdType>(
-                db_.at(T::StaticClass()).get()
+                Db(T::StaticClass())
                 )->ForEachIdValue(std::forward<TFn>(in_fn));
     }
 
@@ -148,8 +226,13 @@ public:
      */
     template<CCallable<void, WObjClass*> TFn>
     void ForEach(const WClass * in_class, TFn && in_fn) const {
-        assert(db_.contains(in_class));
-        db_.at(in_class)->BForEach(std::forward<TFn>(in_fn));
+        assert(FindDb(in_class));
+
+        ObjectDbType * db = Db(in_class);
+
+        for (std::size_t c=0; c < db->BChunkCount(); c++) {
+            db->BChunk(c).ForEach(in_fn);
+        }
     }
 
     /**
@@ -157,26 +240,38 @@ public:
      */
     template<std::derived_from<WObjClass> T, CCallable<void, T&> TFn>
     void ForEach(TFn && in_fn) const {
-        assert(db_.contains(T::StaticClass()));
+        assert(FindDb(T::StaticClass()));
 
         T::StaticClass()->DbBuilder()
             .template DbCast<T,WObjClass, typename WIdType::IdType>(
-                db_.at(T::StaticClass()).get()
+                Db(T::StaticClass())
                 )->ForEach(std::forward<TFn>(in_fn));
     }
 
     template<typename T>
     bool Contains(const WIdType & in_id) const {
-        return db_.contains(T::StaticClass()) &&
-            db_.at(T::StaticClass())->Contains(in_id.GetId());
+        ObjectDbType * db = FindDb(T::StaticClass());
+        return db && db->Contains(in_id.GetId());
     }
 
     bool Contains(const WClass * in_class, const WIdType & in_id) const {
-        return db_.contains(in_class) && db_.at(in_class)->Contains(in_id.GetId());
+        ObjectDbType * db = FindDb(in_class);
+        return db && db->Contains(in_id.GetId());
     }
 
     bool ContainsClass(const WClass * in_class) const {
-        return db_.contains(in_class);
+        return FindDb(in_class) != nullptr;
+    }
+
+    /**
+     * @brief Stored classes that are in_class or derived from in_class, in storage creation order.
+     * The lists are filled when a class storage is created, a copy is returned
+     * so callbacks can store new classes while iterating it.
+     */
+    std::vector<const WClass *> DerivedClasses(const WClass * in_class) const {
+        const std::size_t index = in_class->TypeIndex();
+
+        return index < derived_.size() ? derived_[index] : std::vector<const WClass *>{};
     }
 
     /**
@@ -184,10 +279,10 @@ public:
      */
     auto IterWClasses() const {
         return ClassIterator(
-            db_.cbegin(),
-            db_.cend(),
+            classes_.cbegin(),
+            classes_.cend(),
             []( auto & _it, const std::int32_t & _i) -> const WClass * {
-                return (*_it).first;
+                return *_it;
             },
             [](auto & _it, const std::int32_t & _i) {
                 _it++;
@@ -204,8 +299,13 @@ public:
     }
 
     std::vector<typename WIdType::IdType> Indexes(const WClass * in_class) const {
-        assert(db_.contains(in_class));
-        return db_.at(in_class)->Indexes();
+        assert(FindDb(in_class));
+        return Db(in_class)->Indexes();
+    }
+
+    TGenerator<typename WIdType::IdType> GenerateIndexes(const WClass * in_class) const {
+        assert(FindDb(in_class));
+        return Db(in_class)->GenerateIndexes();
     }
 
     WNODISCARD std::size_t InitialMemorySize() const {
@@ -213,9 +313,9 @@ public:
     }
 
     WNODISCARD std::size_t Count(const WClass * in_class) const {
-        if (!db_.contains(in_class)) return 0;
-        
-        return db_.at(in_class)->Count();
+        ObjectDbType * db = FindDb(in_class);
+
+        return db ? db->Count() : 0;
     }
 
     WNODISCARD auto & OnAllocateEvent() {
@@ -230,15 +330,32 @@ private:
 
     void CopyContainersFrom(WObjectDb const & other) {
         db_.clear();
-        for (auto & p : other.db_) {
-            db_.insert(
-                { p.first, p.second->Clone() }
-                );
+        db_.resize(other.db_.size());
+        for (const WClass * c : other.classes_) {
+            db_[c->TypeIndex()] = other.db_[c->TypeIndex()]->Clone();
         }
+        classes_ = other.classes_;
+        derived_ = other.derived_;
+    }
+
+    ObjectDbType * FindDb(const WClass * in_class) const {
+        const std::size_t index = in_class->TypeIndex();
+        return index < db_.size() ? db_[index].get() : nullptr;
+    }
+
+    ObjectDbType * Db(const WClass * in_class) const {
+        assert(FindDb(in_class));
+        return db_[in_class->TypeIndex()].get();
     }
 
     DbType db_{};
 
+    // Stored classes, in storage creation order
+    ClassListType classes_{};
+
+    // Stored classes derived from each class (and the class itself), by WClass::TypeIndex
+    std::vector<ClassListType> derived_{};
+
     std::size_t initial_memory_size_{1024};
 
     struct {
@@ -322,6 +439,8 @@ private:
         }
 
         void RegPtrReference(void const * ptrref) {
+            if (!ptrref) return;
+
             ptr_container[ptrref]= db_ref_;
             container_ptrs[db_ref_].insert(ptrref);
         }
@@ -343,7 +462,7 @@ private:
             }
             
             for(auto it : db_ref_->IterWClasses()) {
-                RegPtrReference(db_ref_->db_[it]->BData());
+                RegPtrReference(db_ref_->Db(it)->BData());
             }
         }
 
@@ -371,25 +490,28 @@ private:
 
     template<std::derived_from<WObjClass> T>
     void EnsureClassStorage() {
-        if (!db_.contains(T::StaticClass())) {
-            db_[T::StaticClass()] =
-                T::StaticClass()->DbBuilder()
-                . template Create <WObjClass, typename WIdType::IdType>();
+        const std::size_t index = T::StaticClass()->TypeIndex();
 
-            db_[T::StaticClass()]->Reserve(
-                initial_memory_size_
-                );
+        if (!FindDb(T::StaticClass())) {
+            EnsureClassStorage(T::StaticClass());
 
-            storage_events_.RegPtrReference(
-                db_[T::StaticClass()]->BData() 
-                );
+            // Chunked storage doesn't move objects, no reserve or allocation tracking needed.
+            if constexpr (TObjectStorageFor<T>::value == EObjectStorage::Contiguous) {
+                db_[index]->Reserve(
+                    initial_memory_size_
+                    );
 
-            WDbBuilder::RegisterOnAllocateEvent<T>(
-                &StorageEvents:: template OnAllocateEventManager<T>
-                );
+                storage_events_.RegPtrReference(
+                    db_[index]->BData() 
+                    );
+
+                WDbBuilder::RegisterOnAllocateEvent<T>(
+                    &StorageEvents:: template OnAllocateEventManager<T>
+                    );
             
-            WDbBuilder::RegisterOnDeallocateEvent<T>(
-                &StorageEvents:: template OnDeallocateEventManager<T>);
+                WDbBuilder::RegisterOnDeallocateEvent<T>(
+                    &StorageEvents:: template OnDeallocateEventManager<T>);
+            }
         }
     }
 };
@@ -1,246 +1,127 @@
 #pragma once
 
-#include <unordered_map>
-#include <vector>
-#include <cassert>
-
-template<typename T>
-struct TWRefTrack_ {
-
-    static void UnregInstance(void * in_address, T * in_obj) {
-        if (!in_obj) return;
-
-        assert(Track().contains(in_address));
-
-        std::vector<T*> v;
-        v.reserve(Track()[in_address].size());
-        
-        for (T* p : Track()[in_address]) {
-            if (p != in_obj) {
-                v.push_back(p);
-            }
-        }
+#include "WCore/WCore.hpp"
+#include "WCore/TObjectDataBase.hpp"
 
-        Track()[in_address] = std::move(v);
-    }
-
-    static void RegInstance(void * in_address, T * in_obj) {
-        if (!in_obj) return;
-        
-        if (!Track().contains(in_address)) {
-            Track()[in_address] = {};
-            Track()[in_address].reserve(64);
-        }
-
-        Track()[in_address].push_back(in_obj);
-    }
-
-    static bool Contains(void * in_address) {
-        return Track().contains(in_address);
-    }
-
-    static const std::vector<T*> & Instances(void * in_address) {
-        assert(Track().contains(in_address));
-
-        return Track()[in_address];
-    }
-
-private:    
-
-    static std::unordered_map<void*, std::vector<T*>> & Track() noexcept {
-        // TODO: Is there a better data structure?
-        static std::unordered_map<void*, std::vector<T*>> track_{};
-        return track_;
-    }
-};
+#include <concepts>
+#include <cassert>
 
+/**
+ * @brief Stable reference to an object stored in an IObjectDataBase.
+ * Holds the owning db, the object id and the id generation when the reference was taken,
+ * the object is resolved through the db on each access,
+ * so the reference survives storage reallocations.
+ * The reference becomes invalid when the object is removed, even if the id is reused.
+ * The owning db must outlive the reference.
+ */
+template<typename T, typename B=T, std::integral IdBase=std::uint64_t>
+class TWRef {
 
-class BWRef {
 public:
 
-    using TRACK = TWRefTrack_<BWRef>;
-
-    constexpr BWRef() noexcept :
-        object_(nullptr) {}
-
-    BWRef(void * in_object) :
-        object_(in_object) {
-        TRACK::RegInstance(object_, this);
-    }
-
-    BWRef(const BWRef & other) :
-        object_(other.object_) {
-        TRACK::RegInstance(object_, this);
-    }
-
-    BWRef(BWRef && other) :
-        object_(std::move(other.object_)) {
-        TRACK::UnregInstance(object_, &other);
-        TRACK::RegInstance(object_, this);
-    }
-
-    virtual ~BWRef() {
-        if (object_) {
-            TRACK::UnregInstance(object_, this);
-            object_ = nullptr;
-        }
-    }
-
-    BWRef & operator=(const BWRef & other) {
-        if (this != &other) {
-            BSet(other.object_);
-        }
+    using DbType = IObjectDataBase<B, IdBase>;
 
-        return *this;
-    }
-
-    BWRef & operator=(BWRef && other) {
-        if (this != &other) {
-            TRACK::UnregInstance(object_, this);
-            TRACK::UnregInstance(other.object_, &other);
-            object_ = std::move(other.object_);
-            other.object_=nullptr;
+public:
 
-            TRACK::RegInstance(object_, this);
-        }
+    constexpr TWRef() noexcept = default;
 
-        return *this;
-    }
+    TWRef(DbType * in_db, const IdBase & in_id) :
+        db_(in_db),
+        id_(in_id),
+        generation_(in_db->Generation(in_id)) {}
 
-    BWRef & operator=(void * in_value) {
-        if (object_ != in_value) {
-            BSet(in_value);
-        }
+    ~TWRef() = default;
 
-        return *this;
-    }
+    constexpr TWRef(const TWRef & other) noexcept = default;
 
-    virtual void BSet(void * in_address) {
-        TRACK::UnregInstance(object_, this);
-        object_ = in_address;
-        TRACK::RegInstance(object_, this);
-    }
+    constexpr TWRef(TWRef && other) noexcept = default;
 
-    void * BPtr() {
-        return object_;
-    }
+    constexpr TWRef & operator=(const TWRef & other) noexcept = default;
 
-    const void * BPtr() const {
-        return object_;
-    }
+    constexpr TWRef & operator=(TWRef && other) noexcept = default;
 
-    bool operator==(const BWRef & other) const
-    {
-        return object_ == other.object_;
+    WNODISCARD const IdBase & Id() const noexcept {
+        return id_;
     }
 
-    bool operator!=(const BWRef & other) const
-    {
-        return object_ != other.object_;
+    WNODISCARD std::size_t Generation() const noexcept {
+        return generation_;
     }
 
-    bool operator==(void * other) const
-    {
-        return object_ == other;
+    /**
+     * @brief True while the referenced object is in the db.
+     */
+    WNODISCARD bool IsValid() const {
+        return db_ &&
+            db_->Contains(id_) &&
+            db_->Generation(id_) == generation_;
     }
 
-    bool operator!=(void * other) const
-    {
-        return object_ != other;
+    WNODISCARD bool IsEmpty() const noexcept {
+        return db_ == nullptr;
     }
 
     operator bool() const { return IsValid(); }
 
-    constexpr bool IsValid() const noexcept { return object_ != nullptr; }
+    T * Ptr() {
+        assert(IsValid());
 
-    constexpr bool IsEmpty() const noexcept { return object_ == nullptr; }
+        B * result;
+        db_->Get(id_, result);
 
-    static bool IsInstanced(void * in_ptr) {
-        return TRACK::Contains(in_ptr);
+        return static_cast<T*>(result);
     }
 
-    static const std::vector<BWRef*> & Instances(void * in_ptr) {
-        return TRACK::Instances(in_ptr);
-    }
-
-protected:    
-
-private:
-
-    void * object_;
-
-};
-
-template<typename T>
-class TWRef : public BWRef {
-
-public:
-
-    constexpr TWRef() noexcept = default;
+    const T * Ptr() const {
+        assert(IsValid());
 
-    TWRef(const TWRef & in_other) = default;
+        const B * result;
+        db_->Get(id_, result);
 
-    TWRef(TWRef && in_other) = default;
-
-    ~TWRef() override = default;
-
-    TWRef(T * in_object) :
-        BWRef(in_object) {}
-
-    TWRef(T & in_object) :
-        BWRef(&in_object) {}
-
-    TWRef & operator=(T * in_value) {
-        BWRef::operator=(in_value);
-        return *this;
+        return static_cast<const T*>(result);
     }
 
-    TWRef & operator=(T & in_value) {
-        BWRef::operator=(&in_value);
-        return *this;
+    T & Get() {
+        return *Ptr();
     }
 
-    TWRef & operator=(T && other) = delete;
-
-    void Set(T * in_object) {
-        BWRef::BSet(in_object);
+    const T & Get() const {
+        return *Ptr();
     }
 
-    constexpr T * Ptr() noexcept {
-        return static_cast<T*>(BPtr());
+    T * operator->() {
+        return Ptr();
     }
 
-    constexpr const T * Ptr() const noexcept {
-        return static_cast<const T*>(BPtr());
+    const T * operator->() const {
+        return Ptr();
     }
 
-    T & Get() {
+    T & operator*() {
         return *Ptr();
     }
 
-    const T & Get() const {
+    const T & operator*() const {
         return *Ptr();
     }
 
-    T * operator->() 
-    {
-        return static_cast<T*>(BPtr());
+    bool operator==(const TWRef & other) const noexcept {
+        return db_ == other.db_ &&
+            id_ == other.id_ &&
+            generation_ == other.generation_;
     }
 
-    const T * operator->() const
-    {
-        return static_cast<const T*>(BPtr());
+    bool operator!=(const TWRef & other) const noexcept {
+        return !(*this == other);
     }
 
-    T & operator*()
-    {
-        return *static_cast<T*>(BPtr());
-    }
+private:
 
-    const T & operator*() const
-    {
-        return *static_cast<const T*>(BPtr());
-    }
+    DbType * db_{nullptr};
+
+    IdBase id_{0};
+
+    std::size_t generation_{0};
 
 };
 
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "WCore/WCore.hpp"
+#include "WCore/WMappedFile.hpp"
+#include "WCoreTypes/WGeometry.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Cooked asset files, the binary format of imported assets.
+ *
+ * Little endian layout:
+ *   Header
+ *   Entry[header.entry_count]   table of contents
+ *   blobs                       each one ALIGNMENT aligned
+ *
+ * Blobs are raw arrays of the engine types (WVertex, WIndex, texels),
+ * a loader maps the file and copies each blob in one go, without per element parsing.
+ * VERSION changes whenever the layout or the blob types change.
+ */
+namespace was::cooked {
+
+    static_assert(std::endian::native == std::endian::little,
+                  "Cooked assets are little endian.");
+
+    inline constexpr std::array<char, 4> MAGIC{'W', 'C', 'O', 'K'};
+
+    inline constexpr std::uint32_t VERSION{1};
+
+    inline constexpr std::uint64_t ALIGNMENT{16};
+
+    inline constexpr std::string_view EXTENSION{".wcooked"};
+
+    enum class EAssetKind : std::uint32_t {
+        None=0,
+        StaticMesh=1,
+        Texture=2,
+        Level=3
+    };
+
+    enum class EBlobKind : std::uint32_t {
+        Vertices=1,
+        Indices=2,
+        TextureInfo=3,
+        Texels=4,
+        // WBinaryWriter stream, WPropertySerializer columns.
+        Properties=5
+    };
+
+    struct Header {
+        std::array<char, 4> magic{MAGIC};
+        std::uint32_t version{VERSION};
+        EAssetKind asset_kind{EAssetKind::None};
+        std::uint32_t entry_count{0};
+        // Stored to detect files cooked with other vertex layouts.
+        std::uint32_t vertex_size{sizeof(wct::geometry::WVertex)};
+        std::uint32_t index_size{sizeof(wct::geometry::WIndex)};
+        std::uint64_t file_size{0};
+    };
+
+    struct Entry {
+        EBlobKind kind{};
+        // Sub asset index, mesh index for static meshes.
+        std::uint32_t index{0};
+        std::uint64_t offset{0};
+        std::uint64_t size{0};
+    };
+
+    struct TextureInfo {
+        std::uint32_t format{0};
+        std::uint32_t width{0};
+        std::uint32_t height{0};
+        std::uint32_t sampler{0};
+    };
+
+    static_assert(sizeof(Header) == 32 && sizeof(Entry) == 24 && sizeof(TextureInfo) == 16);
+    static_assert(std::is_trivially_copyable_v<wct::geometry::WVertex>);
+
+    /**
+     * @brief Collects blobs and writes a cooked file, blobs are not copied until Write.
+     */
+    class WOBJECTS_API WCookedWriter {
+    public:
+
+        explicit WCookedWriter(EAssetKind in_kind) noexcept : kind_(in_kind) {}
+
+        template<typename T>
+        requires std::is_trivially_copyable_v<T>
+        void Add(EBlobKind in_kind, std::uint32_t in_index, std::span<const T> in_values) {
+            blobs_.push_back({{in_kind, in_index, 0, in_values.size_bytes()},
+                              std::as_bytes(in_values)});
+        }
+
+        /**
+         * @brief Write the file, throws std::runtime_error on failure.
+         */
+        void Write(const std::string & in_path) const;
+
+    private:
+
+        struct Blob {
+            Entry entry;
+            std::span<const std::byte> bytes;
+        };
+
+        EAssetKind kind_;
+
+        std::vector<Blob> blobs_{};
+
+    };
+
+    /**
+     * @brief Maps a cooked file and validates its header and table of contents.
+     * Blobs point into the mapping and live until the reader is destroyed.
+     */
+    class WOBJECTS_API WCookedReader {
+    public:
+
+        /**
+         * @brief Throws std::runtime_error if the file can't be mapped or is not a valid cooked file.
+         */
+        void Open(const std::string & in_path);
+
+        WNODISCARD const Header & GetHeader() const noexcept {
+            return *reinterpret_cast<const Header *>(file_.Data());
+        }
+
+        WNODISCARD std::span<const Entry> Entries() const noexcept {
+            return {
+                reinterpret_cast<const Entry *>(file_.Data() + sizeof(Header)),
+                GetHeader().entry_count
+            };
+        }
+
+        /**
+         * @brief First entry of in_kind and in_index, nullptr if missing.
+         */
+        WNODISCARD const Entry * Find(EBlobKind in_kind, std::uint32_t in_index=0) const noexcept;
+
+        template<typename T>
+        requires std::is_trivially_copyable_v<T>
+        WNODISCARD std::span<const T> Blob(const Entry & in_entry) const noexcept {
+            return {
+                reinterpret_cast<const T *>(file_.Data() + in_entry.offset),
+                static_cast<std::size_t>(in_entry.size / sizeof(T))
+            };
+        }
+
+    private:
+
+        WMappedFile file_{};
+
+    };
+
+    /**
+     * @brief Asset kind of a cooked file, EAssetKind::None if it isn't a valid cooked file.
+     */
+    WOBJECTS_API EAssetKind ReadAssetKind(const std::string & in_path);
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "WCore/WCore.hpp"
+#include "WCore/TStridedView.hpp"
+#include "WCore/WBinaryStream.hpp"
+#include "WClass/WClass.hpp"
+#include "WObjects/WObject.hpp"
+
+#include <span>
+
+/**
+ * @brief Binary serialization of WPROPERTY values driven by the WClass property list.
+ *
+ * Objects of the same class are written as a column, one block per property:
+ *   std::uint32_t property count, std::uint64_t object count
+ *   per property: name, EPropertyKind, element size, block size, block
+ *
+ * Trivial property blocks are the packed values of all the objects, gathered and
+ * scattered with one copy per value and no per value calls.
+ * Strings and vectors are length prefixed values.
+ * Reading matches properties by name, kind and element size, the rest are skipped,
+ * so classes can add or remove properties without breaking written data.
+ * Unsupported properties are not written.
+ */
+namespace WPropertySerializer {
+
+    WOBJECTS_API void WriteColumn(const WClass * in_class,
+                                  TStridedView<WObject> in_objects,
+                                  WBinaryWriter & in_writer);
+
+    WOBJECTS_API void WriteColumn(const WClass * in_class,
+                                  std::span<WObject * const> in_objects,
+                                  WBinaryWriter & in_writer);
+
+    /**
+     * @brief Read a column written by WriteColumn, in_objects must have the written count.
+     * Throws std::runtime_error if the data is invalid.
+     */
+    WOBJECTS_API void ReadColumn(const WClass * in_class,
+                                 TStridedView<WObject> in_objects,
+                                 WBinaryReader & in_reader);
+
+    WOBJECTS_API void ReadColumn(const WClass * in_class,
+                                 std::span<WObject * const> in_objects,
+                                 WBinaryReader & in_reader);
+
+    inline void WriteObject(const WObject & in_object, WBinaryWriter & in_writer) {
+        WObject * object = const_cast<WObject *>(&in_object);
+        WriteColumn(in_object.Class(), std::span<WObject * const>(&object, 1), in_writer);
+    }
+
+    inline void ReadObject(WObject & in_object, WBinaryReader & in_reader) {
+        WObject * object = &in_object;
+        ReadColumn(in_object.Class(), std::span<WObject * const>(&object, 1), in_reader);
+    }
+
+}
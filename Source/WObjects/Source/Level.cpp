@@ -3,8 +3,11 @@
 #include "WCore/WCore.hpp"
 #include "WObjects/WEntity.hpp"
 #include "WObjects/WComponent.hpp"
+#include "WObjects/WCookedAsset.hpp"
+#include "WCore/WBinaryStream.hpp"
 
 #include <format>
+#include <stdexcept>
 
 // WEntityId was::Level::CreateEntity(WClass const * in_class) {
 //     std::string actor_path = WEntityPath(in_class);
@@ -16,6 +19,29 @@
 //     return id;
 // }
 
+void was::Level::Serialize(const std::string & in_path) {
+    WBinaryWriter properties;
+    entity_component_db.Serialize(properties);
+
+    cooked::WCookedWriter writer(cooked::EAssetKind::Level);
+    writer.Add(cooked::EBlobKind::Properties, 0, properties.Bytes());
+    writer.Write(in_path);
+}
+
+void was::Level::Deserialize(const std::string & in_path) {
+    cooked::WCookedReader reader;
+    reader.Open(in_path);
+
+    const cooked::Entry * properties = reader.Find(cooked::EBlobKind::Properties);
+
+    if (reader.GetHeader().asset_kind != cooked::EAssetKind::Level || !properties) {
+        throw std::runtime_error(std::format("{} is not a cooked level.", in_path));
+    }
+
+    WBinaryReader stream(reader.Blob<std::byte>(*properties));
+    entity_component_db.Deserialize(stream);
+}
+
 WEntity * was::Level::GetEntity(const wcr::wid::WEntityId & in_id) const {
     return entity_component_db.GetEntity(in_id);
 }
@@ -41,7 +67,7 @@ std::string was::Level::WEntityPath(const WClass * in_class) const {
 std::string was::Level::ComponentPath(const wcr::wid::WEntityId & in_entity_id,
                                   const WClass * in_class) const {
 
-    TWRef<WEntity> actor = entity_component_db.GetEntity(in_entity_id);
+    WEntity * actor = entity_component_db.GetEntity(in_entity_id);
 
     return std::string(actor->Get_name().View()) + ":" + in_class->Name();
 }
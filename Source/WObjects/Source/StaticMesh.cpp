@@ -0,0 +1,59 @@
+#include "WAssets/StaticMesh.hpp"
+#include "WObjects/WCookedAsset.hpp"
+
+#include <format>
+#include <stdexcept>
+
+void was::StaticMesh::Serialize(const std::string & in_path) {
+    cooked::WCookedWriter writer(cooked::EAssetKind::StaticMesh);
+
+    for (std::uint32_t i=0; i < MeshCount(); i++) {
+        writer.Add(cooked::EBlobKind::Vertices, i,
+                   std::span<const wct::geometry::WVertex>(meshes[i].vertices));
+        writer.Add(cooked::EBlobKind::Indices, i,
+                   std::span<const wct::geometry::WIndex>(meshes[i].indices));
+    }
+
+    writer.Write(in_path);
+}
+
+void was::StaticMesh::Deserialize(const std::string & in_path) {
+    cooked::WCookedReader reader;
+    reader.Open(in_path);
+
+    if (reader.GetHeader().asset_kind != cooked::EAssetKind::StaticMesh) {
+        throw std::runtime_error(std::format("{} is not a cooked static mesh.", in_path));
+    }
+
+    // Validated before replacing the current meshes.
+    decltype(meshes) result{};
+
+    for (std::uint32_t i=0; i < MAX_MESH_COUNT; i++) {
+        const cooked::Entry * vertices = reader.Find(cooked::EBlobKind::Vertices, i);
+        const cooked::Entry * indices = reader.Find(cooked::EBlobKind::Indices, i);
+
+        if (!vertices || !indices) break;
+
+        if (vertices->size % sizeof(wct::geometry::WVertex) != 0 ||
+            indices->size % sizeof(wct::geometry::WIndex) != 0) {
+            throw std::runtime_error(
+                std::format("{} mesh {} has a truncated vertex or index blob.", in_path, i));
+        }
+
+        // Contiguous trivially copyable ranges, assign copies them at once.
+        auto vertex_blob = reader.Blob<wct::geometry::WVertex>(*vertices);
+        auto index_blob = reader.Blob<wct::geometry::WIndex>(*indices);
+
+        for (const wct::geometry::WIndex & index : index_blob) {
+            if (index >= vertex_blob.size()) {
+                throw std::runtime_error(
+                    std::format("{} mesh {} indexes a vertex out of range.", in_path, i));
+            }
+        }
+
+        result[i].vertices.assign(vertex_blob.begin(), vertex_blob.end());
+        result[i].indices.assign(index_blob.begin(), index_blob.end());
+    }
+
+    meshes = std::move(result);
+}
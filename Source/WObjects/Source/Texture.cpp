@@ -0,0 +1,59 @@
+#include "WAssets/Texture.hpp"
+#include "WObjects/WCookedAsset.hpp"
+
+#include <format>
+#include <stdexcept>
+
+void was::Texture::Serialize(const std::string & in_path) {
+    cooked::TextureInfo info{
+        static_cast<std::uint32_t>(format),
+        width,
+        height,
+        static_cast<std::uint32_t>(sampler)
+    };
+
+    cooked::WCookedWriter writer(cooked::EAssetKind::Texture);
+    writer.Add(cooked::EBlobKind::TextureInfo, 0, std::span<const cooked::TextureInfo>(&info, 1));
+    writer.Add(cooked::EBlobKind::Texels, 0, std::span<const std::uint8_t>(data_));
+    writer.Write(in_path);
+}
+
+void was::Texture::Deserialize(const std::string & in_path) {
+    cooked::WCookedReader reader;
+    reader.Open(in_path);
+
+    const cooked::Entry * info_entry = reader.Find(cooked::EBlobKind::TextureInfo);
+    const cooked::Entry * texels = reader.Find(cooked::EBlobKind::Texels);
+
+    if (reader.GetHeader().asset_kind != cooked::EAssetKind::Texture ||
+        !info_entry || info_entry->size != sizeof(cooked::TextureInfo) ||
+        !texels) {
+        throw std::runtime_error(std::format("{} is not a cooked texture.", in_path));
+    }
+
+    const cooked::TextureInfo & info = reader.Blob<cooked::TextureInfo>(*info_entry)[0];
+
+    const auto info_format = static_cast<wct::texture::ETextureFormat>(info.format);
+
+    // Validated before any member is assigned.
+    std::uint64_t texels_size =
+        static_cast<std::uint64_t>(info.width) *
+        info.height *
+        wct::texture::NumOfChannels(info_format) *
+        (wct::texture::ColorDepth(info_format) / 8);
+
+    if (texels->size != texels_size) {
+        throw std::runtime_error(
+            std::format("{} texel size doesn't match its {}x{} dimensions.",
+                        in_path, info.width, info.height)
+            );
+    }
+
+    auto texel_blob = reader.Blob<std::uint8_t>(*texels);
+
+    format = info_format;
+    width = info.width;
+    height = info.height;
+    sampler = static_cast<wct::texture::ESampler>(info.sampler);
+    data_.assign(texel_blob.begin(), texel_blob.end());
+}
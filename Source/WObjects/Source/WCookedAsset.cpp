@@ -0,0 +1,122 @@
+#include "WObjects/WCookedAsset.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+    std::uint64_t AlignUp(std::uint64_t in_value) {
+        return (in_value + was::cooked::ALIGNMENT - 1) & ~(was::cooked::ALIGNMENT - 1);
+    }
+
+    bool ValidHeader(const was::cooked::Header & in_header, std::size_t in_file_size) {
+        return in_header.magic == was::cooked::MAGIC &&
+            in_header.version == was::cooked::VERSION &&
+            in_header.vertex_size == sizeof(wct::geometry::WVertex) &&
+            in_header.index_size == sizeof(wct::geometry::WIndex) &&
+            in_header.file_size == in_file_size &&
+            sizeof(was::cooked::Header) +
+            in_header.entry_count * sizeof(was::cooked::Entry) <= in_file_size;
+    }
+
+}
+
+void was::cooked::WCookedWriter::Write(const std::string & in_path) const {
+    Header header{};
+    header.asset_kind = kind_;
+    header.entry_count = static_cast<std::uint32_t>(blobs_.size());
+
+    std::vector<Entry> entries;
+    entries.reserve(blobs_.size());
+
+    std::uint64_t offset = AlignUp(sizeof(Header) + blobs_.size() * sizeof(Entry));
+
+    for (const Blob & blob : blobs_) {
+        Entry entry = blob.entry;
+        entry.offset = offset;
+        entries.push_back(entry);
+
+        offset = AlignUp(offset + entry.size);
+    }
+
+    header.file_size = offset;
+
+    std::ofstream file(in_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error(std::format("Can't write cooked asset {}.", in_path));
+    }
+
+    static constexpr std::array<char, ALIGNMENT> padding{};
+
+    auto write_padded = [&file](const void * _data, std::uint64_t _size, std::uint64_t _end) {
+        file.write(static_cast<const char *>(_data), static_cast<std::streamsize>(_size));
+        std::uint64_t pos = static_cast<std::uint64_t>(file.tellp());
+        file.write(padding.data(), static_cast<std::streamsize>(_end - pos));
+    };
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+
+    write_padded(entries.data(),
+                 entries.size() * sizeof(Entry),
+                 entries.empty() ? AlignUp(sizeof(Header)) : entries[0].offset);
+
+    for (std::size_t i=0; i < blobs_.size(); i++) {
+        write_padded(blobs_[i].bytes.data(),
+                     entries[i].size,
+                     AlignUp(entries[i].offset + entries[i].size));
+    }
+
+    if (!file) {
+        throw std::runtime_error(std::format("Can't write cooked asset {}.", in_path));
+    }
+}
+
+void was::cooked::WCookedReader::Open(const std::string & in_path) {
+    if (!file_.Open(in_path) || file_.Size() < sizeof(Header)) {
+        file_.Close();
+        throw std::runtime_error(std::format("Can't open cooked asset {}.", in_path));
+    }
+
+    if (!ValidHeader(GetHeader(), file_.Size())) {
+        file_.Close();
+        throw std::runtime_error(std::format("Invalid cooked asset {}.", in_path));
+    }
+
+    for (const Entry & entry : Entries()) {
+        if (entry.offset % ALIGNMENT != 0 ||
+            entry.offset > file_.Size() ||
+            entry.size > file_.Size() - entry.offset) {
+            file_.Close();
+            throw std::runtime_error(std::format("Corrupt cooked asset {}.", in_path));
+        }
+    }
+}
+
+const was::cooked::Entry * was::cooked::WCookedReader::Find(EBlobKind in_kind, std::uint32_t in_index) const noexcept {
+    for (const Entry & entry : Entries()) {
+        if (entry.kind == in_kind && entry.index == in_index) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+was::cooked::EAssetKind was::cooked::ReadAssetKind(const std::string & in_path) {
+    Header header{};
+
+    std::ifstream file(in_path, std::ios::binary | std::ios::ate);
+    if (!file) return EAssetKind::None;
+
+    std::size_t size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0);
+
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(Header)) ||
+        !ValidHeader(header, size)) {
+        return EAssetKind::None;
+    }
+
+    return header.asset_kind;
+}
@@ -2,6 +2,11 @@
 #include "WCore/WCore.hpp"
 #include "WObjects/WEntity.hpp"
 #include "WObjects/WComponent.hpp"
+#include "WObjects/WPropertySerializer.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
 
 // WEntityId WEntityComponentDb::CreateEntity(const WClass * in_class, const char * in_name) {
 //     assert(
@@ -20,7 +25,7 @@
 // void WEntityComponentDb::InsertEntity(const WClass * in_class,
 //                                       const WEntityId & in_id,
 //                                       const char * in_name) {
-//     entity_db_.CreateAt(in_class, in_id);
+//     entity_db_.CreateAt(in_class, EntityIndex(in_id));
 //     UpdateEntityData(in_class, in_id, in_name);
 //     entity_id_pool_.ExtractFromPool(in_id.GetId());
 // }
@@ -42,25 +47,80 @@ wcr::wid::WEntityId WEntityComponentDb::CreateEntityId(const WClass * in_class)
     assert(WEntity::StaticClass() == in_class ||
            WEntity::StaticClass()->IsBaseOf(in_class));
 
-    auto id = entity_id_pool_.Generate();
-    id_entityclass_[id] = in_class;
+    auto index = entity_id_pool_.Generate();
+
+    if (index >= generations_.size()) {
+        generations_.resize(index + 1, 0);
+    }
 
-    return id;
+    id_entityclass_[index] = in_class;
 
+    return wcr::wid::WEntityId_Meta::Compose(index, generations_[index]);
 }
 
-void WEntityComponentDb::UpdateComponentMetadata(const WClass * in_component_class, const wcr::wid::WEntityId & in_id) {
-    if (!entity_components_.contains(in_id)) {
-        entity_components_[in_id] = {};
+void WEntityComponentDb::ReserveEntityId(const WClass * in_class,
+                                         const wcr::wid::WEntityId & in_id) {
+    auto index = EntityIndex(in_id);
+
+    assert(!entity_records_.Contains(index));
+
+    entity_id_pool_.ExtractFromPool(index);
+
+    if (index >= generations_.size()) {
+        generations_.resize(index + 1, 0);
     }
-    
-    entity_components_[in_id].insert(in_component_class);
 
+    generations_[index] = wcr::wid::WEntityId_Meta::Generation(in_id);
+    id_entityclass_[index] = in_class;
+}
+
+void WEntityComponentDb::InsertEntity(const WClass * in_class,
+                                      const wcr::wid::WEntityId & in_id,
+                                      const char * in_name) {
+    assert(entity_db_.ContainsClass(in_class));
+
+    ReserveEntityId(in_class, in_id);
+    entity_db_.CreateAt(in_class, EntityIndex(in_id));
+    UpdateEntityData(in_class, in_id, in_name);
+}
+
+void WEntityComponentDb::RemoveEntity(const wcr::wid::WEntityId & in_id) {
+    assert(IsAlive(in_id));
+
+    auto index = EntityIndex(in_id);
+
+    EntityRecord record = entity_records_.Get(index);
+
+    wcr::wid::WEntityId::IdType moved_id;
+    if (archetypes_[record.archetype].SwapRemove(record.row, moved_id)) {
+        entity_records_.Get(EntityIndex(moved_id)).row = record.row;
+    }
+
+    entity_records_.Remove(index);
+
+    entity_db_.Remove(id_entityclass_.at(index), index);
+    id_entityclass_.erase(index);
+
+    generations_[index] = wcr::wid::WEntityId_Meta::NextGeneration(generations_[index]);
+    entity_id_pool_.AddToPool(index);
+}
+
+void WEntityComponentDb::UpdateComponentMetadata(const WClass * in_component_class) {
     // Update component class id
-    if (!componentclass_id_.contains(in_component_class)) {
+    const std::size_t index = in_component_class->TypeIndex();
+
+    if (index >= componentclass_id_.size()) {
+        componentclass_id_.resize(index + 1);
+    }
+
+    if (!componentclass_id_[index].IsValid()) {
         wcr::wid::WComponentTypeId id = component_class_id_pool_.Generate();
-        componentclass_id_[in_component_class] = id;
-        id_componentclass_[id] = in_component_class;
+        componentclass_id_[index] = id;
+
+        if (id.GetId() >= id_componentclass_.size()) {
+            id_componentclass_.resize(id.GetId() + 1, nullptr);
+        }
+        id_componentclass_[id.GetId()] = in_component_class;
     }
 }
 
@@ -69,9 +129,316 @@ void WEntityComponentDb::UpdateEntityData(const WClass * in_entity_class,
                                           // TODO WObjectName
                                           const char * in_name) {
 
-    WEntity* entity = entity_db_.Get(in_entity_class, in_id);
+    WEntity* entity = entity_db_.Get(in_entity_class, EntityIndex(in_id));
 
     entity->Set_entity_id(in_id);
     entity->Set_name({in_name});
-    
+
+    entity_records_.Insert(
+        EntityIndex(in_id),
+        EntityRecord{0, archetypes_[0].PushRow(in_id.GetId())}
+        );
+}
+
+void WEntityComponentDb::RemoveComponent(const WClass * in_class,
+                                         const wcr::wid::WEntityId & in_entity_id) {
+    assert(ContainsComponent(in_class, in_entity_id));
+
+    MoveEntity(
+        in_entity_id,
+        ArchetypeRemove(entity_records_.Get(EntityIndex(in_entity_id)).archetype, in_class)
+        );
+}
+
+std::size_t WEntityComponentDb::ArchetypeAdd(std::size_t in_archetype,
+                                             const WClass * in_class) {
+    std::size_t result = archetypes_[in_archetype].AddEdge(in_class);
+
+    if (result != ArchetypeType::NONE) {
+        return result;
+    }
+
+    const ArchetypeType & src = archetypes_[in_archetype];
+
+    std::vector<const WClass *> signature = src.Signature();
+    signature.insert(
+        std::lower_bound(signature.begin(), signature.end(), in_class, std::less<const WClass *>{}),
+        in_class
+        );
+
+    if (archetype_index_.contains(signature)) {
+        result = archetype_index_.at(signature);
+    }
+    else {
+        ArchetypeType archetype;
+        for (std::size_t i=0; i < src.ColumnCount(); i++) {
+            archetype.AddColumn(src.Signature()[i], src.Column(i).CloneEmpty());
+        }
+        archetype.AddColumn(in_class, in_class->ComponentColumn());
+
+        result = RegisterArchetype(std::move(archetype));
+    }
+
+    archetypes_[in_archetype].SetAddEdge(in_class, result);
+    archetypes_[result].SetRemoveEdge(in_class, in_archetype);
+
+    return result;
+}
+
+std::size_t WEntityComponentDb::ArchetypeRemove(std::size_t in_archetype,
+                                                const WClass * in_class) {
+    std::size_t result = archetypes_[in_archetype].RemoveEdge(in_class);
+
+    if (result != ArchetypeType::NONE) {
+        return result;
+    }
+
+    const ArchetypeType & src = archetypes_[in_archetype];
+
+    std::vector<const WClass *> signature = src.Signature();
+    std::erase(signature, in_class);
+
+    if (archetype_index_.contains(signature)) {
+        result = archetype_index_.at(signature);
+    }
+    else {
+        ArchetypeType archetype;
+        for (std::size_t i=0; i < src.ColumnCount(); i++) {
+            if (src.Signature()[i] == in_class) continue;
+            archetype.AddColumn(src.Signature()[i], src.Column(i).CloneEmpty());
+        }
+
+        result = RegisterArchetype(std::move(archetype));
+    }
+
+    archetypes_[in_archetype].SetRemoveEdge(in_class, result);
+    archetypes_[result].SetAddEdge(in_class, in_archetype);
+
+    return result;
+}
+
+std::size_t WEntityComponentDb::RegisterArchetype(ArchetypeType && in_archetype) {
+    std::size_t result = archetypes_.size();
+
+    archetype_index_[in_archetype.Signature()] = result;
+    archetypes_.push_back(std::move(in_archetype));
+
+    return result;
+}
+
+void WEntityComponentDb::MoveEntity(const wcr::wid::WEntityId & in_entity_id,
+                                    std::size_t in_archetype) {
+    EntityRecord & record = entity_records_.Get(EntityIndex(in_entity_id));
+
+    if (record.archetype == in_archetype) return;
+
+    ArchetypeType & src = archetypes_[record.archetype];
+
+    std::size_t row = src.MoveRowTo(record.row, archetypes_[in_archetype]);
+
+    wcr::wid::WEntityId::IdType moved_id;
+    if (src.SwapRemove(record.row, moved_id)) {
+        entity_records_.Get(EntityIndex(moved_id)).row = record.row;
+    }
+
+    record = {in_archetype, row};
+}
+
+void WEntityComponentDb::UpdateQueryCache(QueryCache & in_cache) const {
+    std::lock_guard lock(query_mutex_.mutex);
+
+    for (std::size_t a = in_cache.archetypes_seen; a < archetypes_.size(); a++) {
+        const ArchetypeType & archetype = archetypes_[a];
+
+        if (archetype.ColumnCount() < in_cache.classes.size()) continue;
+
+        std::size_t first = in_cache.columns.size();
+        bool match = true;
+
+        for (const WClass * c : in_cache.classes) {
+            std::size_t column = archetype.ColumnIndex(c);
+            if (column == ArchetypeType::NONE) {
+                match = false;
+                break;
+            }
+            in_cache.columns.push_back(column);
+        }
+
+        if (match) {
+            in_cache.archetypes.push_back(a);
+        }
+        else {
+            in_cache.columns.resize(first);
+        }
+    }
+
+    in_cache.archetypes_seen = archetypes_.size();
+}
+
+namespace {
+
+    /**
+     * @brief Ids written with WriteSpan, copied out since the data has no alignment.
+     */
+    void ReadIds(WBinaryReader & in_reader, std::vector<wcr::wid::WEntityId::IdType> & out_ids) {
+        out_ids.resize(in_reader.ReadCount(sizeof(wcr::wid::WEntityId::IdType)));
+        in_reader.Read(out_ids.data(), out_ids.size() * sizeof(wcr::wid::WEntityId::IdType));
+    }
+
+    const WClass * FindSerializedClass(std::string_view in_name, const WClass * in_base) {
+        const WClass * result = WClass::FindClass(in_name);
+
+        if (!result || (result != in_base && !in_base->IsBaseOf(result))) {
+            throw std::runtime_error(
+                std::format("Unknown {} class {}.", in_base->Name(), in_name));
+        }
+
+        return result;
+    }
+
+}
+
+void WEntityComponentDb::Serialize(WBinaryWriter & in_writer) const {
+    // Entities by class, ids first so they can be created before reading their properties.
+    const std::vector<const WClass *> entity_classes =
+        entity_db_.DerivedClasses(WEntity::StaticClass());
+
+    in_writer.Write(static_cast<std::uint32_t>(entity_classes.size()));
+
+    std::vector<WObject *> entities;
+    std::vector<wcr::wid::WEntityId::IdType> ids;
+
+    for (const WClass * c : entity_classes) {
+        entities.clear();
+        ids.clear();
+
+        entity_db_.ForEach(c, [&entities, &ids](WEntity * _entity) {
+            entities.push_back(_entity);
+            ids.push_back(_entity->Get_entity_id().GetId());
+        });
+
+        in_writer.WriteString(c->Name());
+        in_writer.WriteSpan(std::span<const wcr::wid::WEntityId::IdType>(ids));
+        WPropertySerializer::WriteColumn(c, std::span<WObject * const>(entities), in_writer);
+    }
+
+    // Archetypes with components, each column is written in one go.
+    std::uint32_t archetype_count = 0;
+    std::size_t archetype_count_position = in_writer.Size();
+    in_writer.Write(archetype_count);
+
+    for (const ArchetypeType & archetype : archetypes_) {
+        if (archetype.Count() == 0 || archetype.ColumnCount() == 0) continue;
+
+        archetype_count++;
+
+        in_writer.Write(static_cast<std::uint32_t>(archetype.ColumnCount()));
+        for (const WClass * c : archetype.Signature()) {
+            in_writer.WriteString(c->Name());
+        }
+
+        in_writer.WriteSpan(std::span<const wcr::wid::WEntityId::IdType>(archetype.Ids()));
+
+        for (std::size_t i=0; i < archetype.ColumnCount(); i++) {
+            TStridedView<WComponent> view = archetype.Column(i).BView();
+
+            WPropertySerializer::WriteColumn(
+                archetype.Signature()[i],
+                TStridedView<WObject>(view.Data(), view.Stride(), view.Count()),
+                in_writer);
+        }
+    }
+
+    in_writer.Patch(archetype_count_position, archetype_count);
+}
+
+void WEntityComponentDb::Deserialize(WBinaryReader & in_reader) {
+    *this = WEntityComponentDb();
+
+    std::uint32_t entity_class_count = in_reader.Read<std::uint32_t>();
+
+    std::vector<wcr::wid::WEntityId::IdType> ids;
+    std::vector<WObject *> entities;
+
+    for (std::uint32_t c=0; c < entity_class_count; c++) {
+        const WClass * entity_class = FindSerializedClass(in_reader.ReadString(), WEntity::StaticClass());
+
+        // Derived entity classes are only known by name here.
+        entity_db_.EnsureClassStorage(entity_class);
+
+        ReadIds(in_reader, ids);
+        std::size_t count = ids.size();
+
+        entities.clear();
+
+        // Create all of them first, creation can move the stored entities.
+        for (std::size_t i=0; i < count; i++) {
+            wcr::wid::WEntityId id(ids[i]);
+
+            if (!IsAlive(id)) {
+                InsertEntity(entity_class, id, "");
+            }
+        }
+
+        for (std::size_t i=0; i < count; i++) {
+            entities.push_back(GetEntity(wcr::wid::WEntityId(ids[i])));
+        }
+
+        WPropertySerializer::ReadColumn(entity_class, std::span<WObject * const>(entities), in_reader);
+    }
+
+    std::uint32_t archetype_count = in_reader.Read<std::uint32_t>();
+
+    std::vector<const WClass *> classes;
+
+    for (std::uint32_t a=0; a < archetype_count; a++) {
+        std::uint32_t column_count = in_reader.Read<std::uint32_t>();
+
+        // Each class name takes at least its size.
+        if (column_count > in_reader.Remaining() / sizeof(std::uint64_t)) {
+            throw std::runtime_error(std::format("Invalid archetype of {} columns.", column_count));
+        }
+
+        classes.resize(column_count);
+
+        std::size_t archetype = 0;
+        for (const WClass *& component_class : classes) {
+            component_class = FindSerializedClass(in_reader.ReadString(), WComponent::StaticClass());
+
+            if (archetypes_[archetype].Contains(component_class)) {
+                throw std::runtime_error(
+                    std::format("Component class {} is repeated in an archetype.", component_class->Name()));
+            }
+
+            UpdateComponentMetadata(component_class);
+            archetype = ArchetypeAdd(archetype, component_class);
+        }
+
+        ReadIds(in_reader, ids);
+        std::size_t count = ids.size();
+
+        std::size_t first = archetypes_[archetype].Count();
+
+        // Rows are appended in ids order, components are default constructed.
+        for (std::size_t i=0; i < count; i++) {
+            wcr::wid::WEntityId id(ids[i]);
+
+            if (!IsAlive(id) || entity_records_.Get(EntityIndex(id)).archetype != 0) {
+                throw std::runtime_error(std::format("Invalid component entity {}.", ids[i]));
+            }
+
+            MoveEntity(id, archetype);
+        }
+
+        const ArchetypeType & target = archetypes_[archetype];
+
+        for (const WClass * component_class : classes) {
+            TStridedView<WComponent> view = target.Column(target.ColumnIndex(component_class)).BView();
+
+            WPropertySerializer::ReadColumn(
+                component_class,
+                TStridedView<WObject>(count > 0 ? view[first] : nullptr, view.Stride(), count),
+                in_reader);
+        }
+    }
 }
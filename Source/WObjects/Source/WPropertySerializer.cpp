@@ -0,0 +1,185 @@
+#include "WObjects/WPropertySerializer.hpp"
+
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Start of the object at in_row, for contiguous and scattered objects.
+     */
+    struct StridedRows {
+        std::byte * Row(std::size_t in_row) const noexcept {
+            return reinterpret_cast<std::byte *>(view[in_row]);
+        }
+
+        std::size_t Count() const noexcept {
+            return view.Count();
+        }
+
+        TStridedView<WObject> view;
+    };
+
+    struct PointerRows {
+        std::byte * Row(std::size_t in_row) const noexcept {
+            return reinterpret_cast<std::byte *>(objects[in_row]);
+        }
+
+        std::size_t Count() const noexcept {
+            return objects.size();
+        }
+
+        std::span<WObject * const> objects;
+    };
+
+    /**
+     * @brief Offset of in_property in the objects, the same for every object of a class.
+     */
+    template<typename TRows>
+    std::ptrdiff_t PropertyOffset(const WProperty & in_property, const TRows & in_rows) {
+        std::byte * object = in_rows.Row(0);
+
+        return static_cast<std::byte *>(in_property.address(reinterpret_cast<WObject *>(object))) -
+            object;
+    }
+
+    template<typename TRows>
+    void WriteRows(const WClass * in_class, const TRows & in_rows, WBinaryWriter & in_writer) {
+        const std::size_t count = in_rows.Count();
+
+        std::size_t property_count_position = in_writer.Size();
+        in_writer.Write(std::uint32_t{0});
+        in_writer.Write(static_cast<std::uint64_t>(count));
+
+        std::uint32_t property_count = 0;
+
+        in_class->ForEachProperty([&](const WProperty & _property) {
+            if (!_property.IsSerializable()) return;
+
+            property_count++;
+
+            in_writer.WriteString(_property.name);
+            in_writer.Write(_property.kind);
+            in_writer.Write(_property.element_size);
+
+            std::size_t block_size_position = in_writer.Size();
+            in_writer.Write(std::uint64_t{0});
+            std::size_t block_begin = in_writer.Size();
+
+            if (count > 0) {
+                std::ptrdiff_t offset = PropertyOffset(_property, in_rows);
+
+                if (_property.kind == EPropertyKind::Trivial) {
+                    const std::size_t size = _property.element_size;
+                    std::byte * block = in_writer.Append(size * count);
+
+                    for (std::size_t i=0; i < count; i++) {
+                        std::memcpy(block + i * size, in_rows.Row(i) + offset, size);
+                    }
+                }
+                else {
+                    for (std::size_t i=0; i < count; i++) {
+                        _property.write(in_rows.Row(i) + offset, in_writer);
+                    }
+                }
+            }
+
+            in_writer.Patch(block_size_position,
+                            static_cast<std::uint64_t>(in_writer.Size() - block_begin));
+        });
+
+        in_writer.Patch(property_count_position, property_count);
+    }
+
+    template<typename TRows>
+    void ReadRows(const WClass * in_class, const TRows & in_rows, WBinaryReader & in_reader) {
+        const std::size_t count = in_rows.Count();
+
+        std::uint32_t property_count = in_reader.Read<std::uint32_t>();
+        std::uint64_t written_count = in_reader.Read<std::uint64_t>();
+
+        if (written_count != count) {
+            throw std::runtime_error(
+                std::format("{} {} objects written, reading them into {} objects.",
+                            written_count, in_class->Name(), count));
+        }
+
+        std::vector<const WProperty *> properties;
+        in_class->ForEachProperty([&properties](const WProperty & _property) {
+            if (_property.IsSerializable()) {
+                properties.push_back(&_property);
+            }
+        });
+
+        for (std::uint32_t p=0; p < property_count; p++) {
+            std::string_view name = in_reader.ReadString();
+            EPropertyKind kind = in_reader.Read<EPropertyKind>();
+            std::uint32_t element_size = in_reader.Read<std::uint32_t>();
+            WBinaryReader block = in_reader.Sub(in_reader.ReadCount(1));
+
+            const WProperty * property = nullptr;
+            for (const WProperty *& candidate : properties) {
+                if (candidate &&
+                    candidate->name == name &&
+                    candidate->kind == kind &&
+                    candidate->element_size == element_size) {
+                    property = std::exchange(candidate, nullptr);
+                    break;
+                }
+            }
+
+            // Removed or changed property, the block is skipped.
+            if (!property || count == 0) continue;
+
+            std::ptrdiff_t offset = PropertyOffset(*property, in_rows);
+
+            if (kind == EPropertyKind::Trivial) {
+                const std::size_t size = element_size;
+
+                if (block.Remaining() != size * count) {
+                    throw std::runtime_error(
+                        std::format("Invalid {}::{} block size.", in_class->Name(), name));
+                }
+
+                const std::byte * values = block.Take(size * count);
+
+                for (std::size_t i=0; i < count; i++) {
+                    std::memcpy(in_rows.Row(i) + offset, values + i * size, size);
+                }
+            }
+            else {
+                for (std::size_t i=0; i < count; i++) {
+                    property->read(in_rows.Row(i) + offset, block);
+                }
+            }
+        }
+    }
+
+}
+
+void WPropertySerializer::WriteColumn(const WClass * in_class,
+                                      TStridedView<WObject> in_objects,
+                                      WBinaryWriter & in_writer) {
+    WriteRows(in_class, StridedRows{in_objects}, in_writer);
+}
+
+void WPropertySerializer::WriteColumn(const WClass * in_class,
+                                      std::span<WObject * const> in_objects,
+                                      WBinaryWriter & in_writer) {
+    WriteRows(in_class, PointerRows{in_objects}, in_writer);
+}
+
+void WPropertySerializer::ReadColumn(const WClass * in_class,
+                                     TStridedView<WObject> in_objects,
+                                     WBinaryReader & in_reader) {
+    ReadRows(in_class, StridedRows{in_objects}, in_reader);
+}
+
+void WPropertySerializer::ReadColumn(const WClass * in_class,
+                                     std::span<WObject * const> in_objects,
+                                     WBinaryReader & in_reader) {
+    ReadRows(in_class, PointerRows{in_objects}, in_reader);
+}
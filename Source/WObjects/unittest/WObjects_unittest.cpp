@@ -3,25 +3,67 @@
 #include "WCore/WCore.hpp"
 
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 
 #include <catch2/catch.hpp>
 
 #include "WCore/TRef.hpp"
+#include "WObjects/TWRef.hpp"
 // #include "WCore/TFunction.hpp"
 #include "WCore/TWAllocator.hpp"
 #include "WObjectDb/WObjectDb.hpp"
+#include "WObjectDb/WAssetDb.hpp"
 #include "WObjects/WAsset.hpp"
 #include "WAssets/StaticMesh.hpp"
+#include "WAssets/Level.hpp"
 #include "WObjects/WEntity.hpp"
+#include "WObjects/WPropertySerializer.hpp"
+#include "WObjects/WCookedAsset.hpp"
 #include "WObjectDb/WEntityComponentDb.hpp"
 #include "WComponents/StaticMesh.hpp"
 #include "WComponents/Transform.hpp"
 #include "WComponents/Camera.hpp"
+#include "WComponents/Movement.hpp"
 
+#include "WCore/WThreadLib.hpp"
+#include "WUtils/WMath.hpp"
 #include "WLog.hpp"
 
 #include <vector>
 #include <cstdio>
+#include <atomic>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief Entity class only used by the tests, its WOBJECT_BODY and registration
+ * are written as the generated ones.
+ */
+class TestEntity : public WEntity {
+public:
+    static const WClass * StaticClass() noexcept;
+    const WClass * Class() const override {
+        return TestEntity::StaticClass();
+    }
+    using WThisClass = TestEntity;
+    static std::integral_constant<std::size_t, 0>
+        WPropertyCount(TPropertyCounter<0>);
+
+    WPROPERTY(std::int32_t, score, 0);
+};
+
+inline const WClassFor<TestEntity, WEntity> test_entity_class{"TestEntity"};
+
+const WClass * TestEntity::StaticClass() noexcept {
+    return &test_entity_class;
+}
+
+namespace {
+    [[maybe_unused]] const bool test_entity_registered =
+        WClass::RegisterClass(&test_entity_class);
+}
 
 bool TWAllocator_in_vector() {
     WFLOG("START")
@@ -72,7 +114,17 @@ bool WClass_Derived_Test() {
 
     WFLOG("END")
 
-    return cls1 == cls2 && cls1->IsBaseOf(cls3);
+    const WClass * cls4 = wcm::Transform::StaticClass();
+
+    return cls1 == cls2 && cls1->IsBaseOf(cls3) &&
+        !cls3->IsBaseOf(cls1) &&
+        !cls1->IsBaseOf(cls1) &&
+        cls1->IsBaseOf(cls4) &&
+        WComponent::StaticClass()->IsBaseOf(cls4) &&
+        !cls3->IsBaseOf(cls4) &&
+        cls1->TypeIndex() < cls3->TypeIndex() &&
+        cls3->TypeIndex() != cls4->TypeIndex() &&
+        cls4->TypeIndex() < WClass::TypeCount();
 }
 
 bool WObjectDb_TWRef_Test() {
@@ -82,31 +134,38 @@ bool WObjectDb_TWRef_Test() {
     man.InitialMemorySize(1);
 
     man.CreateAt<was::StaticMesh>(1);
-    TWRef<was::StaticMesh> a =
-        man.Get<was::StaticMesh>(1);
+    auto a = man.Ref<was::StaticMesh>(1);
 
     man.CreateAt<was::Texture>(2);
-    TWRef<was::Texture> t =
-        man.Get<was::Texture>(2);
+    auto t = man.Ref<was::Texture>(2);
 
     a->Set_name("a");
     t->Set_name("t");
 
-    WFLOG("Initial \"a\" ptr to: {:d}" , (size_t)a.BPtr());
+    WFLOG("Initial \"a\" ptr to: {:d}" , (size_t)a.Ptr());
     WFLOG("Name: {}", a->Get_name().View());
 
-    void* ptr = a.BPtr();
+    void* ptr = a.Ptr();
 
     for (size_t i=0; i<10; i++) {
         man.CreateAt<was::StaticMesh>(i+3);
     }
 
-    WFLOG("Final \"a\" ptr to: {:d}", (size_t)a.BPtr());
+    WFLOG("Final \"a\" ptr to: {:d}", (size_t)a.Ptr());
     WFLOG("Name: {}", a->Get_name().View());
 
+    if (ptr == a.Ptr() || a->Get_name().View() != "a") return false;
+
+    man.Remove(was::StaticMesh::StaticClass(), 1);
+
+    if (a.IsValid()) return false;
+
+    // Same id, new generation, the old reference stays invalid.
+    man.CreateAt<was::StaticMesh>(1);
+
     WFLOG("END")
 
-    return ptr != a.BPtr();
+    return !a.IsValid() && man.Ref<was::StaticMesh>(1).IsValid() && t.IsValid();
 }
 
 bool WObjectDb_WClass_Test() {
@@ -116,15 +175,17 @@ bool WObjectDb_WClass_Test() {
 
     WFLOG("Create a1");
     man.CreateAt<WEntity>(1);
-    TWRef<WEntity> a1 = man.Get<WEntity>(1);
+    auto a1 = man.Ref<WEntity>(1);
     
     WFLOG("Create a2");
     man.CreateAt<WEntity>(2);
     
-    TWRef<WObject> a2 = man.Get(WEntity::StaticClass(),
-                                2);
+    auto a2 = man.Ref(WEntity::StaticClass(), 2);
+
+    const auto & derived = man.DerivedClasses(WObject::StaticClass());
 
-    return a2->Class()->Name() == "WEntity";
+    return a1.IsValid() && a2->Class()->Name() == "WEntity" &&
+        derived.size() == 1 && derived[0] == WEntity::StaticClass();
 }
 
 bool WEntityComponentDb_Test() {
@@ -194,9 +255,452 @@ bool WEntityComponentDb_Test() {
     db.CreateComponent<wcm::Camera>(eid);
     db.CreateComponent<wcm::StaticMesh>(eid);
 
+    wcr::wid::WEntityId eid2 = db.CreateEntity<WEntity>("E2");
+    db.CreateComponent<wcm::Transform>(eid2);
+    db.GetComponent<wcm::Transform>(eid2).Set_position(glm::vec3(1.0, 2.0, 3.0));
+
+    db.CreateComponent<wcm::Camera>(eid2);
+    db.RemoveComponent<wcm::Camera>(eid);
+
+    if (db.ContainsComponent<wcm::Camera>(eid)) return false;
+    if (!db.ContainsComponent<wcm::StaticMesh>(eid)) return false;
+    if (db.GetComponent<wcm::Transform>(eid2).Get_position() != glm::vec3(1.0, 2.0, 3.0)) return false;
+    if (db.GetComponent<wcm::StaticMesh>(eid).Get_entity_id() != eid) return false;
+
+    std::size_t transform_count = 0;
+    db.ForEachComponent<wcm::Transform>([&transform_count](wcm::Transform * _t) {
+        transform_count++;
+    });
+
     WEntityComponentDb other = db;
+
+    if (other.GetComponent<wcm::Transform>(eid2).Get_position() != glm::vec3(1.0, 2.0, 3.0)) return false;
     
-    return true;
+    return transform_count == 2;
+}
+
+bool WEntityComponentDb_Query_Test() {
+    WEntityComponentDb db;
+
+    for (std::uint32_t i=0; i<10; i++) {
+        wcr::wid::WEntityId eid = db.CreateEntity<WEntity>("E");
+        db.CreateComponent<wcm::Transform>(eid);
+
+        if (i % 2 == 0) {
+            db.CreateComponent<wcm::Movement>(eid);
+        }
+    }
+
+    auto query = db.Query<wcm::Movement, wcm::Transform>();
+
+    if (query.Count() != 5) return false;
+
+    // A new archetype (Movement, Transform, Camera) must be picked up by the cached query.
+    wcr::wid::WEntityId eid = db.CreateEntity<WEntity>("E");
+    db.CreateComponent<wcm::Camera>(eid);
+    db.CreateComponent<wcm::Transform>(eid);
+    db.CreateComponent<wcm::Movement>(eid);
+
+    if (query.Count() != 6) return false;
+
+    db.RemoveComponent<wcm::Movement>(eid);
+
+    bool ids_match = true;
+    std::size_t count = 0;
+    db.Query<wcm::Movement, wcm::Transform>().ForEach(
+        [&ids_match, &count](const wcr::wid::WEntityId & _id,
+                             wcm::Movement & _movement,
+                             wcm::Transform & _transform) {
+            ids_match = ids_match &&
+                _movement.Get_entity_id() == _id &&
+                _transform.Get_entity_id() == _id;
+            count++;
+        });
+
+    return ids_match && count == 5;
+}
+
+bool WEntityComponentDb_ParallelForEach_Test() {
+    WEntityComponentDb db;
+    WThreadLib::WJobSystem job_system(3);
+
+    std::vector<wcr::wid::WEntityId> ids;
+    for (std::uint32_t i=0; i<10'000; i++) {
+        wcr::wid::WEntityId eid = db.CreateEntity<WEntity>("E");
+        db.CreateComponent<wcm::Transform>(eid);
+        db.GetComponent<wcm::Transform>(eid).Set_position(glm::vec3(i, 0, 0));
+
+        if (i % 3 == 0) {
+            db.CreateComponent<wcm::Movement>(eid);
+        }
+
+        ids.push_back(eid);
+    }
+
+    std::atomic<std::size_t> transform_count{0};
+    db.ParallelForEachComponent<wcm::Transform>(
+        [&transform_count](wcm::Transform * _transform) {
+            _transform->Set_position(_transform->Get_position() + glm::vec3(1, 0, 0));
+            transform_count++;
+        }, 64, job_system);
+
+    // Derived classes go through the type erased path.
+    std::atomic<std::size_t> component_count{0};
+    db.ParallelForEachComponent<WComponent>(
+        [&component_count](WComponent *) { component_count++; },
+        0, job_system);
+
+    db.Query<wcm::Movement, wcm::Transform>().ParallelForEach(
+        [](const wcr::wid::WEntityId & _id,
+           wcm::Movement & _movement,
+           wcm::Transform & _transform) {
+            _movement.Set_drag(_transform.Get_position().x);
+        }, 64, job_system);
+
+    bool match = true;
+    for (std::uint32_t i=0; i<ids.size(); i++) {
+        match = match && db.GetComponent<wcm::Transform>(ids[i]).Get_position().x == i + 1;
+
+        if (i % 3 == 0) {
+            match = match && db.GetComponent<wcm::Movement>(ids[i]).Get_drag() == i + 1;
+        }
+    }
+
+    return match &&
+        transform_count.load() == 10'000 &&
+        component_count.load() == 10'000 + 3'334;
+}
+
+bool WEntityComponentDb_Generation_Test() {
+    WEntityComponentDb db;
+
+    wcr::wid::WEntityId eid = db.CreateEntity<WEntity>("E1");
+    db.CreateComponent<wcm::Transform>(eid);
+
+    wcr::wid::WEntityId eid2 = db.CreateEntity<WEntity>("E2");
+    db.CreateComponent<wcm::Transform>(eid2);
+    db.GetComponent<wcm::Transform>(eid2).Set_position(glm::vec3(1.0, 2.0, 3.0));
+
+    db.RemoveEntity(eid);
+
+    if (db.IsAlive(eid)) return false;
+    if (!db.IsAlive(eid2)) return false;
+    if (db.GetComponent<wcm::Transform>(eid2).Get_position() != glm::vec3(1.0, 2.0, 3.0)) return false;
+
+    // The index of eid is recycled with a new generation.
+    wcr::wid::WEntityId eid3 = db.CreateEntity<WEntity>("E3");
+
+    if (wcr::wid::WEntityId_Meta::Index(eid3) != wcr::wid::WEntityId_Meta::Index(eid)) return false;
+    if (eid3 == eid) return false;
+    if (db.IsAlive(eid) || !db.IsAlive(eid3)) return false;
+    if (db.ContainsComponent<wcm::Transform>(eid3)) return false;
+
+    return db.GetEntity(eid3)->Get_entity_id() == eid3;
+}
+
+bool Transform_Interpolation_Test() {
+    wcm::Transform transform{};
+    transform.Set_position(glm::vec3(0.0, 0.0, 0.0));
+    transform.StorePrevious();
+
+    transform.Set_position(glm::vec3(2.0, 4.0, 0.0));
+
+    wcm::Transform half = transform.Interpolated(0.5f);
+
+    if (half.Get_position() != glm::vec3(1.0, 2.0, 0.0)) return false;
+    if (glm::vec3(half.Get_transform_matrix()[3]) != glm::vec3(1.0, 2.0, 0.0)) return false;
+
+    // The source transform is not modified.
+    if (transform.Get_position() != glm::vec3(2.0, 4.0, 0.0)) return false;
+
+    if (!(transform.Interpolated(1.f).Get_position() == transform.Get_position() &&
+          transform.Interpolated(0.f).Get_position() == transform.Get_previous_position())) {
+        return false;
+    }
+
+    // Rotation wrapping from 170 to -170 degrees goes through 180, not through 0.
+    wcm::Transform rotated{};
+    rotated.Set_rotation(glm::vec3(0.0, 0.0, glm::radians(170.f)));
+    rotated.StorePrevious();
+    rotated.Set_rotation(glm::vec3(0.0, 0.0, glm::radians(-170.f)));
+
+    glm::vec3 x_axis = rotated.Interpolated(0.5f).Get_transform_matrix()[0];
+
+    return glm::length(x_axis - glm::vec3(-1.0, 0.0, 0.0)) < 0.001f;
+}
+
+bool StaticMesh_Cooked_Test() {
+    was::StaticMesh mesh{};
+
+    for (std::uint32_t m=0; m<2; m++) {
+        wct::geometry::WMesh geometry{};
+        for (std::uint32_t i=0; i<100 + m; i++) {
+            wct::geometry::WVertex vertex{};
+            vertex.position = {static_cast<float>(i), static_cast<float>(m), 0.f};
+            geometry.vertices.push_back(vertex);
+            geometry.indices.push_back(i);
+        }
+        mesh.SetMesh(std::move(geometry), m);
+    }
+
+    std::string path = (std::filesystem::temp_directory_path() / "StaticMesh_Cooked_Test.wcooked").string();
+    mesh.Serialize(path);
+
+    was::StaticMesh loaded{};
+    loaded.Deserialize(path);
+
+    // Indices out of range and blobs that aren't whole vertices are rejected.
+    auto rejects = [&path](std::span<const wct::geometry::WVertex> _vertices,
+                           std::span<const std::uint8_t> _vertex_bytes,
+                           std::span<const wct::geometry::WIndex> _indices) {
+        was::cooked::WCookedWriter writer(was::cooked::EAssetKind::StaticMesh);
+        if (_vertex_bytes.empty()) {
+            writer.Add(was::cooked::EBlobKind::Vertices, 0, _vertices);
+        }
+        else {
+            writer.Add(was::cooked::EBlobKind::Vertices, 0, _vertex_bytes);
+        }
+        writer.Add(was::cooked::EBlobKind::Indices, 0, _indices);
+        writer.Write(path);
+
+        try {
+            was::StaticMesh corrupt{};
+            corrupt.Deserialize(path);
+        }
+        catch (const std::runtime_error &) {
+            return true;
+        }
+        return false;
+    };
+
+    const std::vector<wct::geometry::WVertex> & vertices = mesh.GetMesh(0).vertices;
+    std::vector<wct::geometry::WIndex> out_of_range{0, 1, static_cast<wct::geometry::WIndex>(vertices.size())};
+    std::vector<std::uint8_t> truncated(sizeof(wct::geometry::WVertex) + 1, 0);
+
+    bool rejected = rejects(vertices, {}, out_of_range) &&
+        rejects({}, truncated, mesh.GetMesh(0).indices);
+
+    std::filesystem::remove(path);
+
+    return rejected &&
+        loaded.MeshCount() == 2 &&
+        loaded.GetMesh(1).vertices.size() == 101 &&
+        loaded.GetMesh(1).vertices[100] == mesh.GetMesh(1).vertices[100] &&
+        loaded.GetMesh(0).indices == mesh.GetMesh(0).indices;
+}
+
+bool Texture_Cooked_Test() {
+    std::vector<std::uint8_t> texels(4 * 4 * 4, 0);
+    for (std::size_t i=0; i<texels.size(); i++) {
+        texels[i] = static_cast<std::uint8_t>(i);
+    }
+
+    was::Texture texture{};
+    texture.SetTextureData(texels.data(), 4, 4, wct::texture::ETextureFormat::RGBA8_SRGB);
+
+    std::string path = (std::filesystem::temp_directory_path() / "Texture_Cooked_Test.wcooked").string();
+    texture.Serialize(path);
+
+    was::Texture loaded{};
+    loaded.Deserialize(path);
+
+    // A texture file is not a static mesh.
+    bool rejected = false;
+    try {
+        was::StaticMesh mesh{};
+        mesh.Deserialize(path);
+    }
+    catch (const std::runtime_error &) {
+        rejected = true;
+    }
+
+    // Texels that don't match the dimensions.
+    was::cooked::TextureInfo info{
+        static_cast<std::uint32_t>(wct::texture::ETextureFormat::RGBA8_SRGB), 4, 4, 0
+    };
+    was::cooked::WCookedWriter writer(was::cooked::EAssetKind::Texture);
+    writer.Add(was::cooked::EBlobKind::TextureInfo, 0, std::span<const was::cooked::TextureInfo>(&info, 1));
+    writer.Add(was::cooked::EBlobKind::Texels, 0, std::span<const std::uint8_t>(texels.data(), 3));
+    writer.Write(path);
+
+    // A failed load leaves the texture as it was.
+    bool size_rejected = false;
+    was::Texture truncated{loaded};
+    try {
+        truncated.Deserialize(path);
+    }
+    catch (const std::runtime_error &) {
+        size_rejected = truncated.Get_width() == loaded.Get_width() &&
+            truncated.Get_data_() == loaded.Get_data_();
+    }
+
+    std::filesystem::remove(path);
+
+    return rejected &&
+        size_rejected &&
+        loaded.Get_width() == 4 &&
+        loaded.Get_height() == 4 &&
+        loaded.Get_format() == texture.Get_format() &&
+        loaded.Get_sampler() == texture.Get_sampler() &&
+        loaded.Get_data_() == texels;
+}
+
+bool WProperty_Test() {
+    std::span<const WProperty> properties = wcm::Transform::StaticClass()->Properties();
+
+    if (properties.size() != 8) return false;
+    if (properties[0].name != "position" ||
+        properties[0].kind != EPropertyKind::Trivial ||
+        properties[0].element_size != sizeof(glm::vec3)) return false;
+    if (properties[3].name != "rotation_order") return false;
+
+    // Base properties first.
+    std::vector<std::string_view> names;
+    wcm::Transform::StaticClass()->ForEachProperty([&names](const WProperty & _property) {
+        names.push_back(_property.name);
+    });
+
+    if (names.size() != 9 || names[0] != "entity_id" || names[1] != "position") return false;
+
+    wcm::Transform transform{};
+    transform.Set_scale(glm::vec3(1.0, 2.0, 3.0));
+
+    void * scale = properties[2].address(&transform);
+
+    return scale == &transform.Get_scale() &&
+        WClass::FindClass(wcm::Transform::StaticClass()->Name()) == wcm::Transform::StaticClass();
+}
+
+bool WPropertySerializer_Test() {
+    WEntity entity{};
+    entity.Set_entity_id(7);
+    entity.Set_name("Serialized");
+
+    WBinaryWriter writer;
+    WPropertySerializer::WriteObject(entity, writer);
+
+    WEntity loaded{};
+    WBinaryReader reader(writer.Bytes());
+    WPropertySerializer::ReadObject(loaded, reader);
+
+    return reader.Remaining() == 0 &&
+        loaded.Get_entity_id() == entity.Get_entity_id() &&
+        loaded.Get_name().View() == "Serialized";
+}
+
+bool WEntityComponentDb_Serialize_Test() {
+    WEntityComponentDb db;
+
+    std::vector<wcr::wid::WEntityId> ids;
+    for (std::uint32_t i=0; i<100; i++) {
+        wcr::wid::WEntityId eid = db.CreateEntity<WEntity>(std::format("E{}", i).c_str());
+        ids.push_back(eid);
+
+        db.CreateComponent<wcm::Transform>(eid);
+        db.GetComponent<wcm::Transform>(eid).Set_position(glm::vec3(i, 0.0, 0.0));
+
+        if (i % 2 == 0) {
+            db.CreateComponent<wcm::Movement>(eid);
+            db.GetComponent<wcm::Movement>(eid).Set_drag(static_cast<float>(i));
+        }
+    }
+
+    // Recycled index with a new generation.
+    db.RemoveEntity(ids[3]);
+    wcr::wid::WEntityId recycled = db.CreateEntity<WEntity>("Recycled");
+
+    // Derived entity class, the loaded db has no storage for it yet.
+    wcr::wid::WEntityId derived = db.CreateEntity<TestEntity>("Derived");
+    static_cast<TestEntity *>(db.GetEntity(derived))->Set_score(7);
+    db.CreateComponent<wcm::Transform>(derived);
+
+    WBinaryWriter writer;
+    db.Serialize(writer);
+
+    WEntityComponentDb loaded;
+    WBinaryReader reader(writer.Bytes());
+    loaded.Deserialize(reader);
+
+    if (loaded.IsAlive(ids[3]) || !loaded.IsAlive(recycled)) return false;
+    if (loaded.GetEntity(recycled)->Get_name().View() != "Recycled") return false;
+    if (loaded.ContainsComponent<wcm::Transform>(recycled)) return false;
+
+    if (!loaded.IsAlive(derived) ||
+        loaded.GetEntity(derived)->Class() != TestEntity::StaticClass() ||
+        static_cast<TestEntity *>(loaded.GetEntity(derived))->Get_score() != 7 ||
+        loaded.GetEntity(derived)->Get_name().View() != "Derived" ||
+        !loaded.ContainsComponent<wcm::Transform>(derived)) return false;
+
+    for (std::uint32_t i=0; i<100; i++) {
+        if (i == 3) continue;
+
+        if (loaded.GetComponent<wcm::Transform>(ids[i]).Get_position() != glm::vec3(i, 0.0, 0.0)) return false;
+        if (loaded.GetComponent<wcm::Transform>(ids[i]).Get_entity_id() != ids[i]) return false;
+        if (loaded.ContainsComponent<wcm::Movement>(ids[i]) != (i % 2 == 0)) return false;
+        if (i % 2 == 0 && loaded.GetComponent<wcm::Movement>(ids[i]).Get_drag() != static_cast<float>(i)) return false;
+    }
+
+    // Truncated data is rejected.
+    bool rejected = false;
+    try {
+        WEntityComponentDb truncated;
+        WBinaryReader truncated_reader(writer.Bytes().first(writer.Size() / 2));
+        truncated.Deserialize(truncated_reader);
+    }
+    catch (const std::runtime_error &) {
+        rejected = true;
+    }
+
+    return rejected &&
+        reader.Remaining() == 0 &&
+        loaded.Query<wcm::Movement, wcm::Transform>().Count() == 50;
+}
+
+bool Level_Cooked_Test() {
+    was::Level level{};
+
+    wcr::wid::WEntityId eid = level.CreateEntity<WEntity>();
+    level.CreateComponent<wcm::Transform>(eid);
+    level.GetComponent<wcm::Transform>(eid).Set_rotation(glm::vec3(0.0, 1.0, 0.0));
+
+    std::string path = (std::filesystem::temp_directory_path() / "Level_Cooked_Test.wcooked").string();
+    level.Serialize(path);
+
+    was::Level loaded{};
+    loaded.Deserialize(path);
+
+    std::filesystem::remove(path);
+
+    return loaded.IsAlive(eid) &&
+        loaded.GetComponent<wcm::Transform>(eid).Get_rotation() == glm::vec3(0.0, 1.0, 0.0);
+}
+
+bool WAssetDb_Freeze_Test() {
+    WAssetDb asset_db;
+
+    wcr::wid::WAssetId first = asset_db.Create<was::Texture>("/Content/Test/Texture.First");
+
+    asset_db.Freeze();
+    asset_db.Freeze();
+    asset_db.Unfreeze();
+
+    bool rejected = false;
+    try {
+        asset_db.Create<was::Texture>("/Content/Test/Texture.Frozen");
+    }
+    catch (const std::runtime_error &) {
+        rejected = true;
+    }
+
+    asset_db.Unfreeze();
+
+    wcr::wid::WAssetId second = asset_db.Create<was::Texture>("/Content/Test/Texture.Second");
+
+    return rejected &&
+        !asset_db.IsFrozen() &&
+        !asset_db.GetId("/Content/Test/Texture.Frozen").IsValid() &&
+        asset_db.Get<was::Texture>(first).Get_asset_id() == first &&
+        asset_db.Get<was::Texture>(second).Get_asset_id() == second;
 }
 
 TEST_CASE("WObjects") {
@@ -205,6 +709,8 @@ TEST_CASE("WObjects") {
     }
     SECTION("WClass") {
         CHECK(WClass_Derived_Test());
+        CHECK(WProperty_Test());
+        CHECK(WPropertySerializer_Test());
     }
     SECTION("WObjectDb") {
         CHECK(WObjectDb_TWRef_Test());
@@ -212,6 +718,149 @@ TEST_CASE("WObjects") {
     }
     SECTION("WEntityComponentDb") {
         CHECK(WEntityComponentDb_Test());
+        CHECK(WEntityComponentDb_Query_Test());
+        CHECK(WEntityComponentDb_Generation_Test());
+        CHECK(WEntityComponentDb_ParallelForEach_Test());
+        CHECK(WEntityComponentDb_Serialize_Test());
+    }
+    SECTION("WComponents") {
+        CHECK(Transform_Interpolation_Test());
+    }
+    SECTION("WAssets") {
+        CHECK(WAssetDb_Freeze_Test());
+        CHECK(StaticMesh_Cooked_Test());
+        CHECK(Texture_Cooked_Test());
+        CHECK(Level_Cooked_Test());
+    }
+}
+
+TEST_CASE("WObjects_Benchmark", "[!benchmark]") {
+    WEntityComponentDb db;
+
+    // 100k entities, half of them with Movement and Transform, the rest only Transform.
+    for (std::uint32_t i=0; i<100'000; i++) {
+        wcr::wid::WEntityId eid = db.CreateEntity<WEntity>("E");
+        db.CreateComponent<wcm::Transform>(eid);
+
+        if (i % 2 == 0) {
+            db.CreateComponent<wcm::Movement>(eid);
+        }
+    }
+
+    BENCHMARK("100k entities, ForEachComponent<Movement> + GetComponent<Transform>") {
+        float sum = 0;
+        db.ForEachComponent<wcm::Movement>([&db, &sum](wcm::Movement * _movement) {
+            wcm::Transform & transform = db.GetComponent<wcm::Transform>(_movement->Get_entity_id());
+            sum += transform.Get_position().x + _movement->Get_drag();
+        });
+        return sum;
+    };
+
+    BENCHMARK("100k entities, Query<Movement, Transform>") {
+        float sum = 0;
+        db.Query<wcm::Movement, wcm::Transform>().ForEach(
+            [&sum](const wcr::wid::WEntityId & _id,
+                   wcm::Movement & _movement,
+                   wcm::Transform & _transform) {
+                sum += _transform.Get_position().x + _movement.Get_drag();
+            });
+        return sum;
+    };
+}
+
+TEST_CASE("WEntityComponentDb_Serialize_Benchmark", "[!benchmark]") {
+    WEntityComponentDb db;
+
+    for (std::uint32_t i=0; i<100'000; i++) {
+        wcr::wid::WEntityId eid = db.CreateEntity<WEntity>("E");
+        db.CreateComponent<wcm::Transform>(eid);
+        db.CreateComponent<wcm::Movement>(eid);
     }
+
+    WBinaryWriter writer;
+    db.Serialize(writer);
+
+    BENCHMARK("100k entities with Transform and Movement, Serialize") {
+        WBinaryWriter bench_writer;
+        bench_writer.Reserve(writer.Size());
+        db.Serialize(bench_writer);
+        return bench_writer.Size();
+    };
+
+    BENCHMARK("100k entities with Transform and Movement, Deserialize") {
+        WEntityComponentDb loaded;
+        WBinaryReader reader(writer.Bytes());
+        loaded.Deserialize(reader);
+        return loaded.EntityCount(WEntity::StaticClass());
+    };
 }
 
+TEST_CASE("WObjectDb_Benchmark", "[!benchmark]") {
+    BENCHMARK("WObjectDb CreateAt 0 to 1M") {
+        WObjectDb<WEntity, wcr::wid::WEntityId> db;
+        db.InitialMemorySize(0);
+
+        for (std::uint32_t i=1; i<=1'000'000; i++) {
+            db.CreateAt<WEntity>(i);
+        }
+
+        return db.Count(WEntity::StaticClass());
+    };
+
+    WObjectDb<WEntity, wcr::wid::WEntityId> db;
+    for (std::uint32_t i=1; i<=1'000'000; i++) {
+        db.CreateAt<WEntity>(i);
+    }
+
+    BENCHMARK("1M objects, ForEach(WClass*)") {
+        std::size_t count = 0;
+        db.ForEach(WEntity::StaticClass(), [&count](WEntity * _entity) {
+            count += _entity->Get_entity_id().GetId();
+        });
+        return count;
+    };
+
+    WEntityComponentDb ecdb;
+    for (std::uint32_t i=0; i<1'000'000; i++) {
+        ecdb.CreateComponent<wcm::Movement>(ecdb.CreateEntity<WEntity>("E"));
+    }
+
+    BENCHMARK("1M components, ForEachComponent(WClass*)") {
+        std::size_t count = 0;
+        ecdb.ForEachComponent(wcm::Movement::StaticClass(), [&count](WComponent * _component) {
+            count += _component->Get_entity_id().GetId();
+        });
+        return count;
+    };
+}
+
+TEST_CASE("WEntityComponentDb_Parallel_Benchmark", "[!benchmark]") {
+    WEntityComponentDb db;
+    for (std::uint32_t i=0; i<1'000'000; i++) {
+        db.CreateComponent<wcm::Transform>(db.CreateEntity<WEntity>("E"));
+    }
+
+    auto rebuild_matrix = [](wcm::Transform * _transform) {
+        _transform->Set_transform_matrix(
+            WMath::ToMat4(
+                _transform->Get_position(),
+                _transform->Get_rotation(),
+                _transform->Get_rotation_order(),
+                _transform->Get_scale()));
+    };
+
+    BENCHMARK("1M Transform matrix rebuild, ForEachComponent") {
+        db.ForEachComponent<wcm::Transform>(rebuild_matrix);
+    };
+
+    std::size_t max_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    // Threads include the calling thread.
+    for (std::size_t threads=1; threads <= max_threads; threads *= 2) {
+        WThreadLib::WJobSystem job_system(threads - 1);
+
+        BENCHMARK(std::format("1M Transform matrix rebuild, ParallelForEachComponent, {} threads", threads)) {
+            db.ParallelForEachComponent<wcm::Transform>(rebuild_matrix, 4096, job_system);
+        };
+    }
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "WCore/WCore.hpp"
+#include "WCoreTypes/WRenderTypes.hpp"
+#include "WInterfaces/IRender.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Render without a window or a graphics device.
+ * Records the number of calls and the size of the loaded resources,
+ * used to run the engine headless (tests, benchmarks).
+ */
+class WRENDER_API WNullRender : public IRender
+{
+public:
+
+    struct CallCounts {
+        std::size_t draw{0};
+        std::size_t create_render_pipeline{0};
+        std::size_t create_pipeline_binding{0};
+        std::size_t delete_render_pipeline{0};
+        std::size_t delete_pipeline_binding{0};
+        std::size_t refresh_pipelines{0};
+        std::size_t load_texture{0};
+        std::size_t unload_texture{0};
+        std::size_t load_static_mesh{0};
+        std::size_t unload_static_mesh{0};
+        std::size_t update_ubo_camera{0};
+        std::size_t update_parameter_dynamic{0};
+        std::size_t update_parameter_static{0};
+        std::size_t update_lights{0};
+        std::size_t rescale{0};
+    };
+
+    struct ResourceSizes {
+        std::size_t texture_bytes{0};
+        std::size_t mesh_vertices{0};
+        std::size_t mesh_indices{0};
+        std::size_t point_lights{0};
+        std::size_t directional_lights{0};
+    };
+
+public:
+
+    WNullRender() noexcept = default;
+
+    explicit WNullRender(const wct::render::RenderSize & in_size) noexcept :
+        render_size_(in_size) {}
+
+    ~WNullRender() override = default;
+
+    WNullRender(const WNullRender &) = default;
+
+    WNullRender(WNullRender &&) noexcept = default;
+
+    WNullRender & operator=(const WNullRender &) = default;
+
+    WNullRender & operator=(WNullRender &&) noexcept = default;
+
+    void Draw() override;
+
+    void WaitIdle() const override {}
+
+    void CreateRenderPipeline(
+        was::RenderPipeline * in_pipeline_asset
+        ) override;
+
+    void CreatePipelineBinding(
+        const wcr::wid::WEntityComponentId & component_id,
+        const wcr::wid::WTypeAssetIndexId & in_mesh_id,
+        const was::RenderPipeline & pipeline_id,
+        const was::RenderPipelineParams & in_parameters
+        ) override;
+
+    void DeleteRenderPipeline(const wcr::wid::WAssetId & in_id) override;
+
+    void DeletePipelineBinding(const wcr::wid::WEntityComponentId & in_id) override;
+
+    void RefreshPipelines() override;
+
+    void ClearPipelines() override;
+
+    void LoadTexture(const wcr::wid::WAssetId & in_id,
+                     const was::Texture & in_texture) override;
+
+    void UnloadTexture(const wcr::wid::WAssetId & in_id) override;
+
+    void LoadStaticMesh(const wcr::wid::WTypeAssetIndexId & in_id,
+                        const wct::geometry::WMesh & in_mesh) override;
+
+    void UnloadStaticMesh(const wcr::wid::WTypeAssetIndexId & in_id) override;
+
+    void UpdateUboCamera(const wct::render::CameraUBO & in_ubo) override;
+
+    void UpdateParameterDynamic(const wcr::wid::WEntityComponentId & in_id,
+                                const wct::render::RPipeParamUbo & ubo_write) override;
+
+    void UpdateParameterStatic(const wcr::wid::WEntityComponentId & in_id,
+                               const wct::render::RPipeParamUbo & ubo_write) override;
+
+    void UnloadAllResources() override;
+
+    void SetWindow(wdw::WWindow * in_window) override {}
+
+    wct::render::RenderSize RenderSize() const override {
+        return render_size_;
+    }
+
+    void Rescale(const std::uint32_t & in_width, const std::uint32_t & in_height) override;
+
+    void UpdatePointLights(
+        std::span<wcr::wid::WEntityComponentId> in_ids,
+        std::span<wct::render::PointLight> in_point_lights_structs
+        ) override;
+
+    void InitializeLights(
+        std::span<wcr::wid::WEntityComponentId> in_pl_ids,
+        std::span<wct::render::PointLight> in_point_lights,
+        std::span<wcr::wid::WEntityComponentId> in_dl_ids,
+        std::span<wct::render::DirectionalLight> in_directional_lights,
+        const wct::render::AmbientLight & in_ambient_light
+        ) override;
+
+    void ClearLights() override;
+
+    void UpdateDirectionalLights(
+        std::span<wcr::wid::WEntityComponentId> in_ids,
+        std::span<wct::render::DirectionalLight> in_directional_light_structs
+        ) override;
+
+    void UpdateAmbientLight(
+        const wct::render::AmbientLight & in_ambient_light
+        ) override;
+
+    // Recorded data
+    // -------------
+
+    WNODISCARD const CallCounts & Calls() const noexcept {
+        return calls_;
+    }
+
+    /**
+     * @brief Size of the resources currently loaded.
+     */
+    WNODISCARD const ResourceSizes & Sizes() const noexcept {
+        return sizes_;
+    }
+
+    WNODISCARD const wct::render::CameraUBO & LastCamera() const noexcept {
+        return camera_;
+    }
+
+    void ResetCalls() noexcept {
+        calls_ = {};
+    }
+
+private:
+
+    wct::render::RenderSize render_size_{1920, 1080};
+
+    wct::render::CameraUBO camera_{};
+
+    CallCounts calls_{};
+
+    ResourceSizes sizes_{};
+
+    // Loaded resources sizes, to update sizes_ on unload.
+    std::unordered_map<wcr::wid::WAssetId, std::size_t> texture_bytes_{};
+    std::unordered_map<wcr::wid::WTypeAssetIndexId, std::pair<std::size_t, std::size_t>> mesh_sizes_{};
+
+};
@@ -0,0 +1,127 @@
+#include "WRender/WNullRender.hpp"
+#include "WAssets/Texture.hpp"
+#include "WCoreTypes/WGeometry.hpp"
+
+void WNullRender::Draw() {
+    calls_.draw++;
+}
+
+void WNullRender::CreateRenderPipeline(was::RenderPipeline * in_pipeline_asset) {
+    calls_.create_render_pipeline++;
+}
+
+void WNullRender::CreatePipelineBinding(const wcr::wid::WEntityComponentId & component_id,
+                                        const wcr::wid::WTypeAssetIndexId & in_mesh_id,
+                                        const was::RenderPipeline & pipeline_id,
+                                        const was::RenderPipelineParams & in_parameters) {
+    calls_.create_pipeline_binding++;
+}
+
+void WNullRender::DeleteRenderPipeline(const wcr::wid::WAssetId & in_id) {
+    calls_.delete_render_pipeline++;
+}
+
+void WNullRender::DeletePipelineBinding(const wcr::wid::WEntityComponentId & in_id) {
+    calls_.delete_pipeline_binding++;
+}
+
+void WNullRender::RefreshPipelines() {
+    calls_.refresh_pipelines++;
+}
+
+void WNullRender::ClearPipelines() {}
+
+void WNullRender::LoadTexture(const wcr::wid::WAssetId & in_id,
+                              const was::Texture & in_texture) {
+    calls_.load_texture++;
+
+    UnloadTexture(in_id);
+    texture_bytes_[in_id] = in_texture.GetDataSize();
+    sizes_.texture_bytes += in_texture.GetDataSize();
+}
+
+void WNullRender::UnloadTexture(const wcr::wid::WAssetId & in_id) {
+    auto it = texture_bytes_.find(in_id);
+    if (it == texture_bytes_.end()) return;
+
+    calls_.unload_texture++;
+    sizes_.texture_bytes -= it->second;
+    texture_bytes_.erase(it);
+}
+
+void WNullRender::LoadStaticMesh(const wcr::wid::WTypeAssetIndexId & in_id,
+                                 const wct::geometry::WMesh & in_mesh) {
+    calls_.load_static_mesh++;
+
+    UnloadStaticMesh(in_id);
+    mesh_sizes_[in_id] = {in_mesh.vertices.size(), in_mesh.indices.size()};
+    sizes_.mesh_vertices += in_mesh.vertices.size();
+    sizes_.mesh_indices += in_mesh.indices.size();
+}
+
+void WNullRender::UnloadStaticMesh(const wcr::wid::WTypeAssetIndexId & in_id) {
+    auto it = mesh_sizes_.find(in_id);
+    if (it == mesh_sizes_.end()) return;
+
+    calls_.unload_static_mesh++;
+    sizes_.mesh_vertices -= it->second.first;
+    sizes_.mesh_indices -= it->second.second;
+    mesh_sizes_.erase(it);
+}
+
+void WNullRender::UpdateUboCamera(const wct::render::CameraUBO & in_ubo) {
+    calls_.update_ubo_camera++;
+    camera_ = in_ubo;
+}
+
+void WNullRender::UpdateParameterDynamic(const wcr::wid::WEntityComponentId & in_id,
+                                         const wct::render::RPipeParamUbo & ubo_write) {
+    calls_.update_parameter_dynamic++;
+}
+
+void WNullRender::UpdateParameterStatic(const wcr::wid::WEntityComponentId & in_id,
+                                        const wct::render::RPipeParamUbo & ubo_write) {
+    calls_.update_parameter_static++;
+}
+
+void WNullRender::UnloadAllResources() {
+    texture_bytes_.clear();
+    mesh_sizes_.clear();
+    sizes_.texture_bytes = 0;
+    sizes_.mesh_vertices = 0;
+    sizes_.mesh_indices = 0;
+}
+
+void WNullRender::Rescale(const std::uint32_t & in_width, const std::uint32_t & in_height) {
+    calls_.rescale++;
+    render_size_ = {in_width, in_height};
+}
+
+void WNullRender::UpdatePointLights(std::span<wcr::wid::WEntityComponentId> in_ids,
+                                    std::span<wct::render::PointLight> in_point_lights_structs) {
+    calls_.update_lights++;
+}
+
+void WNullRender::InitializeLights(std::span<wcr::wid::WEntityComponentId> in_pl_ids,
+                                   std::span<wct::render::PointLight> in_point_lights,
+                                   std::span<wcr::wid::WEntityComponentId> in_dl_ids,
+                                   std::span<wct::render::DirectionalLight> in_directional_lights,
+                                   const wct::render::AmbientLight & in_ambient_light) {
+    calls_.update_lights++;
+    sizes_.point_lights = in_point_lights.size();
+    sizes_.directional_lights = in_directional_lights.size();
+}
+
+void WNullRender::ClearLights() {
+    sizes_.point_lights = 0;
+    sizes_.directional_lights = 0;
+}
+
+void WNullRender::UpdateDirectionalLights(std::span<wcr::wid::WEntityComponentId> in_ids,
+                                          std::span<wct::render::DirectionalLight> in_directional_light_structs) {
+    calls_.update_lights++;
+}
+
+void WNullRender::UpdateAmbientLight(const wct::render::AmbientLight & in_ambient_light) {
+    calls_.update_lights++;
+}
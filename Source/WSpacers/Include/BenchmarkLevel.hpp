@@ -0,0 +1,63 @@
+#pragma once
+
+#include "WEngine/WEngine.hpp"
+
+#include "WAssets/Level.hpp"
+#include "WObjectDb/WAssetDb.hpp"
+
+#include "WComponents/Transform.hpp"
+#include "WComponents/Camera.hpp"
+#include "WComponents/Movement.hpp"
+
+#include <cstddef>
+#include <random>
+
+namespace spacers::benchmark {
+
+    /**
+     * @brief Level with in_entities moving entities and a render camera,
+     * the entities have no mesh so the frame cost is dominated by the systems.
+     */
+    inline wcr::wid::WAssetId CreateLevel(WEngine & in_engine, std::size_t in_entities) {
+        wcr::wid::WAssetId level_id = in_engine.AssetManager().Create<was::Level>(
+            "/Content/benchmarklevel/level01:level01"
+            );
+
+        was::Level * level = &in_engine.AssetManager()
+            .Get<was::Level>(level_id);
+
+        in_engine.AddPreSystem(level_id, "SystemPre_UpdateMovement");
+
+        // Camera
+
+        wcr::wid::WEntityId cid = level->CreateEntity<WEntity>();
+        level->CreateComponent<wcm::Transform>(cid);
+        level->CreateComponent<wcm::Camera>(cid);
+
+        level->GetComponent<wcm::Camera>(cid).Set_render_id(1);
+        level->GetComponent<wcm::Transform>(cid).Set_position({0.f, 0.f, 10.f});
+
+        // Moving entities, fixed seed so runs are comparable.
+
+        std::mt19937 generator{1234};
+        std::uniform_real_distribution<float> position{-100.f, 100.f};
+        std::uniform_real_distribution<float> acceleration{-5.f, 5.f};
+
+        for (std::size_t i=0; i < in_entities; i++) {
+            wcr::wid::WEntityId eid = level->CreateEntity<WEntity>();
+            level->CreateComponent<wcm::Transform>(eid);
+            level->CreateComponent<wcm::Movement>(eid);
+
+            level->GetComponent<wcm::Transform>(eid).Set_position(
+                {position(generator), position(generator), position(generator)}
+                );
+
+            level->GetComponent<wcm::Movement>(eid).Set_acceleration(
+                {acceleration(generator), acceleration(generator), acceleration(generator)}
+                );
+        }
+
+        return level_id;
+    }
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "WEngine/WEngine.hpp"
+
+#include "WAssets/StaticMesh.hpp"
+#include "WAssets/Texture.hpp"
+#include "WImporter/WImporter.hpp"
+#include "WImporter/WImporterCooked.hpp"
+#include "WObjectDb/WAssetDb.hpp"
+#include "WObjects/WCookedAsset.hpp"
+#include "WLog.hpp"
+
+#include <concepts>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace spacers::cooked {
+
+    inline constexpr std::string_view COOKED_DIRECTORY{"Content/Cooked"};
+
+    /**
+     * @brief Cooked file of a source file, the extension is kept in the name
+     * so monkey.obj and monkey.png don't collide.
+     */
+    inline std::filesystem::path CookedPath(std::string_view in_file_path) {
+        std::filesystem::path source{in_file_path};
+
+        std::string name = source.stem().string();
+        if (source.has_extension()) {
+            name += "_" + source.extension().string().substr(1);
+        }
+
+        return std::filesystem::path(COOKED_DIRECTORY) /
+            (name + std::string(was::cooked::EXTENSION));
+    }
+
+    /**
+     * @brief Load the cooked in_file_path when it is newer than the source,
+     * otherwise import the source with TImporter and cook the result for the next run.
+     * Only imports giving a single static mesh or texture are cooked.
+     */
+    template<std::derived_from<wim::importer::WImporter> TImporter>
+    std::vector<wcr::wid::WAssetId> Import(WEngine & in_engine,
+                                           std::string_view in_file_path,
+                                           std::string_view in_asset_directory) {
+        namespace fs = std::filesystem;
+
+        WAssetDb & asset_db = in_engine.AssetManager();
+        fs::path cooked_path = CookedPath(in_file_path);
+
+        std::error_code ec;
+        bool fresh = fs::exists(cooked_path, ec) &&
+            fs::last_write_time(cooked_path, ec) >= fs::last_write_time(in_file_path, ec) &&
+            !ec &&
+            was::cooked::ReadAssetKind(cooked_path.string()) != was::cooked::EAssetKind::None;
+
+        if (fresh) {
+            return in_engine.ImportersRegister()
+                .GetImporter<wim::importer::WImporterCooked>()
+                .Import(asset_db, cooked_path.string(), in_asset_directory);
+        }
+
+        std::vector<wcr::wid::WAssetId> result = in_engine.ImportersRegister()
+            .GetImporter<TImporter>()
+            .Import(asset_db, in_file_path, in_asset_directory);
+
+        if (result.size() != 1) return result;
+
+        WAsset * asset = asset_db.Get(result[0]);
+
+        if (asset->Class()->IsEqual(was::StaticMesh::StaticClass()) ||
+            asset->Class()->IsEqual(was::Texture::StaticClass())) {
+            fs::create_directories(cooked_path.parent_path(), ec);
+            asset->Serialize(cooked_path.string());
+
+            WFLOG("[INFO] Cooked {} to {}.", in_file_path, cooked_path.string());
+        }
+
+        return result;
+    }
+
+}
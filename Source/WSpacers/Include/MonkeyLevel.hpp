@@ -28,6 +28,8 @@
 #include "WCoreTypes/WMathStructs.hpp"
 #include "WCoreTypes/WRenderTypes.hpp"
 
+#include "CookedAssets.hpp"
+
 
 namespace spacers::monkey {
     
@@ -40,27 +42,22 @@ namespace spacers::monkey {
 
     inline bool LoadVikingRoom(WEngine & engine, ModelAssets & out_model)
     {
-        // Import Viking Room
-        wim::importer::WImporterObj obj_importer =
-            engine.ImportersRegister().GetImporter<wim::importer::WImporterObj>();
-
+        // Import Viking Room, cooked after the first run.
         std::vector<wcr::wid::WAssetId> geo_ids =
-            obj_importer.Import(
-                engine.AssetManager(),
+            spacers::cooked::Import<wim::importer::WImporterObj>(
+                engine,
                 "Content/Assets/Models/viking_room.obj", 
                 "/Content/Assets/viking_room:viking_room"
                 );
 
         out_model.static_mesh = geo_ids[0];
 
-        wim::importer::WImportTexture texture_importer =
-            engine.ImportersRegister().GetImporter<wim::importer::WImportTexture>();
-
-        std::vector<wcr::wid::WAssetId> tex_ids = texture_importer.Import(
-            engine.AssetManager(),
-            "Content/Assets/Textures/viking_room.png", 
-            "/Content/Assets/viking_texture:viking_texture"
-            );
+        std::vector<wcr::wid::WAssetId> tex_ids =
+            spacers::cooked::Import<wim::importer::WImportTexture>(
+                engine,
+                "Content/Assets/Textures/viking_room.png", 
+                "/Content/Assets/viking_texture:viking_texture"
+                );
 
         WAsset * null_texture = engine.AssetManager()
             .Get(weng::defaults::NULL_TEXTURE_ASSET_PATH);
@@ -145,25 +142,21 @@ namespace spacers::monkey {
     }
 
     inline bool LoadMonkey(WEngine & engine, ModelAssets & out_model, const wcr::wid::WAssetId & in_render_pipeline) {
-        wim::importer::WImporterObj obj_importer =
-            engine.ImportersRegister()
-            .GetImporter<wim::importer::WImporterObj>();
-
         std::vector<wcr::wid::WAssetId> geo_ids =
-            obj_importer.Import(
-                engine.AssetManager(),
+            spacers::cooked::Import<wim::importer::WImporterObj>(
+                engine,
                 "Content/Assets/Models/monkey.obj", 
                 "/Content/Assets/monkey:monkey"
                 );
 
         out_model.static_mesh = geo_ids[0];
 
-        wim::importer::WImportTexture tex_importer = engine.ImportersRegister()
-            .GetImporter<wim::importer::WImportTexture>();
-
-        std::vector<wcr::wid::WAssetId> tex_ids = tex_importer.Import(engine.AssetManager(),
-                                                            "Content/Assets/Textures/orange.png",
-                                                            "/Content/Assets/orange:orange");
+        std::vector<wcr::wid::WAssetId> tex_ids =
+            spacers::cooked::Import<wim::importer::WImportTexture>(
+                engine,
+                "Content/Assets/Textures/orange.png",
+                "/Content/Assets/orange:orange"
+                );
 
         out_model.pipeline_asset = in_render_pipeline;
 
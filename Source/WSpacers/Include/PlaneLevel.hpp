@@ -17,6 +17,8 @@
 #include "WComponents/Movement.hpp"
 #include "WComponents/Light/Ambient.hpp"
 
+#include "CookedAssets.hpp"
+
 namespace spacers::plane {
     
     struct LevelData {
@@ -63,11 +65,8 @@ namespace spacers::plane {
 
     inline std::vector<wcr::wid::WAssetId> ImportAssets(WEngine & engine) {
         
-        wim::importer::WImportTexture texture_importer =
-            engine.ImportersRegister().GetImporter<wim::importer::WImportTexture>();
-
-        return texture_importer.Import(
-            engine.AssetManager(),
+        return spacers::cooked::Import<wim::importer::WImportTexture>(
+            engine,
             "Content/Assets/Textures/viking_room.png", 
             "/Content/planelevel/"
             );
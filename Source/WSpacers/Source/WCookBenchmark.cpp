@@ -0,0 +1,112 @@
+#include "WImporter/WImporterObj.hpp"
+#include "WImporter/WImporterTexture.hpp"
+#include "WImporter/WImporterCooked.hpp"
+#include "WObjectDb/WAssetDb.hpp"
+#include "WObjects/WCookedAsset.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <print>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(const Clock::time_point & in_start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - in_start).count();
+    }
+
+    struct Source {
+        std::string path;
+        wim::importer::WImporter * importer;
+    };
+
+    /**
+     * @brief Import in_path in_runs times, each run in a new asset db.
+     * @return min and avg milliseconds.
+     */
+    std::pair<double, double> TimeImport(wim::importer::WImporter & in_importer,
+                                         const std::string & in_path,
+                                         std::size_t in_runs) {
+        double min = 0, total = 0;
+
+        for (std::size_t i=0; i < in_runs; i++) {
+            WAssetDb asset_db;
+
+            auto start = Clock::now();
+            in_importer.Import(asset_db, in_path, "/Content/Benchmark/");
+            double ms = ElapsedMs(start);
+
+            min = i == 0 ? ms : std::min(min, ms);
+            total += ms;
+        }
+
+        return {min, total / static_cast<double>(in_runs)};
+    }
+
+}
+
+/**
+ * @brief Compares source imports (tinyobjloader, stb_image) with cooked asset loads.
+ * usage: WCookBenchmark [runs=20]
+ */
+int main(int argc, char** argv)
+{
+    std::size_t runs = argc > 1 ? std::max<std::size_t>(1, std::stoull(argv[1])) : 20;
+
+    wim::importer::WImporterObj obj_importer;
+    wim::importer::WImportTexture texture_importer;
+    wim::importer::WImporterCooked cooked_importer;
+
+    std::vector<Source> sources {
+        {"Content/Assets/Models/monkey.obj", &obj_importer},
+        {"Content/Assets/Models/viking_room.obj", &obj_importer},
+        {"Content/Assets/Textures/orange.png", &texture_importer},
+        {"Content/Assets/Textures/viking_room.png", &texture_importer}
+    };
+
+    std::filesystem::path cooked_dir =
+        std::filesystem::temp_directory_path() / "WCookBenchmark";
+
+    try
+    {
+        std::filesystem::create_directories(cooked_dir);
+
+        std::println("WCookBenchmark: {} runs", runs);
+
+        for (const Source & source : sources) {
+            std::string cooked_path =
+                (cooked_dir / (std::filesystem::path(source.path).filename().string() +
+                               std::string(was::cooked::EXTENSION))).string();
+
+            {
+                WAssetDb asset_db;
+                auto ids = source.importer->Import(asset_db, source.path, "/Content/Benchmark/");
+                asset_db.Get(ids[0])->Serialize(cooked_path);
+            }
+
+            auto [import_min, import_avg] = TimeImport(*source.importer, source.path, runs);
+            auto [cooked_min, cooked_avg] = TimeImport(cooked_importer, cooked_path, runs);
+
+            std::println("{:<40} import min {:>9.3f} ms avg {:>9.3f} ms | cooked min {:>7.3f} ms avg {:>7.3f} ms | {:>6.1f}x",
+                         source.path,
+                         import_min, import_avg,
+                         cooked_min, cooked_avg,
+                         cooked_avg > 0 ? import_avg / cooked_avg : 0.0);
+        }
+
+        std::filesystem::remove_all(cooked_dir);
+    }
+    catch(const std::exception& e)
+    {
+        std::println(stderr, "[ERROR] {}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
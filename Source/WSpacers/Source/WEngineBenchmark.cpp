@@ -0,0 +1,108 @@
+#include "BenchmarkLevel.hpp"
+
+#include "WEngine/WEngineDefaults.hpp"
+#include "WCoreTypes/WEngineStructs.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <print>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct StageStats {
+        double min{0};
+        double avg{0};
+        double max{0};
+    };
+
+    template<typename TFn>
+    StageStats ComputeStats(const std::vector<WFrameTimingsStruct> & in_timings, TFn && in_fn) {
+        StageStats result{};
+
+        if (in_timings.empty()) return result;
+
+        result.min = in_fn(in_timings[0]);
+        result.max = result.min;
+
+        for (const auto & t : in_timings) {
+            double v = in_fn(t);
+            result.min = std::min(result.min, v);
+            result.max = std::max(result.max, v);
+            result.avg += v;
+        }
+
+        result.avg /= static_cast<double>(in_timings.size());
+
+        return result;
+    }
+
+    void PrintStats(const char * in_name, const StageStats & in_stats) {
+        std::println("{:<14} min {:>9.3f} ms  avg {:>9.3f} ms  max {:>9.3f} ms",
+                     in_name, in_stats.min, in_stats.avg, in_stats.max);
+    }
+
+    void PrintReport(const char * in_name, const WSystemsRunner::StageReport & in_report) {
+        std::println("{:<14} systems {:>3}  critical path {:>3}  work {:>9.3f} ms  wall {:>9.3f} ms  speedup {:>5.2f}",
+                     in_name,
+                     in_report.system_count,
+                     in_report.critical_path_length,
+                     in_report.work_ms,
+                     in_report.wall_ms,
+                     in_report.Speedup());
+    }
+
+}
+
+/**
+ * @brief Runs the engine headless over a generated level and prints per stage frame timings.
+ * usage: WEngineBenchmark [entities=100000] [frames=300] [reference|copy]
+ */
+int main(int argc, char** argv)
+{
+    std::size_t entities = argc > 1 ? std::stoull(argv[1]) : 100000;
+    std::size_t frames = argc > 2 ? std::stoull(argv[2]) : 300;
+    bool copy_level = argc > 3 && std::string(argv[3]) == "copy";
+
+    try
+    {
+        WEngine engine = weng::defaults::HeadlessEngine();
+
+        engine.LevelActivation(copy_level ?
+                               WEngine::ELevelActivation::Copy :
+                               WEngine::ELevelActivation::Reference);
+
+        wcr::wid::WAssetId level_id = spacers::benchmark::CreateLevel(engine, entities);
+        engine.StartupLevel(level_id);
+
+        std::vector<WFrameTimingsStruct> timings = engine.RunFrames(frames);
+
+        std::println("WEngineBenchmark: {} entities, {} frames", entities, frames);
+        std::println("level activation ({}) {:.3f} ms",
+                     copy_level ? "copy" : "reference",
+                     engine.LevelInfo().activation_ms);
+
+        PrintStats("pre systems", ComputeStats(timings, [](const WFrameTimingsStruct & _t) { return _t.pre_systems; }));
+        PrintStats("post systems", ComputeStats(timings, [](const WFrameTimingsStruct & _t) { return _t.post_systems; }));
+        PrintStats("draw", ComputeStats(timings, [](const WFrameTimingsStruct & _t) { return _t.draw; }));
+        PrintStats("render thread", ComputeStats(timings, [](const WFrameTimingsStruct & _t) { return _t.render; }));
+        PrintStats("frame", ComputeStats(timings, [](const WFrameTimingsStruct & _t) { return _t.frame; }));
+
+        // Reports of the last frame.
+        PrintReport("engine pre",
+                    engine.SystemsRunner().GetStageReport(0, WSystemsRunner::ESystemLocation::PRE));
+        PrintReport("level pre",
+                    engine.SystemsRunner().GetStageReport(level_id, WSystemsRunner::ESystemLocation::PRE));
+        PrintReport("engine post",
+                    engine.SystemsRunner().GetStageReport(0, WSystemsRunner::ESystemLocation::POST));
+    }
+    catch(const std::exception& e)
+    {
+        std::println(stderr, "[ERROR] {}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
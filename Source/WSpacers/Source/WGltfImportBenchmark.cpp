@@ -0,0 +1,249 @@
+#include "WImporter/WImporterGltf.hpp"
+#include "WObjectDb/WAssetDb.hpp"
+#include "WCore/WThreadLib.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <format>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(const Clock::time_point & in_start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - in_start).count();
+    }
+
+    // Vertices per side of each synthetic mesh.
+    constexpr std::uint32_t GRID{128};
+
+    template<typename T>
+    void Append(std::vector<char> & out_bytes, const T & in_value) {
+        const char * ptr = reinterpret_cast<const char *>(&in_value);
+        out_bytes.insert(out_bytes.end(), ptr, ptr + sizeof(T));
+    }
+
+    /**
+     * @brief Write a gltf with in_textures textures, each one a separate image of in_image_path,
+     * and in_meshes grid meshes in an external buffer.
+     * @return the gltf path.
+     */
+    std::filesystem::path WriteSyntheticGltf(const std::filesystem::path & in_directory,
+                                             const std::filesystem::path & in_image_path,
+                                             std::size_t in_textures,
+                                             std::size_t in_meshes) {
+        std::vector<char> bin;
+
+        std::string buffer_views;
+        std::string accessors;
+        std::string meshes;
+        std::string nodes;
+        std::string scene_nodes;
+
+        const std::uint32_t vertex_count = GRID * GRID;
+        const std::uint32_t index_count = (GRID - 1) * (GRID - 1) * 6;
+
+        auto add_view = [&bin, &buffer_views](std::size_t _offset) {
+            if (!buffer_views.empty()) buffer_views += ",";
+            buffer_views += std::format(R"({{"buffer":0,"byteOffset":{},"byteLength":{}}})",
+                                        _offset, bin.size() - _offset);
+        };
+
+        std::size_t view_index = 0;
+
+        for (std::size_t m=0; m < in_meshes; m++) {
+            std::size_t offset = bin.size();
+            for (std::uint32_t z=0; z < GRID; z++) {
+                for (std::uint32_t x=0; x < GRID; x++) {
+                    Append(bin, static_cast<float>(x) / (GRID - 1));
+                    Append(bin, 0.f);
+                    Append(bin, static_cast<float>(z) / (GRID - 1));
+                }
+            }
+            add_view(offset);
+
+            offset = bin.size();
+            for (std::uint32_t i=0; i < vertex_count; i++) {
+                Append(bin, 0.f);
+                Append(bin, 1.f);
+                Append(bin, 0.f);
+            }
+            add_view(offset);
+
+            offset = bin.size();
+            for (std::uint32_t z=0; z < GRID; z++) {
+                for (std::uint32_t x=0; x < GRID; x++) {
+                    Append(bin, static_cast<float>(x) / (GRID - 1));
+                    Append(bin, static_cast<float>(z) / (GRID - 1));
+                }
+            }
+            add_view(offset);
+
+            offset = bin.size();
+            for (std::uint32_t z=0; z + 1 < GRID; z++) {
+                for (std::uint32_t x=0; x + 1 < GRID; x++) {
+                    std::uint32_t v = z * GRID + x;
+                    for (std::uint32_t idx : {v, v + GRID, v + 1, v + 1, v + GRID, v + GRID + 1}) {
+                        Append(bin, idx);
+                    }
+                }
+            }
+            add_view(offset);
+
+            if (!accessors.empty()) accessors += ",";
+            accessors += std::format(
+                R"({{"bufferView":{},"componentType":5126,"count":{},"type":"VEC3","min":[0,0,0],"max":[1,0,1]}},)"
+                R"({{"bufferView":{},"componentType":5126,"count":{},"type":"VEC3"}},)"
+                R"({{"bufferView":{},"componentType":5126,"count":{},"type":"VEC2"}},)"
+                R"({{"bufferView":{},"componentType":5125,"count":{},"type":"SCALAR"}})",
+                view_index, vertex_count,
+                view_index + 1, vertex_count,
+                view_index + 2, vertex_count,
+                view_index + 3, index_count);
+
+            if (!meshes.empty()) meshes += ",";
+            meshes += std::format(
+                R"({{"name":"Mesh{}","primitives":[{{"attributes":{{"POSITION":{},"NORMAL":{},"TEXCOORD_0":{}}},"indices":{}}}]}})",
+                m, view_index, view_index + 1, view_index + 2, view_index + 3);
+
+            if (!nodes.empty()) nodes += ",";
+            nodes += std::format(R"({{"mesh":{}}})", m);
+
+            if (!scene_nodes.empty()) scene_nodes += ",";
+            scene_nodes += std::format("{}", m);
+
+            view_index += 4;
+        }
+
+        std::string images;
+        std::string textures;
+
+        // Same file, a separate image for each texture, every one is decoded.
+        for (std::size_t t=0; t < in_textures; t++) {
+            if (!images.empty()) images += ",";
+            images += std::format(R"({{"uri":"{}"}})", in_image_path.generic_string());
+
+            if (!textures.empty()) textures += ",";
+            textures += std::format(R"({{"name":"Texture{}","source":{}}})", t, t);
+        }
+
+        std::filesystem::path bin_path = in_directory / "Synthetic.bin";
+        std::filesystem::path gltf_path = in_directory / "Synthetic.gltf";
+
+        std::ofstream bin_file(bin_path, std::ios::binary | std::ios::trunc);
+        bin_file.write(bin.data(), static_cast<std::streamsize>(bin.size()));
+
+        std::ofstream gltf_file(gltf_path, std::ios::trunc);
+        gltf_file << std::format(
+            R"({{"asset":{{"version":"2.0"}},"scene":0,"scenes":[{{"name":"Synthetic","nodes":[{}]}}],)"
+            R"("nodes":[{}],"meshes":[{}],"accessors":[{}],"bufferViews":[{}],)"
+            R"("buffers":[{{"uri":"Synthetic.bin","byteLength":{}}}],"images":[{}],"textures":[{}]}})",
+            scene_nodes, nodes, meshes, accessors, buffer_views, bin.size(), images, textures);
+
+        if (!bin_file || !gltf_file) {
+            throw std::runtime_error(std::format("Can't write {}.", gltf_path.string()));
+        }
+
+        return gltf_path;
+    }
+
+    /**
+     * @brief Import in_path in_runs times with in_job_system, each run in a new asset db.
+     * @return min and avg milliseconds, and the asset ids of the last run.
+     */
+    std::tuple<double, double, std::vector<wcr::wid::WAssetId>> TimeImport(
+        WThreadLib::WJobSystem & in_job_system,
+        const std::string & in_path,
+        std::size_t in_runs) {
+        wim::importer::WImporterGltf importer(
+            wcr::wid::null_id, wcr::wid::null_id, wcr::wid::null_id,
+            wcr::wid::null_id, wcr::wid::null_id, wcr::wid::null_id
+            );
+
+        importer.SetJobSystem(&in_job_system);
+
+        double min = 0, total = 0;
+        std::vector<wcr::wid::WAssetId> ids;
+
+        for (std::size_t i=0; i < in_runs; i++) {
+            WAssetDb asset_db;
+
+            auto start = Clock::now();
+            ids = importer.Import(asset_db, in_path, "/Content/Benchmark/");
+            double ms = ElapsedMs(start);
+
+            min = i == 0 ? ms : std::min(min, ms);
+            total += ms;
+        }
+
+        return {min, total / static_cast<double>(in_runs), std::move(ids)};
+    }
+
+}
+
+/**
+ * @brief Compares serial and parallel glTF imports of a synthetic glTF
+ * with many textures (stb decode) and meshes (primitive extraction).
+ * usage: WGltfImportBenchmark [textures=32] [meshes=32] [runs=5]
+ */
+int main(int argc, char** argv)
+{
+    std::size_t textures = argc > 1 ? std::stoull(argv[1]) : 32;
+    std::size_t meshes = argc > 2 ? std::stoull(argv[2]) : 32;
+    std::size_t runs = argc > 3 ? std::max<std::size_t>(1, std::stoull(argv[3])) : 5;
+
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "WGltfImportBenchmark";
+
+    try
+    {
+        std::filesystem::create_directories(directory);
+
+        std::filesystem::path gltf_path = WriteSyntheticGltf(
+            directory,
+            std::filesystem::absolute("Content/Assets/Textures/viking_room.png"),
+            textures,
+            meshes
+            );
+
+        WThreadLib::WJobSystem serial_jobs(0);
+        WThreadLib::WJobSystem parallel_jobs{};
+
+        std::println("WGltfImportBenchmark: {} textures, {} meshes of {} vertices, {} runs, {} workers",
+                     textures, meshes, GRID * GRID, runs, parallel_jobs.WorkerCount());
+
+        auto [serial_min, serial_avg, serial_ids] =
+            TimeImport(serial_jobs, gltf_path.string(), runs);
+        auto [parallel_min, parallel_avg, parallel_ids] =
+            TimeImport(parallel_jobs, gltf_path.string(), runs);
+
+        std::println("serial   min {:>9.3f} ms avg {:>9.3f} ms", serial_min, serial_avg);
+        std::println("parallel min {:>9.3f} ms avg {:>9.3f} ms | {:>5.2f}x",
+                     parallel_min, parallel_avg,
+                     parallel_avg > 0 ? serial_avg / parallel_avg : 0.0);
+        std::println("same asset ids: {}", serial_ids == parallel_ids);
+
+        std::filesystem::remove_all(directory);
+
+        if (serial_ids != parallel_ids) {
+            return EXIT_FAILURE;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::println(stderr, "[ERROR] {}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
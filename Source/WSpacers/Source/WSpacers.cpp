@@ -3,10 +3,12 @@
 
 #include "PlaneLevel.hpp"
 #include "WEngine/WEngineDefaults.hpp"
+#include "WImporter/WImportCache.hpp"
 #include "WLog.hpp"
 #include "WCoreTypes/WEngineStructs.hpp"
 
 #include <exception>
+#include <memory>
 #include <glm/ext/matrix_transform.hpp>
 
 bool Run(WEngine & engine)
@@ -25,11 +27,17 @@ int main(int argc, char** argv)
 
         WEngine engine = weng::defaults::DefaultEngine();
 
+        auto import_cache = std::make_shared<wim::importer::WImportCache>("Content/Cache/Import");
+        engine.ImportersRegister().SetImportCache(import_cache);
         
         wcr::wid::WAssetId monkey_level_id = spacers::monkey::CreateMonkeyLevel(engine);
         wcr::wid::WAssetId gltflevel = spacers::gltflevel::CreateLevel(engine);
         wcr::wid::WAssetId planelevel = spacers::plane::CreateLevel(engine);
 
+        wim::importer::WImportCache::Stats cache_stats = import_cache->GetStats();
+        WFLOG("[INFO] Import cache: {} hits, {} misses, {} bytes saved.",
+              cache_stats.hits, cache_stats.misses, cache_stats.bytes_saved);
+
         // engine.StartupLevel(monkey_level_id);
         // engine.StartupLevel(planelevel);
         engine.StartupLevel(gltflevel);